@@ -31,15 +31,72 @@
 
 /*! Iterate over all pair and external aligners and compute 
  *  torques
+ *  \param skip_fused if true, skip pair aligners that have already been evaluated in the fused traversal
  */
-void Aligner::compute()
+void Aligner::compute(bool skip_fused)
 {
   //m_system->reset_torques();
   PairAlignType::iterator it_pair;
   ExternAlignType::iterator it_ext;
   
   for(it_pair = m_pair_align.begin(); it_pair != m_pair_align.end(); it_pair++)
-    (*it_pair).second->compute();
+  {
+    int interval = m_pair_interval[(*it_pair).first];
+    if (skip_fused && this->is_fused((*it_pair).first))
+      continue;
+    if (interval == 1)
+      (*it_pair).second->compute();
+    else if (this->begin_slow_update(interval))
+    {
+      (*it_pair).second->compute();
+      this->end_slow_update(interval);
+    }
+  }
   for(it_ext = m_external_align.begin(); it_ext != m_external_align.end(); it_ext++)
-    (*it_ext).second->compute();
+  {
+    int interval = m_external_interval[(*it_ext).first];
+    if (interval == 1)
+      (*it_ext).second->compute();
+    else if (this->begin_slow_update(interval))
+    {
+      (*it_ext).second->compute();
+      this->end_slow_update(interval);
+    }
+  }
+}
+
+/*! An aligner with update interval \f$ n \f$ is evaluated on every \f$ n \f$-th time step and on steps 
+ *  when energies are needed (then without contributing torques). 
+ *  \param interval update interval
+ *  \return true if the aligner needs to be evaluated in this step
+ */
+bool Aligner::begin_slow_update(int interval)
+{
+  if (m_system->get_step() % interval != 0 && !m_system->compute_energy())
+    return false;
+  int N = m_system->size();
+  m_tau_x.resize(N);  m_tau_y.resize(N);  m_tau_z.resize(N);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    m_tau_x[i] = p.tau_x;  m_tau_y[i] = p.tau_y;  m_tau_z[i] = p.tau_z;
+  }
+  return true;
+}
+
+/*! Torque contributed by the aligner since begin_slow_update is multiplied by the update interval, 
+ *  or removed if this is not an update step.
+ *  \param interval update interval
+ */
+void Aligner::end_slow_update(int interval)
+{
+  int N = m_system->size();
+  double scale = (m_system->get_step() % interval == 0) ? static_cast<double>(interval) : 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    p.tau_x = m_tau_x[i] + scale*(p.tau_x - m_tau_x[i]);
+    p.tau_y = m_tau_y[i] + scale*(p.tau_y - m_tau_y[i]);
+    p.tau_z = m_tau_z[i] + scale*(p.tau_z - m_tau_z[i]);
+  }
 }
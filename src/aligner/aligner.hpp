@@ -44,12 +44,16 @@ using std::string;
 
 typedef map<string,PairAlignPtr> PairAlignType;
 typedef map<string,ExternalAlignPtr> ExternAlignType;
+typedef map<string,int> AlignIntervalType;
 
 /*! Aligner class handles all director aligners (pairwise and external field type) present 
  *  in the system. All aligners are stored in two STL maps which both have strings as keys
  *  while items are pointers (boost shared_ptr) to the PairAlign and ExternalAlign abstract classes,
  *  respectively. The integrator part of the code calls member functions of this class
  *  to perform actual alignment computation.
+ *
+ *  As with potentials, each aligner can be assigned an update interval \f$ n \f$ (multiple time stepping). 
+ *  It is then evaluated every \f$ n \f$ steps and its torque is multiplied by \f$ n \f$.
 */
 class Aligner
 {
@@ -70,9 +74,13 @@ public:
   //! Add pairwise alignment to the list of all pair alignments
   //! \param name Unique name of the aligner 
   //! \param align Pointer to the pairwise alignment object
-  void add_pair_align(const string& name, PairAlignPtr align)
+  //! \param interval Update interval (in time steps) for multiple time stepping
+  void add_pair_align(const string& name, PairAlignPtr align, int interval = 1)
   {
     m_pair_align[name] = align;
+    m_pair_interval[name] = interval;
+    if (interval > 1)
+      m_msg->msg(Messenger::INFO,"Pairwise alignment " + name + " will be updated every " + lexical_cast<string>(interval) + " time steps (multiple time stepping).");
     m_need_nlist = m_need_nlist | align->need_nlist();
     m_msg->msg(Messenger::INFO,"Added pairwise alignment : " + name + " to the list of pair alignments.");
     if (align->need_nlist())
@@ -82,9 +90,13 @@ public:
   //! Add external alignment to the list of all external alignments 
   //! \param name Unique name of the aligner
   //! \param align Pointer to the external alignment object
-  void add_external_align(const string& name, ExternalAlignPtr align)
+  //! \param interval Update interval (in time steps) for multiple time stepping
+  void add_external_align(const string& name, ExternalAlignPtr align, int interval = 1)
   {
     m_external_align[name] = align;
+    m_external_interval[name] = interval;
+    if (interval > 1)
+      m_msg->msg(Messenger::INFO,"External aligner " + name + " will be updated every " + lexical_cast<string>(interval) + " time steps (multiple time stepping).");
     m_msg->msg(Messenger::INFO,"Added external aligner : " + name + " to the list of external alignments.");
   }
   
@@ -120,7 +132,16 @@ public:
   bool need_nlist() { return m_need_nlist; } 
   
   //! Compute all alignments
-  void compute();
+  void compute(bool skip_fused = false);
+  
+  //! Collect pair aligners that can be evaluated in a shared (fused) neighbour list traversal
+  //! \param aligns list to which fusable pair aligners are appended
+  void get_fusable_pair_aligners(vector<PairAlignPtr>& aligns)
+  {
+    for(PairAlignType::iterator it_pair = m_pair_align.begin(); it_pair != m_pair_align.end(); it_pair++)
+      if (this->is_fused((*it_pair).first))
+        aligns.push_back((*it_pair).second);
+  }
   
 private:
   
@@ -131,6 +152,20 @@ private:
   ExternAlignType m_external_align;  //!< Contains information about all external alignment
   
   bool m_need_nlist;                  //!< If true, there are potentials that need neighbour list
+  
+  AlignIntervalType m_pair_interval;        //!< Update interval for each pair aligner
+  AlignIntervalType m_external_interval;    //!< Update interval for each external aligner
+  vector<double> m_tau_x, m_tau_y, m_tau_z; //!< Torques before evaluating an aligner with update interval > 1
+  
+  //! Returns true if pair aligner is evaluated in the fused traversal (only those updated every step)
+  //! \param name pair aligner name
+  bool is_fused(const string& name) { return m_pair_interval[name] == 1 && m_pair_align[name]->fusable(); }
+  
+  //! Check if an aligner with a given update interval needs to be evaluated and if so, store current torques
+  bool begin_slow_update(int);
+  
+  //! Apply torque of an aligner with a given update interval as an impulse
+  void end_slow_update(int);
    
 };
 
@@ -62,7 +62,8 @@ public:
   PairAlign(SystemPtr sys, MessengerPtr msg, NeighbourListPtr nlist, pairs_type& param) : m_system(sys), 
                                                                                           m_msg(msg),
                                                                                           m_nlist(nlist),
-                                                                                          m_has_pair_params(false)
+                                                                                          m_has_pair_params(false),
+                                                                                          m_pass_energy(false)
                                                                                           { }
    
   //! Get the total potential energy
@@ -77,7 +78,44 @@ public:
   //! Computes alignment torques for all particles
   virtual void compute() = 0;
   
+  //! Returns true if the aligner can be evaluated as part of a shared (fused) neighbour list traversal
+  virtual bool fusable() { return false; }
+  
+  //! Prepares fused evaluation (resets energies and caches per step flags)
+  virtual void begin_fused() { }
+  
+  //! Adds alignment of a single pair of neighbours during the fused traversal
+  //! \param i index of the first particle
+  //! \param j index of the second particle (neighbour of i)
+  //! \param pi first particle
+  //! \param pj second particle
+  //! \param dx x component of \f$ \vec r_j - \vec r_i \f$ (periodic boundary conditions applied)
+  //! \param dy y component of \f$ \vec r_j - \vec r_i \f$ (periodic boundary conditions applied)
+  //! \param dz z component of \f$ \vec r_j - \vec r_i \f$ (periodic boundary conditions applied)
+  //! \param r_sq squared distance between particles
+  virtual void fused_pair(int i, int j, Particle& pi, Particle& pj, double dx, double dy, double dz, double r_sq) { }
+  
+  //! Finishes fused evaluation
+  virtual void end_fused() { }
+  
 protected:
+  
+  //! Caches per step flags and resets energies at the beginning of an alignment evaluation
+  //! \param name name of the aligner (used for per particle energies)
+  void begin_pass(const string& name)
+  {
+    m_pass_energy = m_system->compute_energy();
+    if (m_system->compute_per_particle_energy())
+    {
+      for  (int i = 0; i < m_system->size(); i++)
+      {
+        Particle& p = m_system->get_particle(i);
+        p.set_align_energy(name,0.0);
+      }
+    }
+    if (m_pass_energy)
+      m_potential_energy = 0.0;
+  }
        
   SystemPtr m_system;              //!< Pointer to the System object
   MessengerPtr m_msg;              //!< Handles messages sent to output
@@ -85,6 +123,7 @@ protected:
   PairAlignData m_pair_params;     //!< Handles specific parameters for a given pair
   bool m_has_pair_params;          //!< Flag that controls if pair parameters are set
   double m_potential_energy;       //!< Total potential energy (\note Need some thinking on how to properly define it)
+  bool m_pass_energy;             //!< If true, current alignment evaluation accumulates energies
     
 };
 
@@ -171,6 +171,15 @@ public:
   //! Computes "torques"
   void compute();
   
+  //! Returns true since this alignment can share neighbour list traversal with other interactions
+  bool fusable() { return true; }
+  
+  //! Prepares fused evaluation
+  void begin_fused() { this->begin_pass("polar"); }
+  
+  //! Adds alignment of a single pair of neighbours during the fused traversal
+  void fused_pair(int, int, Particle&, Particle&, double, double, double, double);
+  
   
 private:
        
@@ -178,6 +187,9 @@ private:
   double m_rcut;                          //!< Cutoff distance (has to be less than neighbour list cutoff)
   PolarAlignParameters** m_pair_params;   //!< type specific pair parameters 
   bool m_exclude_boundary;         
+       
+  //! Torque and energy of a single pair
+  void pair_torque(int, int, Particle&, Particle&, double);
      
 };
 
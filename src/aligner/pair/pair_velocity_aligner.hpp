@@ -181,6 +181,15 @@ public:
   //! Computes "torques"
   void compute();
   
+  //! Returns true since this alignment can share neighbour list traversal with other interactions
+  bool fusable() { return true; }
+  
+  //! Prepares fused evaluation (also computes velocity directions of all particles)
+  void begin_fused();
+  
+  //! Adds alignment of a single pair of neighbours during the fused traversal
+  void fused_pair(int, int, Particle&, Particle&, double, double, double, double);
+  
   
 private:
        
@@ -188,6 +197,11 @@ private:
   double m_rcut;    //!< Cutoff distance (has to be less than neighbour list cutoff)
   bool m_nematic;   //!< If true apply nematic ordering, otherwise, use polar alignment
   VelocityAlignParameters** m_pair_params;   //!< type specific pair parameters 
+       
+  //! Torque and energy of a single pair
+  void pair_torque(int, int, Particle&, Particle&, double);
+  
+  vector<double> m_vhat;   //!< Unit vectors along particle velocities in the current evaluation (3 per particle)
      
 };
 
@@ -32,9 +32,6 @@
 void PairVicsekAlign::compute()
 {
   int N = m_system->size();
-  bool periodic = m_system->get_periodic();
-  BoxPtr box = m_system->get_box();
-  double rcut = m_rcut;
   
   for  (int i = 0; i < N; i++)
   {
@@ -44,30 +41,25 @@ void PairVicsekAlign::compute()
     {
       Particle& pj = m_system->get_particle(neigh[j]);
       double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
-      if (periodic)
-      {
-        if (dx > box->xhi) dx -= box->Lx;
-        else if (dx < box->xlo) dx += box->Lx;
-        if (dy > box->yhi) dy -= box->Ly;
-        else if (dy < box->ylo) dy += box->Ly;
-        if (dz > box->zhi) dz -= box->Lz;
-        else if (dz < box->zlo) dz += box->Lz;
-      }
+      m_system->apply_periodic(dx,dy,dz);
       double r_sq = dx*dx + dy*dy + dz*dz;
-      if (r_sq <= rcut*rcut)
-      {
-        pi.tau_x += pj.vx;
-        pi.tau_y += pj.vy;
-        pi.tau_z += pj.vz;
-        // Since we use 3d Newton's and only have half the the neighbour list we need handle the other part as well
-        pj.tau_x += pi.vx;
-        pj.tau_y += pi.vy;
-        pj.tau_z += pi.vz;
-      }
+      this->pair_torque(i, neigh[j], pi, pj, r_sq);
     }
-    pi.tau_x += pi.vx;
-    pi.tau_y += pi.vy;
-    pi.tau_z += pi.vz;
+  }
+  this->end_fused();
+}
+
+/*! Adds particle's own velocity to the sum over neighbours and normalises the result.
+ */
+void PairVicsekAlign::end_fused()
+{
+  int N = m_system->size();
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    p.tau_x += p.vx;
+    p.tau_y += p.vy;
+    p.tau_z += p.vz;
   }
   // Now we need to normalize all taus
   for  (int i = 0; i < N; i++)
@@ -81,3 +73,39 @@ void PairVicsekAlign::compute()
     p.tau_z *= inv_v;
   }
 }
+
+/*! Pair distance and its periodic image have already been computed by the fused traversal.
+ *  \param i index of the first particle
+ *  \param j index of the second particle
+ *  \param pi first particle
+ *  \param pj second particle
+ *  \param dx x component of the distance vector
+ *  \param dy y component of the distance vector
+ *  \param dz z component of the distance vector
+ *  \param r_sq squared distance
+ */
+void PairVicsekAlign::fused_pair(int i, int j, Particle& pi, Particle& pj, double dx, double dy, double dz, double r_sq)
+{
+  this->pair_torque(i, j, pi, pj, r_sq);
+}
+
+/*! Adds velocities of a pair of neighbouring particles to each other's "torque".
+ *  \param i index of the first particle
+ *  \param j index of the second particle
+ *  \param pi first particle
+ *  \param pj second particle
+ *  \param r_sq squared distance
+ */
+void PairVicsekAlign::pair_torque(int i, int j, Particle& pi, Particle& pj, double r_sq)
+{
+  if (r_sq <= m_rcut*m_rcut)
+  {
+    pi.tau_x += pj.vx;
+    pi.tau_y += pj.vy;
+    pi.tau_z += pj.vz;
+    // Since we use 3d Newton's and only have half the the neighbour list we need handle the other part as well
+    pj.tau_x += pi.vx;
+    pj.tau_y += pi.vy;
+    pj.tau_z += pi.vz;
+  }
+}
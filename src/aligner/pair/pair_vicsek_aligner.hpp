@@ -77,10 +77,22 @@ public:
   //! Computes "torques"
   void compute();
   
+  //! Returns true since this alignment can share neighbour list traversal with other interactions
+  bool fusable() { return true; }
+  
+  //! Finishes fused evaluation (adds particle's own velocity and normalises)
+  void end_fused();
+  
+  //! Adds alignment of a single pair of neighbours during the fused traversal
+  void fused_pair(int, int, Particle&, Particle&, double, double, double, double);
+  
   
 private:
        
   double m_rcut;     //!<  Cutoff distance (has to be less than neighbour list cutoff)
+       
+  //! Velocity contributions of a single pair
+  void pair_torque(int, int, Particle&, Particle&, double);
      
 };
 
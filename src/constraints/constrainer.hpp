@@ -65,6 +65,7 @@ public:
   //! \param constraint Pointer to the constraint
   void add_constraint(const string& name, ConstraintPtr constraint)
   {
+    constraint->build_sdf();
     m_constraints.push_back(constraint);
     m_msg->msg(Messenger::INFO,"Added  : " + name + " to the list of constraints.");
   }
@@ -99,6 +100,42 @@ public:
     return val;
   }
   
+  //! Apply all constraints to a list of particles
+  //! \param particles list of particle indices
+  void enforce_all(const vector<int>& particles)
+  {
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->enforce_all(particles);
+  }
+  
+  //! Rotate directors of a list of particles around normal vector to the surface
+  //! \param particles list of particle indices
+  //! \param phi rotation angles (one per particle in the list)
+  void rotate_directors(const vector<int>& particles, const vector<double>& phi)
+  {
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->rotate_directors(particles,phi);
+  }
+  
+  //! Rotate velocities of a list of particles around normal vector to the surface
+  //! \param particles list of particle indices
+  //! \param phi rotation angles (one per particle in the list)
+  void rotate_velocities(const vector<int>& particles, const vector<double>& phi)
+  {
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->rotate_velocities(particles,phi);
+  }
+  
+  //! Project torques of a list of particles onto normal vector
+  //! \param particles list of particle indices
+  //! \param tau projected torques (one per particle in the list; returned)
+  void project_torques(const vector<int>& particles, vector<double>& tau)
+  {
+    tau.assign(particles.size(),0.0);
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->project_torques(particles,tau);
+  }
+  
   //! Computes normal to the surface
   //! \note That way thing are set up know only the normal to last constraint will be applied
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz)
@@ -108,18 +145,49 @@ public:
       if (find(p.groups.begin(),p.groups.end(),(*it_c)->get_group()) != p.groups.end())
       {
         double nx = 0.0, ny = 0.0, nz = 0.0;
-        (*it_c)->compute_normal(p,nx,ny,nz);
+        (*it_c)->normal(p,nx,ny,nz);
         Nx += nx; Ny += ny;  Nz += nz;
       }
     double len_N = sqrt(Nx*Nx + Ny*Ny + Nz*Nz);
     Nx /= len_N;  Ny /= len_N;  Nz /= len_N;
   }
-  
-  bool rescale() 
+
+  //! Removes normal components of a vector (e.g., force) for all constraints
+  //! the particle is subject to
+  void project_tangent(Particle& p, double& vx, double& vy, double& vz)
+  {
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      if (find(p.groups.begin(),p.groups.end(),(*it_c)->get_group()) != p.groups.end())
+      {
+        double nx = 0.0, ny = 0.0, nz = 0.0;
+        (*it_c)->normal(p,nx,ny,nz);
+        double len_n = sqrt(nx*nx + ny*ny + nz*nz);
+        if (len_n > 0.0)
+        {
+          nx /= len_n;  ny /= len_n;  nz /= len_n;
+          double v_n = vx*nx + vy*ny + vz*nz;
+          vx -= v_n*nx;  vy -= v_n*ny;  vz -= v_n*nz;
+        }
+      }
+  }
+
+  //! Rescale all constraints (if it is time to rescale them)
+  //! \param sx scale factor along x of the combined rescaling (returned)
+  //! \param sy scale factor along y of the combined rescaling (returned)
+  //! \param sz scale factor along z of the combined rescaling (returned)
+  //! \return true if any of the constraints has been rescaled
+  bool rescale(double& sx, double& sy, double& sz)
   {
     bool res = false;
+    sx = 1.0;  sy = 1.0;  sz = 1.0;
     for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
-      res = res || (*it_c)->rescale();
+      if ((*it_c)->rescale())
+      {
+        double cx, cy, cz;
+        (*it_c)->rescale_factors(cx,cy,cz);
+        sx *= cx;  sy *= cy;  sz *= cz;
+        res = true;
+      }
     return res;
   }
   
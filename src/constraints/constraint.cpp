@@ -29,12 +29,18 @@
 
 #include "constraint.hpp"
 
+int Constraint::s_num_tags = 0;
 
 /*! Force particle to be confined to the constraining surface and
  *  its velocity to be tangent to it. We assume that during the integration 
  *  step particles do not move to much away from the surface and we project 
  *  them down to the surface. This is a generic iterative method. Some constraints, 
  *  like sphere override this method to make it faster.
+ *  \note Gradient is evaluated only in iterations that move the particle and the 
+ *  normal at the final position is stored for the rest of the step.
+ *  \note If signed distance grid is used, particle is projected by a grid lookup 
+ *  followed by a single Newton step (see sdf_project). Particles outside the grid 
+ *  are projected iteratively.
  *  \param p Particle which is to be projected onto the constraint
  */
 void Constraint::enforce(Particle& p)
@@ -46,31 +52,12 @@ void Constraint::enforce(Particle& p)
     apply = (find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end());
   if (apply)
   {
-    // Compute reference gradient (SHAKE method)
-    double ref_gx, ref_gy, ref_gz;
-    this->compute_gradient(p,ref_gx, ref_gy, ref_gz);
-    
-    bool satisfied;
-    int iter = 0;
-    while (iter++ < m_max_iter)
+    double Nx, Ny, Nz;
+    if (!(m_sdf && this->sdf_project(p,Nx,Ny,Nz)))
     {
-      satisfied = true;
-      // Compute unit gradient of the implicit function
-      double gx, gy, gz;
-      this->compute_gradient(p,gx,gy,gz);
-      double s = gx*ref_gx + gy*ref_gy + gz*ref_gz;
-      double g = this->constraint_value(p);
-      double lambda = g/s;
-      if (fabs(g) > m_tol)
-        satisfied = false;
-      if (satisfied) break;
-      p.x -= lambda*ref_gx;
-      p.y -= lambda*ref_gy;
-      p.z -= lambda*ref_gz;
+      this->shake(p);
+      this->normal(p,Nx,Ny,Nz);
     }
-      
-    double Nx, Ny, Nz;
-    this->compute_normal(p,Nx,Ny,Nz);
     // compute v.N
     double v_dot_N = p.vx*Nx + p.vy*Ny + p.vz*Nz;
     // compute n.N
@@ -86,6 +73,162 @@ void Constraint::enforce(Particle& p)
   }
 }
 
+/*! Project particle onto the surface using SHAKE method. Particle is moved 
+ *  along the gradient of the implicit function computed at its initial position 
+ *  until the constraint is satisfied to within the tolerance.
+ *  \param p Particle which is to be projected onto the constraint
+ *  \return true if the constraint is satisfied
+ */
+bool Constraint::shake(Particle& p)
+{
+  // Compute reference gradient (SHAKE method)
+  double ref_gx, ref_gy, ref_gz;
+  this->compute_gradient(p,ref_gx, ref_gy, ref_gz);
+  
+  int iter = 0;
+  while (iter++ < m_max_iter)
+  {
+    double g = this->constraint_value(p);
+    if (fabs(g) <= m_tol) return true;
+    // Compute unit gradient of the implicit function (in the first iteration it is the reference gradient)
+    double gx = ref_gx, gy = ref_gy, gz = ref_gz;
+    if (iter > 1)
+      this->compute_gradient(p,gx,gy,gz);
+    double s = gx*ref_gx + gy*ref_gy + gz*ref_gz;
+    if (s == 0.0) return false;  // critical point of the implicit function
+    double lambda = g/s;
+    p.x -= lambda*ref_gx;
+    p.y -= lambda*ref_gy;
+    p.z -= lambda*ref_gz;
+  }
+  return false;
+}
+
+/*! Project particle onto the surface using signed distance grid. Particle is moved 
+ *  by the interpolated signed distance along the interpolated gradient and then 
+ *  polished by a single Newton step with the exact implicit function. Gradient 
+ *  used in the Newton step is also used as the surface normal.
+ *  \note Constraint tolerance is not checked. Accuracy is controlled by the grid spacing 
+ *  and is reported when the grid is built.
+ *  \param p Particle which is to be projected onto the constraint
+ *  \param Nx x component of the normal (returned)
+ *  \param Ny y component of the normal (returned)
+ *  \param Nz z component of the normal (returned)
+ *  \return false if the particle is outside the grid or the gradient vanishes
+ */
+bool Constraint::sdf_project(Particle& p, double& Nx, double& Ny, double& Nz)
+{
+  if (!m_sdf->project(p.x,p.y,p.z))
+    return false;
+  double gx, gy, gz;
+  this->compute_gradient(p,gx,gy,gz);
+  double len_sq = gx*gx + gy*gy + gz*gz;
+  if (len_sq == 0.0)
+    return false;
+  double lambda = this->constraint_value(p)/len_sq;
+  p.x -= lambda*gx;
+  p.y -= lambda*gy;
+  p.z -= lambda*gz;
+  double len = sqrt(len_sq);
+  Nx = gx/len;  Ny = gy/len;  Nz = gz/len;
+  this->store_normal(p,Nx,Ny,Nz);
+  return true;
+}
+
+/*! Sample the surface into the signed distance grid. The grid covers the simulation box 
+ *  (with a margin of two grid spacings on each side). At each grid node we store the unit 
+ *  gradient of the implicit function and signed distance to the surface measured along it. 
+ *  For nodes close to the surface the distance is obtained by projecting the node onto the 
+ *  surface, further away we use the first order estimate \f$ f/\left|\nabla f\right| \f$.
+ *  Once the grid is built, we report how far from the surface particles placed at the 
+ *  centres of grid cells near the surface end up after the grid lookup alone and after 
+ *  the lookup followed by a single Newton step.
+ *  \note Grid is only used by constraints that rely on the generic iterative projection
+ *  and cannot be used with constraints that change shape during the simulation.
+ */
+void Constraint::build_sdf()
+{
+  if (!m_use_sdf)
+    return;
+  if (m_rescale != 1.0)
+  {
+    m_msg->msg(Messenger::WARNING,"Constraint. Signed distance grid cannot be used with rescaled constraints. Ignoring it.");
+    return;
+  }
+  BoxPtr box = m_system->get_box();
+  double h = m_sdf_spacing;
+  int nx = static_cast<int>(ceil(box->Lx/h)) + 5;
+  int ny = static_cast<int>(ceil(box->Ly/h)) + 5;
+  int nz = static_cast<int>(ceil(box->Lz/h)) + 5;
+  double memory = 4.0*sizeof(float)*nx*ny*nz/(1024.0*1024.0);
+  m_msg->msg(Messenger::INFO,"Constraint. Building signed distance grid with "+lexical_cast<string>(nx)+" x "+lexical_cast<string>(ny)+" x "+lexical_cast<string>(nz)+" nodes ("+lexical_cast<string>(memory)+" MB).");
+  m_sdf = boost::make_shared<SDFGrid>(box->xlo - 2.0*h, box->ylo - 2.0*h, box->zlo - 2.0*h, nx, ny, nz, h);  // construct in place (grid can be large)
+  int N = m_sdf->size();
+#pragma omp parallel
+  {
+    Particle p(0,1,1.0);
+#pragma omp for
+    for (int n = 0; n < N; n++)
+    {
+      double x, y, z;
+      m_sdf->node_position(n,x,y,z);
+      p.x = x;  p.y = y;  p.z = z;
+      double gx = 0.0, gy = 0.0, gz = 0.0;
+      this->compute_gradient(p,gx,gy,gz);
+      double len = sqrt(gx*gx + gy*gy + gz*gz);
+      if (len == 0.0)
+        continue;   // leave zero distance and gradient (grid lookup will not move particles)
+      gx /= len;  gy /= len;  gz /= len;
+      double d = this->constraint_value(p)/len;
+      if (fabs(d) < SDF_GRID_BAND*h && this->shake(p))
+        d = (x - p.x)*gx + (y - p.y)*gy + (z - p.z)*gz;
+      m_sdf->set(n,d,gx,gy,gz);
+    }
+  }
+  // Report the projection error for points near the surface
+  Particle p(0,1,1.0);
+  double max_err = 0.0, sum_err = 0.0, max_err_newton = 0.0;
+  int count = 0;
+  for (int k = 0; k < nz - 1; k++)
+    for (int j = 0; j < ny - 1; j++)
+      for (int i = 0; i < nx - 1; i++)
+      {
+        double x, y, z;
+        m_sdf->node_position((k*ny + j)*nx + i,x,y,z);
+        x += 0.5*h;  y += 0.5*h;  z += 0.5*h;
+        double d, gx, gy, gz;
+        if (!m_sdf->interpolate(x,y,z,d,gx,gy,gz) || fabs(d) >= h || !m_sdf->project(x,y,z))
+          continue;
+        p.x = x;  p.y = y;  p.z = z;
+        this->compute_gradient(p,gx,gy,gz);
+        double len_sq = gx*gx + gy*gy + gz*gz;
+        if (len_sq == 0.0)
+          continue;
+        double g = this->constraint_value(p);
+        double err = fabs(g)/sqrt(len_sq);
+        max_err = (err > max_err) ? err : max_err;
+        sum_err += err*err;
+        count++;
+        // Single Newton step (as in sdf_project)
+        p.x -= g*gx/len_sq;  p.y -= g*gy/len_sq;  p.z -= g*gz/len_sq;
+        this->compute_gradient(p,gx,gy,gz);
+        len_sq = gx*gx + gy*gy + gz*gz;
+        if (len_sq == 0.0)
+          continue;
+        err = fabs(this->constraint_value(p))/sqrt(len_sq);
+        max_err_newton = (err > max_err_newton) ? err : max_err_newton;
+      }
+  if (count > 0)
+  {
+    m_msg->msg(Messenger::INFO,"Constraint. Signed distance grid projection error (estimated distance from the surface) for "+lexical_cast<string>(count)+" test points. Grid lookup : max "+lexical_cast<string>(max_err)+", rms "+lexical_cast<string>(sqrt(sum_err/count))+". After Newton step : max "+lexical_cast<string>(max_err_newton)+".");
+    if (max_err > 0.1*h)
+      m_msg->msg(Messenger::WARNING,"Constraint. Signed distance grid is coarse compared to the surface features. Consider reducing sdf_spacing.");
+  }
+  else
+    m_msg->msg(Messenger::WARNING,"Constraint. Surface does not seem to pass through the signed distance grid.");
+  m_msg->write_config("constraint.sdf.nodes",lexical_cast<string>(N));
+}
+
 /*! Rotate director of a particle around the normal vector
  *  \note This function assumes that the particle has already been
  *  projected onto the surface and that its director is laying in 
@@ -103,13 +246,10 @@ void Constraint::rotate_director(Particle& p, double phi)
   if (apply)
   {
     double U, V, W;
-    this->compute_normal(p,U,V,W);
-    // Compute angle sins and cosines
-    double c = cos(phi), s = sin(phi);
-    // Compute new velocity coordinates
-    double nx = U*(U*p.nx+V*p.ny+W*p.nz)*(1.0-c) + p.nx*c + (-W*p.ny+V*p.nz)*s;
-    double ny = V*(U*p.nx+V*p.ny+W*p.nz)*(1.0-c) + p.ny*c + ( W*p.nx-U*p.nz)*s;
-    double nz = W*(U*p.nx+V*p.ny+W*p.nz)*(1.0-c) + p.nz*c + (-V*p.nx+U*p.ny)*s;
+    this->normal(p,U,V,W);
+    // Compute new director coordinates
+    double nx = p.nx, ny = p.ny, nz = p.nz;
+    rotate_vector(U,V,W,phi,nx,ny,nz);
     double len = sqrt(nx*nx + ny*ny + nz*nz);
     // Update particle director (normalize it along the way to collect for any numerical drift that may have occurred)
     p.nx = nx/len;
@@ -135,13 +275,10 @@ void Constraint::rotate_velocity(Particle& p, double phi)
   if (apply)
   {
     double U, V, W;
-    this->compute_normal(p,U,V,W);
-    // Compute angle sins and cosines
-    double c = cos(phi), s = sin(phi);
+    this->normal(p,U,V,W);
     // Compute new velocity coordinates
-    double vx = U*(U*p.vx+V*p.vy+W*p.vz)*(1.0-c) + p.vx*c + (-W*p.vy+V*p.vz)*s;
-    double vy = V*(U*p.vx+V*p.vy+W*p.vz)*(1.0-c) + p.vy*c + ( W*p.vx-U*p.vz)*s;
-    double vz = W*(U*p.vx+V*p.vy+W*p.vz)*(1.0-c) + p.vz*c + (-V*p.vx+U*p.vy)*s;
+    double vx = p.vx, vy = p.vy, vz = p.vz;
+    rotate_vector(U,V,W,phi,vx,vy,vz);
     // Update particle velocity
     p.vx = vx;
     p.vy = vy;
@@ -165,9 +302,59 @@ double Constraint::project_torque(Particle& p)
   if (apply)
   {
     double Nx, Ny, Nz;
-    this->compute_normal(p,Nx,Ny,Nz);
+    this->normal(p,Nx,Ny,Nz);
     return (p.tau_x*Nx + p.tau_y*Ny + p.tau_z*Nz);  
   }
   else 
     return 0.0;
 }
+
+/*! Enforce constraint on all particles in the list. This generic version 
+ *  simply applies enforce to each particle. Constraints that dominate 
+ *  typical simulations (e.g., sphere and plane) override it with a specialised loop.
+ *  \param particles list of particle indices
+*/
+void Constraint::enforce_all(const vector<int>& particles)
+{
+  int N = particles.size();
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+    this->enforce(m_system->get_particle(particles[i]));
+}
+
+/*! Rotate directors of all particles in the list around the normal vector
+ *  \param particles list of particle indices
+ *  \param phi angles by which to rotate directors (one per particle in the list)
+*/
+void Constraint::rotate_directors(const vector<int>& particles, const vector<double>& phi)
+{
+  int N = particles.size();
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+    this->rotate_director(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Rotate velocities of all particles in the list around the normal vector
+ *  \param particles list of particle indices
+ *  \param phi angles by which to rotate velocities (one per particle in the list)
+*/
+void Constraint::rotate_velocities(const vector<int>& particles, const vector<double>& phi)
+{
+  int N = particles.size();
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+    this->rotate_velocity(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Project torques of all particles in the list onto the normal vector. 
+ *  Projections are added to the existing values, so several constraints can contribute.
+ *  \param particles list of particle indices
+ *  \param tau projected torques (one per particle in the list)
+*/
+void Constraint::project_torques(const vector<int>& particles, vector<double>& tau)
+{
+  int N = particles.size();
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+    tau[i] += this->project_torque(m_system->get_particle(particles[i]));
+}
@@ -36,6 +36,10 @@
 
 #include "parse_parameters.hpp"
 
+#include "sdf_grid.hpp"
+
+//! Do not spawn threads when applying constraint to fewer particles than this
+const int CONSTRAINT_PARALLEL_MIN = 1024;
 
 /*! Base class for a generic constraint
  *  \note This is not a constraint (such as fixed volume, or bond lengths)
@@ -58,8 +62,11 @@ public:
                                                                    m_rescale(1.0),
                                                                    m_rescale_steps(1000),
                                                                    m_rescale_freq(10),
-                                                                   m_group("all") 
+                                                                   m_group("all"),
+                                                                   m_use_sdf(false),
+                                                                   m_sdf_spacing(0.5)
   { 
+    this->invalidate_normals();
     if (param.find("maxiter") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Constraint. Maximum number of iterations has not been set. Assuming 100");
@@ -117,6 +124,25 @@ public:
       m_group = param["group"];
     }
     m_msg->write_config("constraint.group",m_group);
+    if (param.find("sdf") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Constraint. Particles will be projected using precomputed signed distance grid.");
+      m_use_sdf = true;
+      if (param.find("sdf_spacing") == param.end())
+        m_msg->msg(Messenger::WARNING,"Constraint. Signed distance grid spacing has not been set. Assuming 0.5.");
+      else
+      {
+        m_msg->msg(Messenger::INFO,"Constraint. Signed distance grid spacing set to "+param["sdf_spacing"]+".");
+        m_sdf_spacing = lexical_cast<double>(param["sdf_spacing"]);
+      }
+      if (m_sdf_spacing <= 0.0)
+      {
+        m_msg->msg(Messenger::ERROR,"Constraint. Signed distance grid spacing has to be positive.");
+        throw runtime_error("Non-positive signed distance grid spacing.");
+      }
+      m_msg->write_config("constraint.sdf","true");
+      m_msg->write_config("constraint.sdf_spacing",lexical_cast<string>(m_sdf_spacing));
+    }
   }
   
   //! Enforce constraint
@@ -131,6 +157,18 @@ public:
   //! Project torque onto normal vector and return rotation angle change
   virtual double project_torque(Particle&);
   
+  //! Enforce constraint on a list of particles
+  virtual void enforce_all(const vector<int>&);
+  
+  //! Rotate directors of a list of particles around normal vector to the surface
+  virtual void rotate_directors(const vector<int>&, const vector<double>&);
+  
+  //! Rotate velocities of a list of particles around normal vector to the surface
+  virtual void rotate_velocities(const vector<int>&, const vector<double>&);
+  
+  //! Project torques of a list of particles onto normal vector and add them to the rotation angle changes
+  virtual void project_torques(const vector<int>&, vector<double>&);
+  
   //! Computes normal to the surface
   virtual void compute_normal(Particle&, double&, double&, double&) = 0;
   
@@ -143,9 +181,42 @@ public:
   // Rescale constraint
   virtual bool rescale() { return false;}
   
+  /*! Scale factors along x, y and z that (approximately) map particle positions before 
+   *  the last rescaling onto positions after it. By default the surface is scaled 
+   *  uniformly about the origin.
+   *  \param sx scale factor along x (returned)
+   *  \param sy scale factor along y (returned)
+   *  \param sz scale factor along z (returned)
+   */
+  virtual void rescale_factors(double& sx, double& sy, double& sz) { sx = m_scale;  sy = m_scale;  sz = m_scale; }
+  
   //! Return the constraint group
   string get_group() { return m_group; }
   
+  //! Sample the surface into signed distance grid (if requested)
+  void build_sdf();
+  
+  /*! Computes normal to the surface. The normal is stored with the particle and 
+   *  it is recomputed only if the particle has moved since (or if the surface has changed).
+   *  \param p particle
+   *  \param Nx x component of the normal (returned)
+   *  \param Ny y component of the normal (returned)
+   *  \param Nz z component of the normal (returned)
+   */
+  void normal(Particle& p, double& Nx, double& Ny, double& Nz)
+  {
+    if (p.N_tag == m_tag && p.N_x == p.x && p.N_y == p.y && p.N_z == p.z)
+    {
+      Nx = p.Nx;  Ny = p.Ny;  Nz = p.Nz;
+      return;
+    }
+    this->compute_normal(p,Nx,Ny,Nz);
+    this->store_normal(p,Nx,Ny,Nz);
+  }
+  
+  //! Discard all stored normals (has to be called when the shape of the surface changes)
+  void invalidate_normals() { m_tag = s_num_tags++; }
+  
 protected:
   
   SystemPtr  m_system;              //!< Pointer to the system object
@@ -157,6 +228,48 @@ protected:
   int m_rescale_freq;               //!< Skip this many steps between rescaling constrain
   double m_scale;                   //!< Rescale the constraint (e.g., sphere radius) by this much in each step (=m_rescale**(m_rescale_freq/m_rescale_steps))
   string m_group;                   //!< Apply constraint only to particles in this group
+  int m_tag;                        //!< Identifies normals computed by this constraint in its current shape
+  bool m_use_sdf;                   //!< If true, use signed distance grid to project particles onto the surface
+  double m_sdf_spacing;             //!< Spacing of the signed distance grid
+  SDFGridPtr m_sdf;                 //!< Signed distance grid (if used)
+  
+  static int s_num_tags;            //!< Number of tags handed out so far
+  
+  //! Project particle onto the surface using iterative SHAKE method
+  bool shake(Particle&);
+  
+  //! Project particle onto the surface using signed distance grid
+  bool sdf_project(Particle&, double&, double&, double&);
+  
+  //! Stores normal computed at the current particle position
+  //! \param p particle
+  //! \param Nx x component of the normal
+  //! \param Ny y component of the normal
+  //! \param Nz z component of the normal
+  void store_normal(Particle& p, double Nx, double Ny, double Nz)
+  {
+    p.Nx = Nx;  p.Ny = Ny;  p.Nz = Nz;
+    p.N_x = p.x;  p.N_y = p.y;  p.N_z = p.z;
+    p.N_tag = m_tag;
+  }
+  
+  //! Rotates vector around a unit vector using Rodrigues' formula
+  //! \param U x component of the rotation axis
+  //! \param V y component of the rotation axis
+  //! \param W z component of the rotation axis
+  //! \param phi rotation angle
+  //! \param x x component of the vector (rotated on return)
+  //! \param y y component of the vector (rotated on return)
+  //! \param z z component of the vector (rotated on return)
+  static void rotate_vector(double U, double V, double W, double phi, double& x, double& y, double& z)
+  {
+    double c = cos(phi), s = sin(phi);
+    double r_dot_N = U*x + V*y + W*z;
+    double rx = U*r_dot_N*(1.0-c) + x*c + (-W*y + V*z)*s;
+    double ry = V*r_dot_N*(1.0-c) + y*c + ( W*x - U*z)*s;
+    double rz = W*r_dot_N*(1.0-c) + z*c + (-V*x + U*y)*s;
+    x = rx;  y = ry;  z = rz;
+  }
   
 };
 
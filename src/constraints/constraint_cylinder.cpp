@@ -84,6 +84,7 @@ bool ConstraintCylinder::rescale()
     if (step % m_rescale_freq == 0 && step <= m_rescale_steps)
     {
       m_r *= m_scale;
+      this->invalidate_normals();
       for  (int i = 0; i < m_system->size(); i++)
       {
         Particle& p = m_system->get_particle(i);
@@ -87,6 +87,12 @@ public:
   
   // Rescale constraint
   bool rescale();
+  
+  //! Rescaling changes only the radius (cylinder axis is along z)
+  //! \param sx scale factor along x (returned)
+  //! \param sy scale factor along y (returned)
+  //! \param sz scale factor along z (returned)
+  void rescale_factors(double& sx, double& sy, double& sz) { sx = m_scale;  sy = m_scale;  sz = 1.0; }
       
 private:
   
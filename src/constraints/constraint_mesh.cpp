@@ -0,0 +1,100 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file constraint_mesh.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of the triangulated surface constraint.
+ */ 
+
+#include "constraint_mesh.hpp"
+
+/*! Project particle onto the closest point of the surface and 
+ *  make its velocity and director tangent to it. Unlike the generic 
+ *  method, projection is exact and does not require iterations.
+ *  \param p Particle which is to be projected onto the constraint
+ */
+void ConstraintMesh::enforce(Particle& p)
+{
+  bool apply = false;
+  if (m_group == "all")
+    apply = true;
+  else
+    apply = (find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end());
+  if (apply)
+  {
+    double x, y, z, Nx, Ny, Nz;
+    m_mesh->closest_point(p.x,p.y,p.z,x,y,z,Nx,Ny,Nz);
+    p.x = x;  p.y = y;  p.z = z;
+    this->store_normal(p,Nx,Ny,Nz);
+    // compute v.N
+    double v_dot_N = p.vx*Nx + p.vy*Ny + p.vz*Nz;
+    // compute n.N
+    double n_dot_N = p.nx*Nx + p.ny*Ny + p.nz*Nz;
+    // Project velocity onto tangent plane
+    p.vx -= v_dot_N*Nx; p.vy -= v_dot_N*Ny; p.vz -= v_dot_N*Nz;
+    // Project director onto tangent plane
+    p.nx -= n_dot_N*Nx; p.ny -= n_dot_N*Ny; p.nz -= n_dot_N*Nz;
+    // normalize director
+    double inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny + p.nz*p.nz);
+    p.nx *= inv_len;  p.ny *= inv_len;  p.nz *= inv_len;
+    m_system->enforce_periodic(p);
+  }
+}
+
+/*! Compute normal to the surface at the point closest to the particle.
+ *  Normal is interpolated between vertex normals of the closest triangle.
+ *  \param p Reference to the particle object
+ *  \param Nx x coordinate of the normal
+ *  \param Ny y coordinate of the normal
+ *  \param Nz z coordinate of the normal
+*/
+void ConstraintMesh::compute_normal(Particle& p, double& Nx, double& Ny, double& Nz)
+{
+  double x, y, z;
+  m_mesh->closest_point(p.x,p.y,p.z,x,y,z,Nx,Ny,Nz);
+  p.Nx = Nx; p.Ny = Ny; p.Nz = Nz;
+}
+
+/*! Compute gradient at a point. Constraint value is the signed distance 
+ *  to the surface, so its gradient is the unit normal.
+ *  \param p reference to a point
+*/
+void ConstraintMesh::compute_gradient(Particle& p, double& gx, double& gy, double& gz)
+{
+  double x, y, z;
+  m_mesh->closest_point(p.x,p.y,p.z,x,y,z,gx,gy,gz);
+}
+
+/*! Compute constraint value at particle p. This is the distance to the surface, 
+ *  which is positive on the side the normals point to.
+ *  \param p reference to the particle
+*/
+double ConstraintMesh::constraint_value(Particle& p)
+{
+  double x, y, z, Nx, Ny, Nz;
+  double d = m_mesh->closest_point(p.x,p.y,p.z,x,y,z,Nx,Ny,Nz);
+  if ((p.x - x)*Nx + (p.y - y)*Ny + (p.z - z)*Nz < 0.0)
+    return -d;
+  return d;
+}
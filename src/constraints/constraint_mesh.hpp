@@ -0,0 +1,106 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file constraint_mesh.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of ConstraintMesh class.
+ */ 
+
+#ifndef __CONSTRAINT_MESH_HPP__
+#define __CONSTRAINT_MESH_HPP__
+
+#include <cmath>
+
+#include "system.hpp"
+#include "parse_parameters.hpp"
+#include "constraint.hpp"
+#include "triangle_mesh.hpp"
+
+using std::sqrt;
+
+/*! Enforces all particles to be on a triangulated surface read from a file 
+ *  (e.g., surface of an imaged tissue). Supported formats are Wavefront OBJ, 
+ *  Stanford PLY and STL. Particles are moved to the closest point on the surface 
+ *  found using bounding volume hierarchy of triangles. Normal to the surface is
+ *  interpolated between vertex normals, so it varies smoothly across triangles.
+ *  All velocities will point in the tangent direction.
+ *  \note Surface is given in the box coordinates and is not periodic. 
+*/
+class ConstraintMesh : public Constraint
+{
+public:
+  
+  //! Constructor
+  //! \param id unique constraint id
+  //! \param sys pointer to the system object
+  //! \param msg Pointer to the internal state messenger
+  //! \param param parameters that define the manifolds (e.g., mesh file)
+  ConstraintMesh(SystemPtr sys, MessengerPtr msg, pairs_type& param) : Constraint(sys,msg,param)
+  { 
+    if (param.find("file") == param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"Mesh constraint. No mesh file given.");
+      throw runtime_error("Mesh constraint requires mesh file.");
+    }
+    m_msg->msg(Messenger::INFO,"Mesh constraint. Reading surface from file "+param["file"]+".");
+    m_msg->write_config("constraint.mesh.file",param["file"]);
+    double scale = 1.0;
+    if (param.find("scale") == param.end())
+      m_msg->msg(Messenger::WARNING,"Mesh constraint. No scale set. Assuming 1.");
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Mesh constraint. Scale set to "+param["scale"]+".");
+      scale = lexical_cast<double>(param["scale"]);
+    }
+    m_msg->write_config("constraint.mesh.scale",lexical_cast<string>(scale));
+    m_mesh = boost::make_shared<TriangleMesh>(m_msg, param["file"], scale);
+    m_msg->write_config("constraint.mesh.triangles",lexical_cast<string>(m_mesh->num_triangles()));
+    if (m_use_sdf)
+    {
+      m_msg->msg(Messenger::WARNING,"Mesh constraint. Particles are projected directly onto the mesh. Ignoring signed distance grid.");
+      m_use_sdf = false;
+    }
+  }
+  
+  //! Enforce constraint
+  void enforce(Particle&);
+  
+  //! Computes normal to the surface
+  void compute_normal(Particle&, double&, double&, double&);
+  
+  // Computer gradient at a point
+  void compute_gradient(Particle&, double&, double&, double&);
+  
+  // Value of the constraint
+  double constraint_value(Particle&);
+  
+private:
+  
+  TriangleMeshPtr m_mesh;     //!< Triangulated surface
+  
+};
+
+typedef shared_ptr<ConstraintMesh> ConstraintMeshPtr;  //!< Shared pointer to the Constraint object
+
+#endif
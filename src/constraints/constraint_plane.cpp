@@ -42,49 +42,81 @@ void ConstraintPlane::enforce(Particle& p)
     apply = (find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end());
   if (apply)
   {
-    bool periodic = m_system->get_periodic();
     double Lx = m_system->get_box()->Lx;
     double Ly = m_system->get_box()->Ly;
-    double xlo = -0.5*Lx, xhi = 0.5*Lx;
-    double ylo = -0.5*Ly, yhi = 0.5*Ly;
-    p.z = m_zpos;
-    p.vz = 0.0;
-    p.fz = 0.0;
-    // Set the particle normal
-    p.Nx = 0.0; p.Ny = 0.0; p.Nz = 1.0;
-    // Check periodic boundary conditions 
-    if (periodic)
-      m_system->enforce_periodic(p);
-    else if (!m_unlimited) // reflective boundary conditions
+    this->project(p,m_system->get_periodic(),-0.5*Lx,0.5*Lx,-0.5*Ly,0.5*Ly);
+  }
+}
+
+/*! Project particle onto the plane and apply boundary conditions in the plane
+ *  \param p particle to project onto the plane
+ *  \param periodic if true, apply periodic boundary conditions
+ *  \param xlo lower box boundary along x 
+ *  \param xhi upper box boundary along x
+ *  \param ylo lower box boundary along y
+ *  \param yhi upper box boundary along y
+ */
+void ConstraintPlane::project(Particle& p, bool periodic, double xlo, double xhi, double ylo, double yhi)
+{
+  p.z = m_zpos;
+  p.vz = 0.0;
+  p.fz = 0.0;
+  // Set the particle normal
+  p.Nx = 0.0; p.Ny = 0.0; p.Nz = 1.0;
+  // Check periodic boundary conditions 
+  if (periodic)
+    m_system->enforce_periodic(p);
+  else if (!m_unlimited) // reflective boundary conditions
+  {
+    if (p.x < xlo) 
     {
-      if (p.x < xlo) 
-      {
-        p.x = xlo;
-        p.vx = -p.vx;
-      }
-      else if (p.x > xhi)
-      {
-        p.x = xhi;
-        p.vx = -p.vx;
-      }
-      if (p.y < ylo) 
-      {
-        p.y = ylo;
-        p.vy = -p.vy;
-      }
-      else if (p.y > yhi)
-      {
-        p.y = yhi;
-        p.vy = -p.vy;
-      }
+      p.x = xlo;
+      p.vx = -p.vx;
+    }
+    else if (p.x > xhi)
+    {
+      p.x = xhi;
+      p.vx = -p.vx;
+    }
+    if (p.y < ylo) 
+    {
+      p.y = ylo;
+      p.vy = -p.vy;
     }
-    // normalize director
-    p.nz = 0.0;
-    double len_n = sqrt(p.nx*p.nx + p.ny*p.ny);
-    double inv_len = 1.0;
-    if (len_n != 0.0) 
-      inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny);
-    p.nx *= inv_len;  p.ny *= inv_len;  
+    else if (p.y > yhi)
+    {
+      p.y = yhi;
+      p.vy = -p.vy;
+    }
+  }
+  // normalize director
+  p.nz = 0.0;
+  double len_n = sqrt(p.nx*p.nx + p.ny*p.ny);
+  double inv_len = 1.0;
+  if (len_n != 0.0) 
+    inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny);
+  p.nx *= inv_len;  p.ny *= inv_len;  
+}
+
+/*! Enforce planar constraint on all particles in the list. Box boundaries and 
+ *  group membership are resolved once for the whole list.
+ *  \param particles list of particle indices
+ */
+void ConstraintPlane::enforce_all(const vector<int>& particles)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+  bool periodic = m_system->get_periodic();
+  double Lx = m_system->get_box()->Lx;
+  double Ly = m_system->get_box()->Ly;
+  double xlo = -0.5*Lx, xhi = 0.5*Lx;
+  double ylo = -0.5*Ly, yhi = 0.5*Ly;
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+      this->project(p,periodic,xlo,xhi,ylo,yhi);
   }
 }
 
@@ -161,6 +193,70 @@ double ConstraintPlane::project_torque(Particle& p)
     return 0.0;
 }
 
+/*! Rotate directors of all particles in the list around the z axis
+ *  \param particles list of particle indices
+ *  \param phi angles by which to rotate directors (one per particle in the list)
+*/
+void ConstraintPlane::rotate_directors(const vector<int>& particles, const vector<double>& phi)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+    {
+      double c = cos(phi[i]), s = sin(phi[i]);
+      double nx = c*p.nx - s*p.ny;
+      double ny = s*p.nx + c*p.ny;
+      double len = sqrt(nx*nx + ny*ny);
+      p.nx = nx/len;
+      p.ny = ny/len;
+    }
+  }
+}
+
+/*! Rotate velocities of all particles in the list around the z axis
+ *  \param particles list of particle indices
+ *  \param phi angles by which to rotate velocities (one per particle in the list)
+*/
+void ConstraintPlane::rotate_velocities(const vector<int>& particles, const vector<double>& phi)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+    {
+      double c = cos(phi[i]), s = sin(phi[i]);
+      double vx = c*p.vx - s*p.vy;
+      double vy = s*p.vx + c*p.vy;
+      p.vx = vx;
+      p.vy = vy;
+    }
+  }
+}
+
+/*! Add z component of the torque of all particles in the list to the rotation angle changes
+ *  \param particles list of particle indices
+ *  \param tau projected torques (one per particle in the list)
+*/ 
+void ConstraintPlane::project_torques(const vector<int>& particles, vector<double>& tau)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+      tau[i] += p.tau_z;
+  }
+}
+
 /*! Rescale box size and make sure that all particles fit in it.
  *  Rescaling is done only at certain steps and only if rescale 
  *  factor is not equal to 1.
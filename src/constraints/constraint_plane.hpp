@@ -92,6 +92,18 @@ public:
   //! Project torque onto normal vector to the plane (z axis) and return rotation angle change
   double project_torque(Particle&);
   
+  //! Enforce constraint on a list of particles
+  void enforce_all(const vector<int>&);
+  
+  //! Rotate directors of a list of particles around normal vector to the plane (z axis)
+  void rotate_directors(const vector<int>&, const vector<double>&);
+  
+  //! Rotate velocities of a list of particles around normal vector to the plane (z axis)
+  void rotate_velocities(const vector<int>&, const vector<double>&);
+  
+  //! Project torques of a list of particles onto normal vector to the plane (z axis)
+  void project_torques(const vector<int>&, vector<double>&);
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz) { Nx = 0.0; Ny = 0.0; Nz = 1.0; p.Nx = Nx; p.Ny = Ny; p.Nz = Nz; }
   
@@ -109,6 +121,9 @@ private:
   bool m_unlimited;       //!< If true, ignore box boundary and low system to exapand freely
   double m_zpos;            //!< Position (along z axis) of the constraint plane
   
+  //! Projects a single particle onto the plane
+  void project(Particle&, bool, double, double, double, double);
+  
   
 };
 
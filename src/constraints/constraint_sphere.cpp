@@ -43,43 +43,129 @@ void ConstraintSphere::enforce(Particle& p)
   else
     apply = (find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end());
   if (apply)
+    this->project(p);
+}
+
+/*! Projects particle onto the sphere, removes normal components of its velocity, 
+ *  director and forces and stores the normal.
+ *  \param p Particle which is to be projected onto the sphere
+ */
+void ConstraintSphere::project(Particle& p)
+{
+  double x = p.x, y = p.y, z = p.z;
+  double R = sqrt(x*x + y*y + z*z);
+  double s = m_r/R;
+  // Scale back to the surface
+  p.x *= s; p.y *= s; p.z *= s;
+  // Compute unit normal
+  double Nx = p.x/m_r, Ny = p.y/m_r, Nz = p.z/m_r;
+  // compute v.N
+  double v_dot_N = p.vx*Nx + p.vy*Ny + p.vz*Nz;
+  // compute n.N
+  double n_dot_N = p.nx*Nx + p.ny*Ny + p.nz*Nz;
+  // Project velocity onto tangent plane
+  p.vx -= v_dot_N*Nx; p.vy -= v_dot_N*Ny; p.vz -= v_dot_N*Nz;
+  // Project director onto tangent plane
+  p.nx -= n_dot_N*Nx; p.ny -= n_dot_N*Ny; p.nz -= n_dot_N*Nz;
+  // normalize director
+  double inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny + p.nz*p.nz);
+  p.nx *= inv_len;  p.ny *= inv_len;  p.nz *= inv_len;
+  // Set particle normal (it is reused until particle moves)
+  this->store_normal(p,Nx,Ny,Nz);
+  // Project all forces onto tangent plane
+  if (m_system->record_force_type())
   {
-    double x = p.x, y = p.y, z = p.z;
-    double R = sqrt(x*x + y*y + z*z);
-    double s = m_r/R;
-    // Scale back to the surface
-    p.x *= s; p.y *= s; p.z *= s;
-    // Compute unit normal
-    double Nx = p.x/m_r, Ny = p.y/m_r, Nz = p.z/m_r;
-    // compute v.N
-    double v_dot_N = p.vx*Nx + p.vy*Ny + p.vz*Nz;
-    // compute n.N
-    double n_dot_N = p.nx*Nx + p.ny*Ny + p.nz*Nz;
-    // Project velocity onto tangent plane
-    p.vx -= v_dot_N*Nx; p.vy -= v_dot_N*Ny; p.vz -= v_dot_N*Nz;
-    // Project director onto tangent plane
-    p.nx -= n_dot_N*Nx; p.ny -= n_dot_N*Ny; p.nz -= n_dot_N*Nz;
-    // normalize director
-    double inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny + p.nz*p.nz);
-    p.nx *= inv_len;  p.ny *= inv_len;  p.nz *= inv_len;
-    // Set particle normal
-    p.Nx = Nx; p.Ny = Ny; p.Nz = Nz;
-    // Project all forces onto tangent plane
-    if (m_system->record_force_type())
+    map<string,ForceType>& force_type = p.get_force_type();
+    for (map<string,ForceType>::iterator it = force_type.begin(); it != force_type.end(); it++)
     {
-      map<string,ForceType>& force_type = p.get_force_type();
-      for (map<string,ForceType>::iterator it = force_type.begin(); it != force_type.end(); it++)
-      {
-        double fx = (*it).second.fx, fy = (*it).second.fy, fz = (*it).second.fz; 
-        double f_dot_N = fx*Nx + fy*Ny + fz*Nz;
-        (*it).second.fx -= f_dot_N*Nx; 
-        (*it).second.fy -= f_dot_N*Ny;
-        (*it).second.fz -= f_dot_N*Nz;
-      }
+      double fx = (*it).second.fx, fy = (*it).second.fy, fz = (*it).second.fz; 
+      double f_dot_N = fx*Nx + fy*Ny + fz*Nz;
+      (*it).second.fx -= f_dot_N*Nx; 
+      (*it).second.fy -= f_dot_N*Ny;
+      (*it).second.fz -= f_dot_N*Nz;
     }
   }
 }
 
+/*! Enforce spherical constraint on all particles in the list. Group membership 
+ *  is resolved once for the whole list and each particle is projected 
+ *  without going through the virtual interface.
+ *  \param particles list of particle indices
+ */
+void ConstraintSphere::enforce_all(const vector<int>& particles)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+      this->project(p);
+  }
+}
+
+/*! Rotate directors of all particles in the list around the radial direction
+ *  \note This function assumes that particles have already been projected onto the sphere
+ *  \param particles list of particle indices
+ *  \param phi angles by which to rotate directors (one per particle in the list)
+ */
+void ConstraintSphere::rotate_directors(const vector<int>& particles, const vector<double>& phi)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+    {
+      double nx = p.nx, ny = p.ny, nz = p.nz;
+      rotate_vector(p.x/m_r,p.y/m_r,p.z/m_r,phi[i],nx,ny,nz);
+      double len = sqrt(nx*nx + ny*ny + nz*nz);
+      p.nx = nx/len;
+      p.ny = ny/len;
+      p.nz = nz/len;
+    }
+  }
+}
+
+/*! Rotate velocities of all particles in the list around the radial direction
+ *  \note This function assumes that particles have already been projected onto the sphere
+ *  \param particles list of particle indices
+ *  \param phi angles by which to rotate velocities (one per particle in the list)
+ */
+void ConstraintSphere::rotate_velocities(const vector<int>& particles, const vector<double>& phi)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+      rotate_vector(p.x/m_r,p.y/m_r,p.z/m_r,phi[i],p.vx,p.vy,p.vz);
+  }
+}
+
+/*! Project torques of all particles in the list onto the radial direction and
+ *  add them to the existing values
+ *  \param particles list of particle indices
+ *  \param tau projected torques (one per particle in the list)
+ */
+void ConstraintSphere::project_torques(const vector<int>& particles, vector<double>& tau)
+{
+  int N = particles.size();
+  bool all = (m_group == "all");
+#pragma omp parallel for if (N > CONSTRAINT_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    if (all || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+      tau[i] += p.tau_x*(p.x/m_r) + p.tau_y*(p.y/m_r) + p.tau_z*(p.z/m_r);
+  }
+}
+
 /*! Rescale sphere size and make sure that all particles are still on it.
  *  Rescaling is done only at certain steps and only if rescale 
  *  factor is not equal to 1.
@@ -92,6 +178,7 @@ bool ConstraintSphere::rescale()
     if ((step % m_rescale_freq == 0) && (step < m_rescale_steps))
     {
       m_r *= m_scale;
+      this->invalidate_normals();
       for  (int i = 0; i < m_system->size(); i++)
       {
         Particle& p = m_system->get_particle(i);
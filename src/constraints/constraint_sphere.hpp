@@ -72,6 +72,18 @@ public:
   //! Enforce constraint
   void enforce(Particle&);
   
+  //! Enforce constraint on a list of particles
+  void enforce_all(const vector<int>&);
+  
+  //! Rotate directors of a list of particles around normal vector to the sphere
+  void rotate_directors(const vector<int>&, const vector<double>&);
+  
+  //! Rotate velocities of a list of particles around normal vector to the sphere
+  void rotate_velocities(const vector<int>&, const vector<double>&);
+  
+  //! Project torques of a list of particles onto normal vector to the sphere
+  void project_torques(const vector<int>&, vector<double>&);
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz) { Nx = p.x/m_r; Ny = p.y/m_r; Nz = p.z/m_r; p.Nx = Nx; p.Ny = Ny; p.Nz = Nz; }
   
@@ -88,6 +100,9 @@ private:
   
   double m_r;     //!< Radius of the confining sphere
   
+  //! Projects a single particle onto the sphere
+  void project(Particle&);
+  
 };
 
 typedef shared_ptr<ConstraintSphere> ConstraintSpherePtr;  //!< Shared pointer to the Constraint object
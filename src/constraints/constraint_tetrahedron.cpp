@@ -97,6 +97,7 @@ bool ConstraintTetrahedron::rescale()
       m_a2 = m_s*tetra_a2;
       m_a3 = m_s*tetra_a3;
       m_a4 = m_s*tetra_a4;
+      this->invalidate_normals();
       for  (int i = 0; i < m_system->size(); i++)
       {
         Particle& p = m_system->get_particle(i);
@@ -0,0 +1,81 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file sdf_grid.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of SDFGrid class.
+ */ 
+
+#include "sdf_grid.hpp"
+
+/*! Construct grid. Values at all nodes are initially set to zero.
+ *  \param xlo x coordinate of the grid node with the lowest coordinates
+ *  \param ylo y coordinate of the grid node with the lowest coordinates
+ *  \param zlo z coordinate of the grid node with the lowest coordinates
+ *  \param nx number of grid nodes along x
+ *  \param ny number of grid nodes along y
+ *  \param nz number of grid nodes along z
+ *  \param h grid spacing
+ */
+SDFGrid::SDFGrid(double xlo, double ylo, double zlo, int nx, int ny, int nz, double h) : m_xlo(xlo), m_ylo(ylo), m_zlo(zlo),
+                                                                                         m_nx(nx), m_ny(ny), m_nz(nz),
+                                                                                         m_h(h), m_inv_h(1.0/h)
+{
+  m_stride_x = 4;
+  m_stride_y = 4*m_nx;
+  m_stride_z = 4*m_nx*m_ny;
+  m_data.assign(4*m_nx*m_ny*m_nz, 0.0f);
+}
+
+/*! Position of a grid node 
+ *  \param n node index
+ *  \param x x coordinate (returned)
+ *  \param y y coordinate (returned)
+ *  \param z z coordinate (returned)
+ */
+void SDFGrid::node_position(int n, double& x, double& y, double& z)
+{
+  int i = n % m_nx;
+  int j = (n / m_nx) % m_ny;
+  int k = n / (m_nx*m_ny);
+  x = m_xlo + i*m_h;
+  y = m_ylo + j*m_h;
+  z = m_zlo + k*m_h;
+}
+
+/*! Set signed distance and unit gradient at a grid node
+ *  \param n node index
+ *  \param d signed distance
+ *  \param nx x component of the unit gradient
+ *  \param ny y component of the unit gradient
+ *  \param nz z component of the unit gradient
+ */
+void SDFGrid::set(int n, double d, double nx, double ny, double nz)
+{
+  float* v = &m_data[4*n];
+  v[0] = static_cast<float>(d);  
+  v[1] = static_cast<float>(nx);  
+  v[2] = static_cast<float>(ny);  
+  v[3] = static_cast<float>(nz);
+}
@@ -0,0 +1,145 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file sdf_grid.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of SDFGrid class.
+ */ 
+
+#ifndef __SDF_GRID_HPP__
+#define __SDF_GRID_HPP__
+
+#include <cmath>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+using std::vector;
+using std::floor;
+using std::sqrt;
+using boost::shared_ptr;
+
+//! Signed distance is refined by projecting grid nodes onto the surface only within this many grid spacings from it
+#define SDF_GRID_BAND 2.0
+
+/*! SDFGrid stores signed distance to a surface and unit gradient of its implicit 
+ *  function sampled on a regular 3d grid. Signed distance is measured along the 
+ *  gradient, i.e. a point \f$ \vec r \f$ is moved onto the surface as 
+ *  \f$ \vec r - d\left(\vec r\right)\hat{\vec n}\left(\vec r\right) \f$. 
+ *  Values between grid nodes are obtained by trilinear interpolation. Values are 
+ *  stored in single precision to reduce memory footprint.
+ *  \note Grid only stores values. It is up to the constraint to sample its surface.
+*/
+class SDFGrid
+{
+public:
+  
+  //! Construct grid
+  SDFGrid(double, double, double, int, int, int, double);
+  
+  //! Number of grid nodes
+  int size() { return m_nx*m_ny*m_nz; }
+  
+  //! Number of grid nodes along x
+  int get_nx() { return m_nx; }
+  
+  //! Number of grid nodes along y
+  int get_ny() { return m_ny; }
+  
+  //! Number of grid nodes along z
+  int get_nz() { return m_nz; }
+  
+  //! Grid spacing
+  double get_spacing() { return m_h; }
+  
+  //! Position of a grid node
+  void node_position(int, double&, double&, double&);
+  
+  //! Set signed distance and unit gradient at a grid node
+  void set(int, double, double, double, double);
+  
+  /*! Interpolate signed distance and unit gradient at a point
+   *  \param x x coordinate of the point
+   *  \param y y coordinate of the point
+   *  \param z z coordinate of the point
+   *  \param d signed distance (returned)
+   *  \param nx x component of the unit gradient (returned)
+   *  \param ny y component of the unit gradient (returned)
+   *  \param nz z component of the unit gradient (returned)
+   *  \return false if the point is outside the grid
+   */
+  bool interpolate(double x, double y, double z, double& d, double& nx, double& ny, double& nz)
+  {
+    double fx = (x - m_xlo)*m_inv_h, fy = (y - m_ylo)*m_inv_h, fz = (z - m_zlo)*m_inv_h;
+    int i = static_cast<int>(floor(fx)), j = static_cast<int>(floor(fy)), k = static_cast<int>(floor(fz));
+    if (i < 0 || j < 0 || k < 0 || i >= m_nx - 1 || j >= m_ny - 1 || k >= m_nz - 1)
+      return false;
+    double tx = fx - i, ty = fy - j, tz = fz - k;
+    const float* v0 = &m_data[4*((k*m_ny + j)*m_nx + i)];
+    d = 0.0;  nx = 0.0;  ny = 0.0;  nz = 0.0;
+    for (int c = 0; c < 8; c++)
+    {
+      int a = c & 1, b = (c >> 1) & 1, e = (c >> 2) & 1;
+      double w = (a ? tx : 1.0 - tx)*(b ? ty : 1.0 - ty)*(e ? tz : 1.0 - tz);
+      const float* v = v0 + a*m_stride_x + b*m_stride_y + e*m_stride_z;
+      d += w*v[0];  nx += w*v[1];  ny += w*v[2];  nz += w*v[3];
+    }
+    return true;
+  }
+  
+  /*! Move point onto the surface using interpolated signed distance and gradient
+   *  \param x x coordinate of the point (updated)
+   *  \param y y coordinate of the point (updated)
+   *  \param z z coordinate of the point (updated)
+   *  \return false if the point is outside the grid (in which case it is not moved)
+   */
+  bool project(double& x, double& y, double& z)
+  {
+    double d, nx, ny, nz;
+    if (!this->interpolate(x,y,z,d,nx,ny,nz))
+      return false;
+    double len = sqrt(nx*nx + ny*ny + nz*nz);
+    if (len == 0.0)
+      return false;
+    double s = d/len;
+    x -= s*nx;  y -= s*ny;  z -= s*nz;
+    return true;
+  }
+  
+private:
+  
+  double m_xlo, m_ylo, m_zlo;   //!< Position of the grid node with the lowest coordinates
+  int m_nx, m_ny, m_nz;         //!< Number of grid nodes in each direction
+  double m_h;                   //!< Grid spacing
+  double m_inv_h;               //!< Inverse grid spacing
+  int m_stride_x;               //!< Offset in m_data between neighbouring nodes along x
+  int m_stride_y;               //!< Offset in m_data between neighbouring nodes along y
+  int m_stride_z;               //!< Offset in m_data between neighbouring nodes along z
+  vector<float> m_data;         //!< Signed distance and unit gradient (4 values per node, single precision is sufficient since projection is polished by the Newton step)
+  
+};
+
+typedef shared_ptr<SDFGrid> SDFGridPtr;  //!< Shared pointer to the SDFGrid object
+
+#endif
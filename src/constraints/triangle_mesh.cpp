@@ -0,0 +1,720 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file triangle_mesh.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of TriangleMesh class.
+ */ 
+
+#include "triangle_mesh.hpp"
+
+#include <map>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+using std::map;
+using std::istringstream;
+using std::numeric_limits;
+using boost::lexical_cast;
+using boost::algorithm::trim;
+using boost::algorithm::to_lower;
+using boost::algorithm::to_lower_copy;
+using boost::algorithm::ends_with;
+
+//! Position of a vertex (used to merge vertices shared by triangles in STL files)
+struct VertexKey
+{
+  double x, y, z;
+  bool operator<(const VertexKey& k) const
+  {
+    if (x != k.x) return x < k.x;
+    if (y != k.y) return y < k.y;
+    return z < k.z;
+  }
+};
+
+//! Property of an element in the PLY header
+struct PLYProperty
+{
+  string name;        //!< Property name
+  string type;        //!< Value type (for lists, type of list entries)
+  string count_type;  //!< Type of the list length (empty if property is not a list)
+};
+
+//! Element in the PLY header
+struct PLYElement
+{
+  string name;                     //!< Element name (e.g., vertex or face)
+  int count;                       //!< Number of elements
+  vector<PLYProperty> properties;  //!< Properties of each element
+};
+
+/*! Read a single binary value from a PLY file and convert it to double
+ *  \param inp input stream
+ *  \param type PLY type of the value
+ *  \param swap if true, byte order is swapped (file and machine byte order differ)
+ */
+static double read_ply_binary(std::ifstream& inp, const string& type, bool swap)
+{
+  char buf[8];
+  int size;
+  if (type == "char" || type == "int8" || type == "uchar" || type == "uint8") size = 1;
+  else if (type == "short" || type == "int16" || type == "ushort" || type == "uint16") size = 2;
+  else if (type == "int" || type == "int32" || type == "uint" || type == "uint32" || type == "float" || type == "float32") size = 4;
+  else if (type == "double" || type == "float64") size = 8;
+  else throw runtime_error("Unknown PLY property type "+type+".");
+  inp.read(buf,size);
+  if (swap)
+    std::reverse(buf,buf+size);
+  if (type == "char" || type == "int8") { signed char v; memcpy(&v,buf,1); return v; }
+  if (type == "uchar" || type == "uint8") { unsigned char v; memcpy(&v,buf,1); return v; }
+  if (type == "short" || type == "int16") { short v; memcpy(&v,buf,2); return v; }
+  if (type == "ushort" || type == "uint16") { unsigned short v; memcpy(&v,buf,2); return v; }
+  if (type == "int" || type == "int32") { int v; memcpy(&v,buf,4); return v; }
+  if (type == "uint" || type == "uint32") { unsigned int v; memcpy(&v,buf,4); return v; }
+  if (type == "float" || type == "float32") { float v; memcpy(&v,buf,4); return v; }
+  double v; memcpy(&v,buf,8); return v;
+}
+
+/*! Return index of a vertex at a given position, adding it to the list if it is new
+ *  \param vertex list of vertex positions
+ *  \param index map between vertex positions and their indices
+ *  \param x x coordinate of the vertex
+ *  \param y y coordinate of the vertex
+ *  \param z z coordinate of the vertex
+ */
+static int weld_vertex(vector<double>& vertex, map<VertexKey,int>& index, double x, double y, double z)
+{
+  VertexKey key = {x, y, z};
+  map<VertexKey,int>::iterator it = index.find(key);
+  if (it != index.end())
+    return it->second;
+  int idx = vertex.size()/3;
+  vertex.push_back(x);  vertex.push_back(y);  vertex.push_back(z);
+  index[key] = idx;
+  return idx;
+}
+
+/*! Read mesh from a file and build the bounding volume hierarchy.
+ *  File format is determined from the file extension (.obj, .ply or .stl).
+ *  \param msg Pointer to the internal state messenger
+ *  \param filename name of the file containing the mesh
+ *  \param scale all vertex positions are multiplied by this factor
+ */
+TriangleMesh::TriangleMesh(MessengerPtr msg, const string& filename, double scale) : m_msg(msg)
+{
+  string ext = to_lower_copy(filename);
+  if (!(ends_with(ext,".obj") || ends_with(ext,".ply") || ends_with(ext,".stl")))
+  {
+    m_msg->msg(Messenger::ERROR,"Triangle mesh. Unknown format of mesh file "+filename+". Supported formats are OBJ, PLY and STL.");
+    throw runtime_error("Unknown mesh file format.");
+  }
+  std::ifstream inp;
+  inp.exceptions ( std::ifstream::failbit | std::ifstream::badbit );
+  try
+  {
+    inp.open(filename.c_str(), std::ios::in | std::ios::binary);
+  }
+  catch (std::exception& e)
+  {
+    m_msg->msg(Messenger::ERROR,"Triangle mesh. Problem opening mesh file "+filename+".");
+    throw e;
+  }
+  inp.exceptions ( std::ifstream::badbit ); // need to reset ios exceptions to avoid EOF failure of getline
+  m_msg->msg(Messenger::INFO,"Triangle mesh. Reading mesh from file "+filename+".");
+  if (ends_with(ext,".obj"))
+    this->read_obj(inp);
+  else if (ends_with(ext,".ply"))
+    this->read_ply(inp);
+  else
+    this->read_stl(inp);
+  inp.close();
+  if (this->num_triangles() == 0)
+  {
+    m_msg->msg(Messenger::ERROR,"Triangle mesh. File "+filename+" does not contain any (non-degenerate) triangles.");
+    throw runtime_error("Empty mesh.");
+  }
+  for (unsigned int i = 0; i < m_vertex.size(); i++)
+    m_vertex[i] *= scale;
+  m_msg->msg(Messenger::INFO,"Triangle mesh. Read "+lexical_cast<string>(this->num_vertices())+" vertices and "+lexical_cast<string>(this->num_triangles())+" triangles.");
+  this->compute_vertex_normals();
+  this->build_bvh();
+  m_msg->msg(Messenger::INFO,"Triangle mesh. Built bounding volume hierarchy with "+lexical_cast<string>(this->num_nodes())+" nodes.");
+}
+
+/*! Find the point on the surface closest to a given point. Nodes of the 
+ *  bounding volume hierarchy are visited nearest first and subtrees whose 
+ *  bounding boxes are further away than the closest triangle found so far 
+ *  are skipped. 
+ *  \param x x coordinate of the point
+ *  \param y y coordinate of the point
+ *  \param z z coordinate of the point
+ *  \param cx x coordinate of the closest point (returned)
+ *  \param cy y coordinate of the closest point (returned)
+ *  \param cz z coordinate of the closest point (returned)
+ *  \param Nx x component of the unit normal at the closest point (returned)
+ *  \param Ny y component of the unit normal at the closest point (returned)
+ *  \param Nz z component of the unit normal at the closest point (returned)
+ *  \return distance between the point and the surface
+ */
+double TriangleMesh::closest_point(double x, double y, double z, double& cx, double& cy, double& cz, double& Nx, double& Ny, double& Nz)
+{
+  int stack[MESH_BVH_MAX_DEPTH+1];
+  double stack_dist[MESH_BVH_MAX_DEPTH+1];
+  int top = 0;
+  double best = numeric_limits<double>::max();
+  int best_t = 0;
+  double best_v = 0.0, best_w = 0.0;
+  stack[top] = 0;  stack_dist[top++] = box_distance_sq(m_node[0],x,y,z);
+  while (top > 0)
+  {
+    top--;
+    if (stack_dist[top] >= best)
+      continue;
+    int n = stack[top];
+    const BVHNode& node = m_node[n];
+    if (node.count > 0)
+    {
+      for (int t = node.start; t < node.start + node.count; t++)
+      {
+        double px, py, pz, v, w;
+        closest_point_triangle(&m_corner[9*t],x,y,z,px,py,pz,v,w);
+        double d_sq = (x - px)*(x - px) + (y - py)*(y - py) + (z - pz)*(z - pz);
+        if (d_sq < best)
+        {
+          best = d_sq;  best_t = t;  best_v = v;  best_w = w;
+          cx = px;  cy = py;  cz = pz;
+        }
+      }
+    }
+    else
+    {
+      int left = node.start, right = node.start + 1;
+      double d_left = box_distance_sq(m_node[left],x,y,z);
+      double d_right = box_distance_sq(m_node[right],x,y,z);
+      // push the nearer child last so that it is visited first
+      if (d_left < d_right)
+      {
+        if (d_right < best) { stack[top] = right;  stack_dist[top++] = d_right; }
+        if (d_left < best)  { stack[top] = left;   stack_dist[top++] = d_left; }
+      }
+      else
+      {
+        if (d_left < best)  { stack[top] = left;   stack_dist[top++] = d_left; }
+        if (d_right < best) { stack[top] = right;  stack_dist[top++] = d_right; }
+      }
+    }
+  }
+  // Interpolate vertex normals
+  const int* tri = &m_triangle[3*best_t];
+  double u = 1.0 - best_v - best_w;
+  const double* n0 = &m_vertex_normal[3*tri[0]];
+  const double* n1 = &m_vertex_normal[3*tri[1]];
+  const double* n2 = &m_vertex_normal[3*tri[2]];
+  Nx = u*n0[0] + best_v*n1[0] + best_w*n2[0];
+  Ny = u*n0[1] + best_v*n1[1] + best_w*n2[1];
+  Nz = u*n0[2] + best_v*n1[2] + best_w*n2[2];
+  double len = sqrt(Nx*Nx + Ny*Ny + Nz*Nz);
+  if (len == 0.0)   // vertex normals cancel out (e.g., on a sharp ridge), use normal of the triangle itself
+  {
+    const double* c = &m_corner[9*best_t];
+    double abx = c[3] - c[0], aby = c[4] - c[1], abz = c[5] - c[2];
+    double acx = c[6] - c[0], acy = c[7] - c[1], acz = c[8] - c[2];
+    Nx = aby*acz - abz*acy;  Ny = abz*acx - abx*acz;  Nz = abx*acy - aby*acx;
+    len = sqrt(Nx*Nx + Ny*Ny + Nz*Nz);
+  }
+  Nx /= len;  Ny /= len;  Nz /= len;
+  return sqrt(best);
+}
+
+/*! Read mesh in Wavefront OBJ format. Only vertex (v) and face (f) records are used.
+ *  Polygonal faces are split into triangles as fans around their first vertex.
+ *  Negative (relative) vertex indices are supported.
+ *  \param inp input stream
+ */
+void TriangleMesh::read_obj(std::ifstream& inp)
+{
+  string line;
+  int line_num = 0;
+  while (getline(inp, line))
+  {
+    line_num++;
+    trim(line);
+    if (line.size() == 0 || line[0] == '#')
+      continue;
+    istringstream s_line(line);
+    string key;
+    s_line >> key;
+    if (key == "v")
+    {
+      double x, y, z;
+      if (!(s_line >> x >> y >> z))
+      {
+        m_msg->msg(Messenger::ERROR,"Triangle mesh. Invalid vertex in OBJ file at line "+lexical_cast<string>(line_num)+".");
+        throw runtime_error("Invalid vertex in OBJ file.");
+      }
+      m_vertex.push_back(x);  m_vertex.push_back(y);  m_vertex.push_back(z);
+    }
+    else if (key == "f")
+    {
+      vector<int> face;
+      string token;
+      while (s_line >> token)
+      {
+        int idx = lexical_cast<int>(token.substr(0, token.find('/')));   // drop texture and normal indices
+        face.push_back((idx < 0) ? this->num_vertices() + idx : idx - 1);
+      }
+      if (face.size() < 3)
+      {
+        m_msg->msg(Messenger::ERROR,"Triangle mesh. Face with fewer than 3 vertices in OBJ file at line "+lexical_cast<string>(line_num)+".");
+        throw runtime_error("Invalid face in OBJ file.");
+      }
+      for (unsigned int i = 1; i < face.size() - 1; i++)
+        this->add_triangle(face[0],face[i],face[i+1]);
+    }
+  }
+}
+
+/*! Read mesh in Stanford PLY format (ASCII or binary). Vertex positions are read from 
+ *  x, y and z properties of the vertex element and triangles from vertex_indices 
+ *  (or vertex_index) list of the face element. All other elements and properties are skipped.
+ *  Polygonal faces are split into triangles as fans around their first vertex.
+ *  \note Byte order of binary files is taken from the header.
+ *  \param inp input stream
+ */
+void TriangleMesh::read_ply(std::ifstream& inp)
+{
+  string line;
+  getline(inp, line);
+  trim(line);
+  if (line != "ply")
+  {
+    m_msg->msg(Messenger::ERROR,"Triangle mesh. File is not in PLY format.");
+    throw runtime_error("Invalid PLY file.");
+  }
+  string format;
+  vector<PLYElement> elements;
+  while (getline(inp, line))
+  {
+    trim(line);
+    istringstream s_line(line);
+    string key;
+    s_line >> key;
+    if (key == "format")
+      s_line >> format;
+    else if (key == "element")
+    {
+      PLYElement el;
+      s_line >> el.name >> el.count;
+      elements.push_back(el);
+    }
+    else if (key == "property")
+    {
+      if (elements.size() == 0)
+      {
+        m_msg->msg(Messenger::ERROR,"Triangle mesh. Property defined before any element in PLY header.");
+        throw runtime_error("Invalid PLY header.");
+      }
+      PLYProperty prop;
+      s_line >> prop.type;
+      if (prop.type == "list")
+        s_line >> prop.count_type >> prop.type;
+      s_line >> prop.name;
+      elements.back().properties.push_back(prop);
+    }
+    else if (key == "end_header")
+      break;
+  }
+  bool ascii = (format == "ascii");
+  bool swap = false;
+  if (!ascii)
+  {
+    int one = 1;
+    bool little = (*reinterpret_cast<char*>(&one) == 1);
+    if (format == "binary_little_endian")
+      swap = !little;
+    else if (format == "binary_big_endian")
+      swap = little;
+    else
+    {
+      m_msg->msg(Messenger::ERROR,"Triangle mesh. Unknown PLY format "+format+".");
+      throw runtime_error("Unknown PLY format.");
+    }
+  }
+  for (vector<PLYElement>::iterator it_e = elements.begin(); it_e != elements.end(); it_e++)
+  {
+    bool is_vertex = (it_e->name == "vertex"), is_face = (it_e->name == "face");
+    for (int e = 0; e < it_e->count; e++)
+    {
+      double x = 0.0, y = 0.0, z = 0.0;
+      vector<int> face;
+      istringstream s_line;
+      if (ascii)
+      {
+        if (!getline(inp, line))
+        {
+          m_msg->msg(Messenger::ERROR,"Triangle mesh. Unexpected end of PLY file.");
+          throw runtime_error("Truncated PLY file.");
+        }
+        s_line.str(line);
+      }
+      for (vector<PLYProperty>::iterator it_p = it_e->properties.begin(); it_p != it_e->properties.end(); it_p++)
+      {
+        int count = 1;
+        if (it_p->count_type.size() > 0)
+        {
+          double c = 0.0;
+          if (ascii) s_line >> c;
+          else c = read_ply_binary(inp, it_p->count_type, swap);
+          count = static_cast<int>(c);
+        }
+        for (int i = 0; i < count; i++)
+        {
+          double val = 0.0;
+          if (ascii) s_line >> val;
+          else val = read_ply_binary(inp, it_p->type, swap);
+          if (is_vertex && it_p->name == "x") x = val;
+          else if (is_vertex && it_p->name == "y") y = val;
+          else if (is_vertex && it_p->name == "z") z = val;
+          else if (is_face && (it_p->name == "vertex_indices" || it_p->name == "vertex_index")) face.push_back(static_cast<int>(val));
+        }
+      }
+      if ((ascii && s_line.fail()) || (!ascii && !inp))
+      {
+        m_msg->msg(Messenger::ERROR,"Triangle mesh. Invalid or truncated "+it_e->name+" data in PLY file.");
+        throw runtime_error("Invalid PLY file.");
+      }
+      if (is_vertex)
+      {
+        m_vertex.push_back(x);  m_vertex.push_back(y);  m_vertex.push_back(z);
+      }
+      else if (is_face)
+        for (int i = 1; i < static_cast<int>(face.size()) - 1; i++)
+          this->add_triangle(face[0],face[i],face[i+1]);
+    }
+  }
+}
+
+/*! Read mesh in STL format (ASCII or binary). Since STL stores each triangle 
+ *  separately, vertices with identical coordinates are merged. Normals stored 
+ *  in the file are ignored. 
+ *  \note Binary STL files are little endian. We assume that so is the machine.
+ *  \param inp input stream
+ */
+void TriangleMesh::read_stl(std::ifstream& inp)
+{
+  map<VertexKey,int> index;
+  // File is binary if its size matches the number of triangles given in the header
+  inp.seekg(0, std::ios::end);
+  long size = inp.tellg();
+  inp.seekg(0, std::ios::beg);
+  bool binary = false;
+  unsigned int num_tri = 0;
+  if (size >= 84)
+  {
+    char header[80];
+    inp.read(header, 80);
+    inp.read(reinterpret_cast<char*>(&num_tri), 4);
+    binary = (size == 84 + 50*static_cast<long>(num_tri));
+    if (!binary)
+      inp.seekg(0, std::ios::beg);
+  }
+  if (binary)
+  {
+    for (unsigned int t = 0; t < num_tri; t++)
+    {
+      float data[12];  // normal followed by three vertices
+      char attrib[2];
+      inp.read(reinterpret_cast<char*>(data), 48);
+      inp.read(attrib, 2);
+      int i = weld_vertex(m_vertex, index, data[3], data[4], data[5]);
+      int j = weld_vertex(m_vertex, index, data[6], data[7], data[8]);
+      int k = weld_vertex(m_vertex, index, data[9], data[10], data[11]);
+      this->add_triangle(i,j,k);
+    }
+  }
+  else
+  {
+    string line;
+    vector<int> facet;
+    while (getline(inp, line))
+    {
+      trim(line);
+      to_lower(line);
+      istringstream s_line(line);
+      string key;
+      s_line >> key;
+      if (key == "vertex")
+      {
+        double x, y, z;
+        if (!(s_line >> x >> y >> z))
+        {
+          m_msg->msg(Messenger::ERROR,"Triangle mesh. Invalid vertex in STL file.");
+          throw runtime_error("Invalid vertex in STL file.");
+        }
+        facet.push_back(weld_vertex(m_vertex, index, x, y, z));
+      }
+      else if (key == "endfacet")
+      {
+        for (int i = 1; i < static_cast<int>(facet.size()) - 1; i++)
+          this->add_triangle(facet[0],facet[i],facet[i+1]);
+        facet.clear();
+      }
+    }
+  }
+}
+
+/*! Add triangle to the mesh. Degenerate triangles (with zero area) 
+ *  are skipped as they do not contribute to the surface.
+ *  \param i index of the first vertex
+ *  \param j index of the second vertex
+ *  \param k index of the third vertex
+ */
+void TriangleMesh::add_triangle(int i, int j, int k)
+{
+  int nv = this->num_vertices();
+  if (i < 0 || j < 0 || k < 0 || i >= nv || j >= nv || k >= nv)
+  {
+    m_msg->msg(Messenger::ERROR,"Triangle mesh. Triangle refers to a non-existent vertex.");
+    throw runtime_error("Invalid vertex index in mesh file.");
+  }
+  const double* a = &m_vertex[3*i];
+  const double* b = &m_vertex[3*j];
+  const double* c = &m_vertex[3*k];
+  double abx = b[0] - a[0], aby = b[1] - a[1], abz = b[2] - a[2];
+  double acx = c[0] - a[0], acy = c[1] - a[1], acz = c[2] - a[2];
+  double nx = aby*acz - abz*acy, ny = abz*acx - abx*acz, nz = abx*acy - aby*acx;
+  if (nx*nx + ny*ny + nz*nz == 0.0)
+    return;
+  m_triangle.push_back(i);  m_triangle.push_back(j);  m_triangle.push_back(k);
+}
+
+/*! Compute unit normals at vertices as area weighted averages of normals 
+ *  of all triangles sharing a vertex. 
+ */
+void TriangleMesh::compute_vertex_normals()
+{
+  m_vertex_normal.assign(m_vertex.size(), 0.0);
+  int nt = this->num_triangles();
+  for (int t = 0; t < nt; t++)
+  {
+    const int* tri = &m_triangle[3*t];
+    const double* a = &m_vertex[3*tri[0]];
+    const double* b = &m_vertex[3*tri[1]];
+    const double* c = &m_vertex[3*tri[2]];
+    double abx = b[0] - a[0], aby = b[1] - a[1], abz = b[2] - a[2];
+    double acx = c[0] - a[0], acy = c[1] - a[1], acz = c[2] - a[2];
+    // cross product has length equal to twice the triangle area
+    double nx = aby*acz - abz*acy, ny = abz*acx - abx*acz, nz = abx*acy - aby*acx;
+    for (int v = 0; v < 3; v++)
+    {
+      m_vertex_normal[3*tri[v]]   += nx;
+      m_vertex_normal[3*tri[v]+1] += ny;
+      m_vertex_normal[3*tri[v]+2] += nz;
+    }
+  }
+  int nv = this->num_vertices();
+  for (int i = 0; i < nv; i++)
+  {
+    double* n = &m_vertex_normal[3*i];
+    double len = sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+    if (len > 0.0)
+    {
+      n[0] /= len;  n[1] /= len;  n[2] /= len;
+    }
+  }
+}
+
+/*! Build the bounding volume hierarchy. Triangles are reordered so that 
+ *  each leaf holds a contiguous range of them and triangle corners are copied 
+ *  into a separate array in the same order.
+ */
+void TriangleMesh::build_bvh()
+{
+  int nt = this->num_triangles();
+  vector<int> order(nt);
+  vector<double> centroid(3*nt);
+  for (int t = 0; t < nt; t++)
+  {
+    order[t] = t;
+    for (int d = 0; d < 3; d++)
+      centroid[3*t+d] = (m_vertex[3*m_triangle[3*t]+d] + m_vertex[3*m_triangle[3*t+1]+d] + m_vertex[3*m_triangle[3*t+2]+d])/3.0;
+  }
+  m_node.clear();
+  m_node.reserve(2*nt/MESH_BVH_LEAF_SIZE + 1);
+  m_node.resize(1);
+  this->build_node(0, order, centroid, 0, nt, 0);
+  // Reorder triangles to follow the leaves
+  vector<int> triangle(3*nt);
+  m_corner.resize(9*nt);
+  for (int t = 0; t < nt; t++)
+    for (int v = 0; v < 3; v++)
+    {
+      int i = m_triangle[3*order[t]+v];
+      triangle[3*t+v] = i;
+      for (int d = 0; d < 3; d++)
+        m_corner[9*t+3*v+d] = m_vertex[3*i+d];
+    }
+  m_triangle.swap(triangle);
+}
+
+//! Compares triangle centroids along a given axis (used to split BVH nodes)
+struct CentroidCompare
+{
+  CentroidCompare(const vector<double>& centroid, int axis) : m_centroid(centroid), m_axis(axis) { }
+  bool operator()(int a, int b) const { return m_centroid[3*a+m_axis] < m_centroid[3*b+m_axis]; }
+  const vector<double>& m_centroid;
+  int m_axis;
+};
+
+/*! Recursively build a subtree of the bounding volume hierarchy. Triangles are 
+ *  split at the median of their centroids along the longest extent of the centroids.
+ *  \param n index of the node (already allocated)
+ *  \param order triangle indices (reordered on return)
+ *  \param centroid triangle centroids
+ *  \param begin first triangle in order handled by this node
+ *  \param end one past the last triangle in order handled by this node
+ *  \param depth depth of the node in the hierarchy
+ */
+void TriangleMesh::build_node(int n, vector<int>& order, const vector<double>& centroid, int begin, int end, int depth)
+{
+  double lo[3], hi[3];    // bounds of triangles
+  double clo[3], chi[3];  // bounds of triangle centroids
+  for (int d = 0; d < 3; d++)
+  {
+    lo[d] = clo[d] = numeric_limits<double>::max();
+    hi[d] = chi[d] = -numeric_limits<double>::max();
+  }
+  for (int t = begin; t < end; t++)
+    for (int d = 0; d < 3; d++)
+    {
+      for (int v = 0; v < 3; v++)
+      {
+        double x = m_vertex[3*m_triangle[3*order[t]+v]+d];
+        lo[d] = std::min(lo[d], x);
+        hi[d] = std::max(hi[d], x);
+      }
+      clo[d] = std::min(clo[d], centroid[3*order[t]+d]);
+      chi[d] = std::max(chi[d], centroid[3*order[t]+d]);
+    }
+  BVHNode& node = m_node[n];
+  for (int d = 0; d < 3; d++)
+  {
+    // round outwards, so that single precision box still contains all triangles
+    node.lo[d] = static_cast<float>(lo[d]);
+    if (node.lo[d] > lo[d]) node.lo[d] = nextafterf(node.lo[d], -numeric_limits<float>::max());
+    node.hi[d] = static_cast<float>(hi[d]);
+    if (node.hi[d] < hi[d]) node.hi[d] = nextafterf(node.hi[d], numeric_limits<float>::max());
+  }
+  node.start = begin;
+  node.count = end - begin;
+  if (end - begin <= MESH_BVH_LEAF_SIZE || depth >= MESH_BVH_MAX_DEPTH - 1)
+    return;
+  int axis = 0;
+  if (chi[1] - clo[1] > chi[axis] - clo[axis]) axis = 1;
+  if (chi[2] - clo[2] > chi[axis] - clo[axis]) axis = 2;
+  int mid = (begin + end)/2;
+  std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, CentroidCompare(centroid, axis));
+  int left = m_node.size();
+  node.start = left;
+  node.count = 0;
+  m_node.resize(left + 2);   // invalidates node
+  this->build_node(left, order, centroid, begin, mid, depth + 1);
+  this->build_node(left + 1, order, centroid, mid, end, depth + 1);
+}
+
+/*! Closest point on a triangle to a given point. 
+ *  \note Follows C. Ericson, Real-Time Collision Detection, Section 5.1.5.
+ *  \param c positions of triangle corners a, b and c (9 values)
+ *  \param x x coordinate of the point
+ *  \param y y coordinate of the point
+ *  \param z z coordinate of the point
+ *  \param px x coordinate of the closest point (returned)
+ *  \param py y coordinate of the closest point (returned)
+ *  \param pz z coordinate of the closest point (returned)
+ *  \param v barycentric coordinate of the closest point with respect to corner b (returned)
+ *  \param w barycentric coordinate of the closest point with respect to corner c (returned)
+ */
+void TriangleMesh::closest_point_triangle(const double* c, double x, double y, double z, double& px, double& py, double& pz, double& v, double& w)
+{
+  double abx = c[3] - c[0], aby = c[4] - c[1], abz = c[5] - c[2];
+  double acx = c[6] - c[0], acy = c[7] - c[1], acz = c[8] - c[2];
+  double apx = x - c[0], apy = y - c[1], apz = z - c[2];
+  double d1 = abx*apx + aby*apy + abz*apz;
+  double d2 = acx*apx + acy*apy + acz*apz;
+  if (d1 <= 0.0 && d2 <= 0.0)   // vertex region of a
+  {
+    v = 0.0;  w = 0.0;
+    px = c[0];  py = c[1];  pz = c[2];
+    return;
+  }
+  double bpx = x - c[3], bpy = y - c[4], bpz = z - c[5];
+  double d3 = abx*bpx + aby*bpy + abz*bpz;
+  double d4 = acx*bpx + acy*bpy + acz*bpz;
+  if (d3 >= 0.0 && d4 <= d3)    // vertex region of b
+  {
+    v = 1.0;  w = 0.0;
+    px = c[3];  py = c[4];  pz = c[5];
+    return;
+  }
+  double vc = d1*d4 - d3*d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)   // edge region of ab
+  {
+    v = d1/(d1 - d3);  w = 0.0;
+    px = c[0] + v*abx;  py = c[1] + v*aby;  pz = c[2] + v*abz;
+    return;
+  }
+  double cpx = x - c[6], cpy = y - c[7], cpz = z - c[8];
+  double d5 = abx*cpx + aby*cpy + abz*cpz;
+  double d6 = acx*cpx + acy*cpy + acz*cpz;
+  if (d6 >= 0.0 && d5 <= d6)    // vertex region of c
+  {
+    v = 0.0;  w = 1.0;
+    px = c[6];  py = c[7];  pz = c[8];
+    return;
+  }
+  double vb = d5*d2 - d1*d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)   // edge region of ac
+  {
+    v = 0.0;  w = d2/(d2 - d6);
+    px = c[0] + w*acx;  py = c[1] + w*acy;  pz = c[2] + w*acz;
+    return;
+  }
+  double va = d3*d6 - d5*d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)   // edge region of bc
+  {
+    w = (d4 - d3)/((d4 - d3) + (d5 - d6));  v = 1.0 - w;
+    px = c[3] + w*(c[6] - c[3]);  py = c[4] + w*(c[7] - c[4]);  pz = c[5] + w*(c[8] - c[5]);
+    return;
+  }
+  // face region
+  double denom = 1.0/(va + vb + vc);
+  v = vb*denom;  w = vc*denom;
+  px = c[0] + abx*v + acx*w;  py = c[1] + aby*v + acy*w;  pz = c[2] + abz*v + acz*w;
+}
@@ -0,0 +1,147 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file triangle_mesh.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of TriangleMesh class.
+ */ 
+
+#ifndef __TRIANGLE_MESH_HPP__
+#define __TRIANGLE_MESH_HPP__
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/shared_ptr.hpp>
+
+#include "messenger.hpp"
+
+using std::vector;
+using std::string;
+using std::sqrt;
+using std::runtime_error;
+using boost::shared_ptr;
+
+//! Maximum number of triangles stored in a leaf of the bounding volume hierarchy
+#define MESH_BVH_LEAF_SIZE 4
+
+//! Maximum depth of the bounding volume hierarchy (nodes are split at the median, so depth grows as log2 of the number of triangles)
+#define MESH_BVH_MAX_DEPTH 64
+
+/*! Node of the bounding volume hierarchy. Children of an internal node are stored 
+ *  next to each other, so that both are usually fetched from memory together. 
+ *  Bounding boxes are stored in single precision (rounded outwards) to keep nodes small.
+*/
+struct BVHNode
+{
+  float lo[3];      //!< Lower corner of the axis aligned bounding box
+  float hi[3];      //!< Upper corner of the axis aligned bounding box
+  int start;        //!< Index of the first triangle (leaf) or of the first child (internal node; second child follows it)
+  int count;        //!< Number of triangles in the leaf (0 for internal nodes)
+};
+
+/*! TriangleMesh holds a triangulated surface read from a file (OBJ, PLY or STL format)
+ *  and answers closest point queries on it. Triangles are organised into a bounding 
+ *  volume hierarchy (BVH) of axis aligned boxes, so that a query visits on average 
+ *  O(log F) nodes for a surface with F triangles.
+ *  Normals at vertices are computed as area weighted averages of the normals 
+ *  of all triangles sharing the vertex and are interpolated across each triangle.
+ *  Their orientation follows the orientation (winding) of triangles in the file.
+ *  \note Mesh is not periodic, i.e. queries do not consider periodic images of the surface.
+*/
+class TriangleMesh
+{
+public:
+  
+  //! Read mesh from a file and build the bounding volume hierarchy
+  TriangleMesh(MessengerPtr, const string&, double);
+  
+  //! Number of vertices
+  int num_vertices() { return m_vertex.size()/3; }
+  
+  //! Number of triangles
+  int num_triangles() { return m_triangle.size()/3; }
+  
+  //! Number of nodes in the bounding volume hierarchy
+  int num_nodes() { return m_node.size(); }
+  
+  //! Find the point on the surface closest to a given point
+  double closest_point(double, double, double, double&, double&, double&, double&, double&, double&);
+  
+private:
+  
+  MessengerPtr m_msg;               //!< Handles internal messages
+  vector<double> m_vertex;          //!< Vertex positions (3 values per vertex)
+  vector<double> m_vertex_normal;   //!< Unit normals at vertices (3 values per vertex)
+  vector<int> m_triangle;           //!< Vertex indices of triangles (3 per triangle, in the order of BVH leaves)
+  vector<double> m_corner;          //!< Positions of triangle corners (9 values per triangle, copied for cache friendly queries)
+  vector<BVHNode> m_node;           //!< Nodes of the bounding volume hierarchy
+  
+  //! Read mesh in Wavefront OBJ format
+  void read_obj(std::ifstream&);
+  
+  //! Read mesh in Stanford PLY format
+  void read_ply(std::ifstream&);
+  
+  //! Read mesh in STL format
+  void read_stl(std::ifstream&);
+  
+  //! Add triangle to the mesh
+  void add_triangle(int, int, int);
+  
+  //! Compute vertex normals
+  void compute_vertex_normals();
+  
+  //! Build the bounding volume hierarchy
+  void build_bvh();
+  
+  //! Recursively build a subtree of the bounding volume hierarchy
+  void build_node(int, vector<int>&, const vector<double>&, int, int, int);
+  
+  /*! Squared distance between a point and the bounding box of a node 
+   *  \param node BVH node
+   *  \param x x coordinate of the point
+   *  \param y y coordinate of the point
+   *  \param z z coordinate of the point
+   */
+  static double box_distance_sq(const BVHNode& node, double x, double y, double z)
+  {
+    double dx = 0.0, dy = 0.0, dz = 0.0;
+    if (x < node.lo[0]) dx = node.lo[0] - x; else if (x > node.hi[0]) dx = x - node.hi[0];
+    if (y < node.lo[1]) dy = node.lo[1] - y; else if (y > node.hi[1]) dy = y - node.hi[1];
+    if (z < node.lo[2]) dz = node.lo[2] - z; else if (z > node.hi[2]) dz = z - node.hi[2];
+    return dx*dx + dy*dy + dz*dz;
+  }
+  
+  //! Closest point on a single triangle
+  static void closest_point_triangle(const double*, double, double, double, double&, double&, double&, double&, double&);
+  
+};
+
+typedef shared_ptr<TriangleMesh> TriangleMeshPtr;  //!< Shared pointer to the TriangleMesh object
+
+#endif
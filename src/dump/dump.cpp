@@ -142,6 +142,18 @@ Dump::Dump(SystemPtr sys, MessengerPtr msg, NeighbourListPtr nlist, const string
     m_freq = lexical_cast<int>(params["freq"]);
   }
   m_msg->write_config("dump."+fname+".freq",lexical_cast<string>(m_freq));
+  if (m_type == "xyzc")
+  {
+    // XYZC dumps per-particle energies, so they have to be computed on the dump steps
+    m_system->enable_per_particle_eng();
+    m_system->request_energy(m_freq);
+    m_msg->msg(Messenger::WARNING,"XYZC file format output enabled per particle energy tracking. There fill be a substantial performance penalty (using slow STL maps).");
+  }
+  if (m_type == "vtp")
+  {
+    // VTP dumps per-particle pressure, so stress has to be accumulated on the dump steps
+    m_system->request_stress(m_freq);
+  }
   if (params.find("compress") != params.end())
   {
     m_msg->msg(Messenger::INFO,"Output data will be compressed.");
@@ -774,8 +786,6 @@ void Dump::dump_xyzc()
 {
   int N = m_system->get_group(m_group)->get_size();
   vector<int> particles = m_system->get_group(m_group)->get_particles();
-  m_system->enable_per_particle_eng();
-  m_msg->msg(Messenger::WARNING,"XYZC file format output enabled per particle energy tracking. There fill be a substantial performance penalty (using slow STL maps).");
   m_out << N << endl;
   if (m_params.find("potential") != m_params.end())
     m_out << "Generated by SAMoS code. Printing potential of type " << m_params["potential"] << " for each particle." << endl;
@@ -1073,7 +1083,13 @@ void Dump::dump_vtp(int step)
       types->InsertNextValue(pi.get_type());
       radii->InsertNextValue(pi.get_radius());
       a0->InsertNextValue(pi.A0);
-      press->InsertNextValue(pi.s_xx + pi.s_yy + pi.s_zz);
+      if (m_system->has_stress(particles[i]))
+      {
+        double* s = m_system->get_stress(particles[i]);
+        press->InsertNextValue(s[0] + s[4] + s[8]);
+      }
+      else
+        press->InsertNextValue(0.0);
       vel->InsertNextTuple(v);
       force->InsertNextTuple(f);
       dir->InsertNextTuple(n);
@@ -39,6 +39,7 @@
 #include "potential.hpp"
 #include "constrainer.hpp"
 #include "aligner.hpp" 
+#include "interaction_pipeline.hpp"
 #include "value.hpp"
 #include "parse_parameters.hpp"
 
@@ -46,6 +47,9 @@ using std::string;
 
 using boost::make_shared;
 
+//! Do not spawn threads for particle update loops shorter than this
+const int INTEGRATOR_PARALLEL_MIN = 1024;
+
 /*! Integrator class is the base class for handling different numerical 
  *  integrators for integrating equations of motion (e.g., NVE).
  *  This is an abstract class and its children will implement 
@@ -72,6 +76,7 @@ public:
                                                                                                                                                                    m_constrainer(cons),
                                                                                                                                                                    m_temp(temp)
   { 
+    m_interactions = make_shared<InteractionPipeline>(sys, pot, align, nlist);
     m_known_params.push_back("dt");
     m_known_params.push_back("group");
     m_known_params.push_back("temperature_control");
@@ -113,6 +118,9 @@ public:
   //! Propagate system for a time step
   virtual void integrate() = 0;
   
+  //! Report integrator statistics at the end of a run
+  virtual void report() { }
+  
   //! Check if there are no illegal parameters
   string params_ok(pairs_type& params)
   {
@@ -124,6 +132,24 @@ public:
 
 protected:
   
+  //! Rebuild neighbour list in the middle of a step if particles moved too far
+  void refresh_nlist()
+  {
+    if ((m_potential && m_potential->need_nlist()) || (m_align && m_align->need_nlist()))
+      if (m_nlist->need_update())
+        m_nlist->build();
+  }
+  
+  //! Compute forces and torques in the middle of a step (e.g., between substeps)
+  //! \param dt step size (used to phase in particles)
+  void recompute_forces(double dt)
+  {
+    this->refresh_nlist();
+    m_system->reset_forces();
+    m_system->reset_torques();
+    m_interactions->compute(dt);
+  }
+  
   SystemPtr m_system;            //!< Pointer to the System object
   MessengerPtr m_msg;            //!< Pointer to the messenger object
   PotentialPtr m_potential;      //!< Pointer to the interaction handler 
@@ -131,6 +157,7 @@ protected:
   NeighbourListPtr m_nlist;      //!< Pointer to the neighbour list object
   ConstrainerPtr m_constrainer;  //!< Pointer to the handler for constraints
   ValuePtr m_temp;               //!< Pointer to the handler of current value of temperature 
+  InteractionPipelinePtr m_interactions;  //!< Computes forces and torques (pair interactions share neighbour list traversal)
   double m_dt;                   //!< time step
   string m_group_name;           //!< Name of the group to apply this integrator to
   vector<string> m_known_params; //!< Lists all known parameters accepted by a given integrator
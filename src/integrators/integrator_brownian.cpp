@@ -38,44 +38,107 @@
  *  \f$ \eta_i(t) \f$ is the Gaussian white noise with zero mean and delta function 
  *  correlations, \f$ \left<\eta_i(t)\eta_j(t')\right> = 2\nu_r\delta_{ij}\delta\left(t-t'\right) \f$, with
  *  \f$ \nu_r \f$ being the rotational diffusion rate.
+ *  With adaptive step size, the step is covered by substeps chosen by StepController
+ *  and forces and torques are recomputed after each of them.
 **/
 void IntegratorBrownian::integrate()
 {
   int N = m_system->get_group(m_group_name)->get_size();
   double T = m_temp->get_val(m_system->get_run_step());
   double B = sqrt(2.0*m_mu*T);
-  double sqrt_dt = sqrt(m_dt);
-  double fd_x, fd_y, fd_z;                    // Deterministic part of the force
-  double fr_x = 0.0, fr_y = 0.0, fr_z = 0.0;  // Random part of the force
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
   
-  // reset forces and torques
-  m_system->reset_forces();
-  m_system->reset_torques();
-  
-  // If nematic, attempt to flip directors
+  // If nematic, attempt to flip directors (in parallel only if each particle has its own random numbers)
   if (m_nematic)
+  {
+    bool flipped = false;
+#pragma omp parallel for reduction(||:flipped) if (m_rng->counter_based() && N > INTEGRATOR_PARALLEL_MIN)
     for (int i = 0; i < N; i++)
     {
       int pi = particles[i];
       Particle& p = m_system->get_particle(pi);
-      if (m_rng->drnd() < m_tau)  // Flip direction n with probability m_tua (dt/tau, where tau is the parameter given in the input file).
+      RNGStream rng_flip = m_rng->stream(p.get_flag(), step, RNG::FLIP);
+      if (rng_flip.drnd() < m_tau)  // Flip direction n with probability m_tua (dt/tau, where tau is the parameter given in the input file).
       {
         p.nx = -p.nx;  p.ny = -p.ny;  p.nz = -p.nz;
         if (m_velocity)
         {
           p.vx = -p.vx;  p.vy = -p.vy;  p.vz = -p.vz;
         }
+        flipped = true;
       }
     }
+    if (flipped)
+      m_system->invalidate_forces();  // torques have to be recomputed with the flipped directors
+  }
   
-  // compute forces in the current configuration
-  if (m_potential)
-    m_potential->compute(m_dt);
-  // compute torques in the current configuration
-  if (m_align)
-    m_align->compute();
+  // generate noise for all particles at once
+  m_flags.resize(N);
+  for (int i = 0; i < N; i++)
+    m_flags[i] = m_system->get_particle(particles[i]).get_flag();
+  if (T > 0.0)
+    m_rng->fill_gaussian(m_noise_trans, 3, m_flags, step, RNG::TRANSLATION);
+  m_rng->fill_gaussian(m_noise_rot, 1, m_flags, step, RNG::ROTATION);
+  
+  // compute forces and torques in the configuration at the beginning of the step (shared by all integrators in this step)
+  m_interactions->compute_shared(m_dt);
+  if (!m_step->enabled())
+    this->move(m_dt, T, B);
+  else
+  {
+    // Noise over the whole step is split between substeps (translation and rotation for each particle)
+    int n = (T > 0.0) ? 4 : 1;
+    m_noise.resize(n*N);
+    for (int i = 0; i < N; i++)
+    {
+      if (T > 0.0)
+        for (int k = 0; k < 3; k++)
+          m_noise[n*i+k] = m_noise_trans[3*i+k];
+      m_noise[n*i+n-1] = m_noise_rot[i];
+    }
+    m_step->begin(m_rng, m_flags, step, n, m_noise);
+    while (!m_step->done())
+    {
+      double h = m_step->trial();
+      const vector<double>& dW = m_step->increments();
+      double inv_sqrt_h = 1.0/sqrt(h);
+      for (int i = 0; i < N; i++)
+      {
+        if (T > 0.0)
+          for (int k = 0; k < 3; k++)
+            m_noise_trans[3*i+k] = inv_sqrt_h*dW[n*i+k];
+        m_noise_rot[i] = inv_sqrt_h*dW[n*i+n-1];
+      }
+      if (m_step->accept(this->max_displacement(h, T, B)))
+      {
+        this->move(h, T, B);
+        if (!m_step->done())
+          this->recompute_forces(h);
+      }
+    }
+  }
+  // Update vertex mesh
+  m_system->update_mesh();
+}
+
+// Private methods
+
+/*! Moves particles and rotates their directors using forces and torques in the current configuration.
+ *  \param dt step size
+ *  \param T temperature
+ *  \param B magnitude of the translational noise
+ */
+void IntegratorBrownian::move(double dt, double T, double B)
+{
+  int N = m_system->get_group(m_group_name)->get_size();
+  double sqrt_dt = sqrt(dt);
+  double stoch_coeff = sqrt(m_nu*dt);
+  double fd_x, fd_y, fd_z;                    // Deterministic part of the force
+  double fr_x = 0.0, fr_y = 0.0, fr_z = 0.0;  // Random part of the force
+  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
   // iterate over all particles 
+#pragma omp parallel for private(fd_x,fd_y,fd_z,fr_x,fr_y,fr_z) if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -89,15 +152,15 @@ void IntegratorBrownian::integrate()
     p.vy = fd_y;
     p.vz = fd_z;
     // Update particle position according to the eq. (1a)
-    p.x += m_dt*fd_x;
-    p.y += m_dt*fd_y;
-    p.z += m_dt*fd_z;
+    p.x += dt*fd_x;
+    p.y += dt*fd_y;
+    p.z += dt*fd_z;
     // Check is non-zero T
     if (T > 0.0)
     {
-      fr_x = B*m_rng->gauss_rng(1.0);
-      fr_y = B*m_rng->gauss_rng(1.0);
-      fr_z = B*m_rng->gauss_rng(1.0);
+      fr_x = B*m_noise_trans[3*i];
+      fr_y = B*m_noise_trans[3*i+1];
+      fr_z = B*m_noise_trans[3*i+2];
       p.vx += fr_x; 
       p.vy += fr_y;
       p.vz += fr_z;  
@@ -105,20 +168,52 @@ void IntegratorBrownian::integrate()
       p.y += sqrt_dt*fr_y;
       p.z += sqrt_dt*fr_z;
     }
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    p.age += dt;
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
+  m_constrainer->project_torques(particles,m_torque);
+  m_dtheta.resize(N);
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
     // Update angular velocity
-    p.omega = m_mur*m_constrainer->project_torque(p);
-    //p.omega = m_dt*m_constraint->project_torque(p);
+    p.omega = m_mur*m_torque[i];
     // Change orientation of the director (in the tangent plane) according to eq. (1b)
-    double dtheta = m_dt*p.omega + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    //double dtheta = m_dt*m_constraint->project_torque(p) + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    m_constrainer->rotate_director(p,dtheta);
-    if (m_velocity)
-      m_constrainer->rotate_velocity(p,dtheta);  
-    //p.omega = dtheta*m_dt;
-    p.age += m_dt;
+    m_dtheta[i] = dt*p.omega + stoch_coeff*m_noise_rot[i];
   }
-  // Update vertex mesh
-  m_system->update_mesh();
+  m_constrainer->rotate_directors(particles,m_dtheta);
+  if (m_velocity)
+    m_constrainer->rotate_velocities(particles,m_dtheta);
+}
+
+/*! Computes displacements particles would have in a (sub)step before projecting them onto constraints.
+ *  \param dt step size
+ *  \param T temperature
+ *  \param B magnitude of the translational noise
+ *  \return largest displacement 
+ */
+double IntegratorBrownian::max_displacement(double dt, double T, double B)
+{
+  int N = m_system->get_group(m_group_name)->get_size();
+  double sqrt_dt = sqrt(dt);
+  double max_dr_sq = 0.0;
+  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+#pragma omp parallel for reduction(max:max_dr_sq) if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    double dx = dt*(m_v0*p.nx + m_mu*p.fx);
+    double dy = dt*(m_v0*p.ny + m_mu*p.fy);
+    double dz = dt*(m_v0*p.nz + m_mu*p.fz);
+    if (T > 0.0)
+    {
+      dx += sqrt_dt*B*m_noise_trans[3*i];
+      dy += sqrt_dt*B*m_noise_trans[3*i+1];
+      dz += sqrt_dt*B*m_noise_trans[3*i+2];
+    }
+    max_dr_sq = std::max(max_dr_sq, dx*dx + dy*dy + dz*dz);
+  }
+  return sqrt(max_dr_sq);
 }
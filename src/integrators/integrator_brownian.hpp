@@ -34,6 +34,7 @@
 
 #include "integrator.hpp"
 #include "rng.hpp"
+#include "step_controller.hpp"
 
 using std::sqrt;
 
@@ -59,9 +60,11 @@ public:
     m_known_params.push_back("mu");
     m_known_params.push_back("mur");
     m_known_params.push_back("seed");
+    m_known_params.push_back("counter_rng");
     m_known_params.push_back("nematic");
     m_known_params.push_back("tau");
     m_known_params.push_back("velocity_align");
+    StepController::add_known_params(m_known_params);
     string param_test = this->params_ok(param);
     if (param_test != "")
     {
@@ -113,18 +116,22 @@ public:
       m_mur = lexical_cast<double>(param["mur"]);
     }
     m_msg->write_config("integrator.brownian.mur",lexical_cast<string>(m_mur));
+    bool counter_rng = (param.find("counter_rng") != param.end());
     if (param.find("seed") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Brownian dynamics integrator. No random number generator seed specified. Using default 0.");
-      m_rng = make_shared<RNG>(0);
+      m_rng = make_shared<RNG>(0, counter_rng);
       m_msg->write_config("integrator.brownian.seed",lexical_cast<string>(0));
     }
     else
     {
       m_msg->msg(Messenger::INFO,"Brownian dynamics integrator. Setting random number generator seed to "+param["seed"]+".");
-      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]), counter_rng);
       m_msg->write_config("integrator.brownian.seed",param["seed"]);
     }
+    if (counter_rng)
+      m_msg->msg(Messenger::INFO,"Brownian dynamics integrator. Using counter-based random numbers for each particle.");
+    m_msg->write_config("integrator.brownian.counter_rng",lexical_cast<string>(counter_rng));
     if (param.find("nematic") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Brownian dynamics integrator. Assuming polar order parameter.");
@@ -156,13 +163,16 @@ public:
       m_msg->msg(Messenger::WARNING,"Brownian dynamics integrator. Assuming velocity alignment.");
       m_velocity = true;
     }
-    m_stoch_coeff = sqrt(m_nu*m_dt);
+    m_step = StepControllerPtr(new StepController(m_msg, param, "brownian", m_dt));
   }
   
   
   //! Propagate system for a time step
   void integrate();
   
+  //! Report accepted and rejected substeps
+  void report() { m_step->report(); }
+  
 private:
   
   RNGPtr  m_rng;          //!< Random number generator 
@@ -170,10 +180,22 @@ private:
   double  m_nu;           //!< Rotational diffusion 
   double  m_mu;           //!< Mobility 
   double  m_mur;          //!< Rotational mobility
-  double  m_stoch_coeff;  //!< Factor for the stochastic part of the equation of motion (\f$ = \nu \sqrt{dt} \f$)
   bool    m_nematic;      //!< If true; assume that the system is nematic, and the velocity will switch direction randomly
   double  m_tau;          //!< Time scale for the direction flip for nematic systems (flip with probability dt/tau)
   bool    m_velocity;     //!< If true, apply torque to velocity (this is used in simulations with velocity alignmant)
+  vector<int>    m_flags;        //!< Flags of particles in the group (identify random number streams)
+  vector<double> m_noise_trans;  //!< Translational noise for all particles in the current step
+  vector<double> m_noise_rot;    //!< Rotational noise for all particles in the current step
+  vector<double> m_torque;       //!< Torques projected onto the surface normal for all particles in the current step
+  vector<double> m_dtheta;       //!< Director rotation angles for all particles in the current step
+  StepControllerPtr m_step;      //!< Adaptive step size control
+  vector<double> m_noise;        //!< Translational and rotational noise for the whole step (adaptive step size)
+  
+  //! Move particles and rotate directors over a (sub)step 
+  void move(double, double, double);
+  
+  //! Largest displacement of a particle in a (sub)step 
+  double max_displacement(double, double, double);
   
 };
 
@@ -42,35 +42,48 @@ void IntegratorBrownianAlign::integrate()
 {
   int N = m_system->get_group(m_group_name)->get_size();
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
   
-  // reset torques
-  m_system->reset_torques();
-  
-  // If nematic, attempt to flip directors
+  // If nematic, attempt to flip directors (in parallel only if each particle has its own random numbers)
   if (m_nematic)
+  {
+    bool flipped = false;
+#pragma omp parallel for reduction(||:flipped) if (m_rng->counter_based() && N > INTEGRATOR_PARALLEL_MIN)
     for (int i = 0; i < N; i++)
     {
       int pi = particles[i];
       Particle& p = m_system->get_particle(pi);
-      if (m_rng->drnd() < m_tau)  // Flip direction n with probability m_tua (dt/tau, where tau is the parameter given in the input file).
+      RNGStream rng_flip = m_rng->stream(p.get_flag(), step, RNG::FLIP);
+      if (rng_flip.drnd() < m_tau)  // Flip direction n with probability m_tua (dt/tau, where tau is the parameter given in the input file).
       {
         p.nx = -p.nx;  p.ny = -p.ny;  p.nz = -p.nz;
+        flipped = true;
       }
     }
+    if (flipped)
+      m_system->invalidate_forces();  // torques have to be recomputed with the flipped directors
+  }
+  
+  // generate noise for all particles at once
+  m_flags.resize(N);
+  for (int i = 0; i < N; i++)
+    m_flags[i] = m_system->get_particle(particles[i]).get_flag();
+  m_rng->fill_gaussian(m_noise_rot, 1, m_flags, step, RNG::ROTATION);
   
-  // compute torques in the current configuration
-  if (m_align)
-    m_align->compute();
+  // compute forces and torques in the configuration at the beginning of the step (shared by all integrators in this step)
+  m_interactions->compute_shared(m_dt);
+  m_constrainer->project_torques(particles,m_torque);
+  m_dtheta.resize(N);
   // iterate over all particles 
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
     Particle& p = m_system->get_particle(pi);
     // Update angular velocity
-    p.omega = m_mur*m_constrainer->project_torque(p);
+    p.omega = m_mur*m_torque[i];
     // Change orientation of the director (in the tangent plane) according to eq. (1b)
-    double dtheta = m_dt*p.omega + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    //double dtheta = m_dt*m_constraint->project_torque(p) + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    m_constrainer->rotate_director(p,dtheta);
+    m_dtheta[i] = m_dt*p.omega + m_stoch_coeff*m_noise_rot[i];
   }
+  m_constrainer->rotate_directors(particles,m_dtheta);
 }
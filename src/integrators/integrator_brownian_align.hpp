@@ -57,6 +57,7 @@ public:
     m_known_params.push_back("nu");
     m_known_params.push_back("mur");
     m_known_params.push_back("seed");
+    m_known_params.push_back("counter_rng");
     m_known_params.push_back("nematic");
     m_known_params.push_back("tau");
     string param_test = this->params_ok(param);
@@ -87,18 +88,22 @@ public:
       m_mur = lexical_cast<double>(param["mur"]);
     }
     m_msg->write_config("integrator.brownian_align.mur",lexical_cast<string>(m_mur));
+    bool counter_rng = (param.find("counter_rng") != param.end());
     if (param.find("seed") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Brownian dynamics integrator for alignment. No random number generator seed specified. Using default 0.");
-      m_rng = make_shared<RNG>(0);
+      m_rng = make_shared<RNG>(0, counter_rng);
       m_msg->write_config("integrator.brownian_align.seed",lexical_cast<string>(0));
     }
     else
     {
       m_msg->msg(Messenger::INFO,"Brownian dynamics integrator for alignment. Setting random number generator seed to "+param["seed"]+".");
-      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]), counter_rng);
       m_msg->write_config("integrator.brownian_align.seed",param["seed"]);
     }
+    if (counter_rng)
+      m_msg->msg(Messenger::INFO,"Brownian dynamics integrator for alignment. Using counter-based random numbers for each particle.");
+    m_msg->write_config("integrator.brownian_align.counter_rng",lexical_cast<string>(counter_rng));
     if (param.find("nematic") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Brownian dynamics integrator for alignment. Assuming polar order parameter.");
@@ -136,6 +141,10 @@ private:
   double  m_stoch_coeff;  //!< Factor for the stochastic part of the equation of motion (\f$ = \nu \sqrt{dt} \f$)
   bool    m_nematic;      //!< If true; assume that the system is nematic, and the velocity will switch direction randomly
   double  m_tau;          //!< Time scale for the direction flip for nematic systems (flip with probability dt/tau)
+  vector<int>    m_flags;        //!< Flags of particles in the group (identify random number streams)
+  vector<double> m_noise_rot;    //!< Rotational noise for all particles in the current step
+  vector<double> m_torque;       //!< Torques projected onto the surface normal for all particles in the current step
+  vector<double> m_dtheta;       //!< Director rotation angles for all particles in the current step
   
 };
 
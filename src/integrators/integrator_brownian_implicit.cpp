@@ -0,0 +1,182 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_brownian_implicit.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of IntegratorBrownianImplicit class
+ */ 
+
+#include "integrator_brownian_implicit.hpp"
+
+/*! Integrates equation of motion in the over-damped limit using the linearly 
+ *  implicit Euler scheme. Random force is treated explicitly.
+ *  \note This integrator applies only to the particle position and does not implement activity.
+ *  In order to use activity, you should define, e.g. external self propulsion.  
+**/
+void IntegratorBrownianImplicit::integrate()
+{
+  int N = m_system->get_group(m_group_name)->get_size();
+  int Ntot = m_system->size();
+  double T = m_temp->get_val(m_system->get_run_step());
+  double B = sqrt(2.0*m_mu*T);
+  double sqrt_dt = sqrt(m_dt);
+  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  
+  // compute forces and torques in the configuration at the beginning of the step (shared by all integrators in this step)
+  m_interactions->compute_shared(m_dt);
+  // Hessian pattern follows the current mesh connectivity, which may change between steps 
+  m_H.build_pattern(m_system->get_mesh());
+  bool has_hessian = false;
+  if (m_H.size() == Ntot)
+    has_hessian = m_potential->add_hessian(m_H);
+  if (!has_hessian && !m_warned)
+  {
+    m_msg->msg(Messenger::WARNING,"Implicit Brownian dynamics integrator for particle position. None of the potentials provides Hessian. Integration reduces to explicit Euler scheme.");
+    m_warned = true;
+  }
+  // Set up right hand side
+  m_mask.assign(3*Ntot, 0.0);
+  m_b.assign(3*Ntot, 0.0);
+  m_eta.assign(3*Ntot, 0.0);
+  // generate noise for all particles at once
+  if (T > 0.0 && N > 0)
+  {
+    m_noise.resize(3*N);
+    m_rng->fill_gaussian(&m_noise[0], 3*N);
+  }
+  for (int i = 0; i < N; i++)
+  {
+    int pi = particles[i];
+    Particle& p = m_system->get_particle(pi);
+    m_mask[3*pi] = m_mask[3*pi+1] = m_mask[3*pi+2] = 1.0;
+    m_b[3*pi]   = m_dt*m_mu*p.fx;
+    m_b[3*pi+1] = m_dt*m_mu*p.fy;
+    m_b[3*pi+2] = m_dt*m_mu*p.fz;
+    // Check is non-zero T and if non-zero add stochastic part
+    if (T > 0.0)
+    {
+      m_eta[3*pi]   = B*m_noise[3*i];
+      m_eta[3*pi+1] = B*m_noise[3*i+1];
+      m_eta[3*pi+2] = B*m_noise[3*i+2];
+      m_b[3*pi]   += sqrt_dt*m_eta[3*pi];
+      m_b[3*pi+1] += sqrt_dt*m_eta[3*pi+1];
+      m_b[3*pi+2] += sqrt_dt*m_eta[3*pi+2];
+    }
+  }
+  // Solve for displacements
+  if (has_hessian)
+  {
+    m_H.diagonal(m_diag);
+    for (int k = 0; k < 3*Ntot; k++)
+      m_diag[k] = 1.0/(1.0 + m_mask[k]*m_mu*m_dt*m_diag[k]);
+    if (this->solve() < 0)
+      m_msg->msg(Messenger::WARNING,"Implicit Brownian dynamics integrator for particle position. Conjugate gradient solver did not converge in "+lexical_cast<string>(m_max_iter)+" iterations at time step "+lexical_cast<string>(m_system->get_run_step())+".");
+  }
+  else
+    m_x = m_b;
+  // Move particles
+  for (int i = 0; i < N; i++)
+  {
+    int pi = particles[i];
+    Particle& p = m_system->get_particle(pi);
+    // Update velocity (deterministic part is the average over the step)
+    p.vx = (m_x[3*pi]   - sqrt_dt*m_eta[3*pi])/m_dt   + m_eta[3*pi];
+    p.vy = (m_x[3*pi+1] - sqrt_dt*m_eta[3*pi+1])/m_dt + m_eta[3*pi+1];
+    p.vz = (m_x[3*pi+2] - sqrt_dt*m_eta[3*pi+2])/m_dt + m_eta[3*pi+2];
+    // Update particle position 
+    p.x += m_x[3*pi];
+    p.y += m_x[3*pi+1];
+    p.z += m_x[3*pi+2];
+    // Project everything back to the manifold
+    m_constrainer->enforce(p);
+    p.age += m_dt;
+  }
+  // Update vertex mesh
+  m_system->update_mesh();
+}
+
+/*! Applies \f$ I + \mu\delta t H \f$ to a vector. Rows of particles that are not in the 
+ *  group are left as identity, i.e. these particles do not move.
+ *  \param x input vector
+ *  \param y result
+ */
+void IntegratorBrownianImplicit::apply(const vector<double>& x, vector<double>& y)
+{
+  double c = m_mu*m_dt;
+  m_H.multiply(x, y);
+  for (unsigned int k = 0; k < x.size(); k++)
+    y[k] = x[k] + c*m_mask[k]*y[k];
+}
+
+/*! Solves \f$ \left(I + \mu\delta t H\right)\vec x = \vec b \f$ using conjugate gradient method
+ *  with Jacobi preconditioner. The explicit Euler step is used as the initial guess. 
+ *  The system matrix is symmetric positive definite as long as the Hessian is positive semi-definite.
+ *  \return number of iterations or -1 if the solver did not converge
+ */
+int IntegratorBrownianImplicit::solve()
+{
+  int n = m_b.size();
+  m_x = m_b;
+  m_r.resize(n);
+  m_z.resize(n);
+  this->apply(m_x, m_Ap);
+  double b_norm = 0.0, rz = 0.0;
+  for (int k = 0; k < n; k++)
+  {
+    m_r[k] = m_b[k] - m_Ap[k];
+    m_z[k] = m_diag[k]*m_r[k];
+    rz += m_r[k]*m_z[k];
+    b_norm += m_b[k]*m_b[k];
+  }
+  m_p = m_z;
+  double tol_sq = m_tol*m_tol*b_norm;
+  for (int iter = 0; iter <= m_max_iter; iter++)
+  {
+    double r_norm = 0.0;
+    for (int k = 0; k < n; k++)
+      r_norm += m_r[k]*m_r[k];
+    if (r_norm <= tol_sq)
+      return iter;
+    if (iter == m_max_iter)
+      break;
+    this->apply(m_p, m_Ap);
+    double pAp = 0.0;
+    for (int k = 0; k < n; k++)
+      pAp += m_p[k]*m_Ap[k];
+    double alpha = rz/pAp;
+    double rz_new = 0.0;
+    for (int k = 0; k < n; k++)
+    {
+      m_x[k] += alpha*m_p[k];
+      m_r[k] -= alpha*m_Ap[k];
+      m_z[k] = m_diag[k]*m_r[k];
+      rz_new += m_r[k]*m_z[k];
+    }
+    double beta = rz_new/rz;
+    rz = rz_new;
+    for (int k = 0; k < n; k++)
+      m_p[k] = m_z[k] + beta*m_p[k];
+  }
+  return -1;
+}
@@ -0,0 +1,161 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_brownian_implicit.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorBrownianImplicit class
+ */ 
+
+#ifndef __INTEGRATOR_BROWNIAN_IMPLICIT_H__
+#define __INTEGRATOR_BROWNIAN_IMPLICIT_H__
+
+#include <cmath>
+#include <vector>
+
+#include "integrator.hpp"
+#include "block_sparse_matrix.hpp"
+#include "rng.hpp"
+
+using std::sqrt;
+using std::vector;
+
+/*! IntegratorBrownianImplicit class implements linearly implicit (semi-implicit) Euler scheme 
+ *  for over-damped dynamics of particle positions, \f$ \dot{\vec r}_i = \mu\vec F_i + \vec\eta_i \f$.
+ *  The force is linearised around the configuration at the beginning of the step, which leads to 
+ *  \f$ \left(I + \mu\delta t H\right)\Delta\vec r = \mu\delta t\vec F + \sqrt{\delta t}\vec\eta \f$,
+ *  where \f$ H \f$ is the Hessian of the potential energy. The Hessian is assembled in a sparse 
+ *  form using mesh connectivity and the linear system is solved using (Jacobi) preconditioned 
+ *  conjugate gradient method. 
+ *  This is intended for stiff vertex model simulations, which allow for a much larger time step 
+ *  than with the explicit brownian_pos integrator. Only potentials that provide Hessians (currently
+ *  vertex-particle model) are treated implicitly. All other forces are treated explicitly.
+ *  Particles that do not belong to the group are kept fixed in the solve.
+ *  Particle director will not be integrated. 
+*/
+class IntegratorBrownianImplicit : public Integrator
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  IntegratorBrownianImplicit(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param) : Integrator(sys, msg, pot, align, nlist, cons, temp, param), m_warned(false)
+  { 
+    m_known_params.push_back("mu");
+    m_known_params.push_back("seed");
+    m_known_params.push_back("tol");
+    m_known_params.push_back("max_iter");
+    string param_test = this->params_ok(param);
+    if (param_test != "")
+    {
+      m_msg->msg(Messenger::ERROR,"Parameter \""+param_test+"\" is not a valid parameter for brownian_implicit integrator.");
+      throw runtime_error("Unknown parameter \""+param_test+"\" in brownian_implicit integrator.");
+    }
+    if (param.find("mu") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"Implicit Brownian dynamics integrator for particle position. Mobility not set. Using default value 1.");
+      m_mu = 1.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Implicit Brownian dynamics integrator for particle position. Setting mobility to "+param["mu"]+".");
+      m_mu = lexical_cast<double>(param["mu"]);
+    }
+    m_msg->write_config("integrator.brownian_implicit.mu",lexical_cast<string>(m_mu));
+    if (param.find("seed") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"Implicit Brownian dynamics integrator for particle position. No random number generator seed specified. Using default 0.");
+      m_rng = make_shared<RNG>(0);
+      m_msg->write_config("integrator.brownian_implicit.seed",lexical_cast<string>(0));
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Implicit Brownian dynamics integrator for particle position. Setting random number generator seed to "+param["seed"]+".");
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_msg->write_config("integrator.brownian_implicit.seed",param["seed"]);
+    }
+    if (param.find("tol") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"Implicit Brownian dynamics integrator for particle position. Relative tolerance of the linear solver not set. Using default value 1e-8.");
+      m_tol = 1e-8;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Implicit Brownian dynamics integrator for particle position. Setting relative tolerance of the linear solver to "+param["tol"]+".");
+      m_tol = lexical_cast<double>(param["tol"]);
+    }
+    m_msg->write_config("integrator.brownian_implicit.tol",lexical_cast<string>(m_tol));
+    if (param.find("max_iter") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"Implicit Brownian dynamics integrator for particle position. Maximum number of linear solver iterations not set. Using default value 200.");
+      m_max_iter = 200;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Implicit Brownian dynamics integrator for particle position. Setting maximum number of linear solver iterations to "+param["max_iter"]+".");
+      m_max_iter = lexical_cast<int>(param["max_iter"]);
+    }
+    m_msg->write_config("integrator.brownian_implicit.max_iter",lexical_cast<string>(m_max_iter));
+  }
+  
+  
+  //! Propagate system for a time step
+  void integrate();
+  
+private:
+  
+  RNGPtr  m_rng;              //!< Random number generator 
+  double  m_mu;               //!< Mobility 
+  double  m_tol;              //!< Relative tolerance of the conjugate gradient solver
+  int     m_max_iter;         //!< Maximum number of conjugate gradient iterations
+  bool    m_warned;           //!< True if the warning about missing Hessian has been issued 
+  BlockSparseMatrix m_H;      //!< Hessian of the potential energy
+  vector<double> m_mask;      //!< 1 for coordinates of particles in the group, 0 otherwise
+  vector<double> m_diag;      //!< Jacobi preconditioner (inverse diagonal of the system matrix)
+  vector<double> m_b;         //!< Right hand side of the linear system
+  vector<double> m_x;         //!< Solution (displacements)
+  vector<double> m_eta;       //!< Random part of the velocity
+  vector<double> m_noise;     //!< Normally distributed random numbers for all particles in the group
+  vector<double> m_r;         //!< Conjugate gradient residual
+  vector<double> m_z;         //!< Preconditioned residual
+  vector<double> m_p;         //!< Search direction
+  vector<double> m_Ap;        //!< System matrix applied to search direction
+  
+  //! Apply system matrix \f$ I + \mu\delta t H \f$ restricted to the group
+  void apply(const vector<double>&, vector<double>&);
+  
+  //! Solve the linear system using preconditioned conjugate gradient
+  int solve();
+  
+};
+
+typedef shared_ptr<IntegratorBrownianImplicit> IntegratorBrownianImplicitPtr;
+
+#endif
@@ -30,7 +30,8 @@
 #include "integrator_brownian_pos.hpp"
 
 /*! Integrates equation of motion in the over-damped limit using a first order 
- *  scheme. 
+ *  scheme. With adaptive step size, the step is covered by substeps chosen by 
+ *  StepController and forces are recomputed after each of them.
  *  \note This integrator applies only to the particle position and does not implement activity.
  *  In order to use activity, you should define, e.g. external self propulsion.  
 **/
@@ -39,17 +40,63 @@ void IntegratorBrownianPos::integrate()
   int N = m_system->get_group(m_group_name)->get_size();
   double T = m_temp->get_val(m_system->get_run_step());
   double B = sqrt(2.0*m_mu*T);
-  double sqrt_dt = sqrt(m_dt);
-  double fr_x = 0.0, fr_y = 0.0, fr_z = 0.0;  // Random part of the force
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
   
-  // reset forces 
-  m_system->reset_forces();
+  // generate noise for all particles at once
+  if (T > 0.0)
+  {
+    m_flags.resize(N);
+    for (int i = 0; i < N; i++)
+      m_flags[i] = m_system->get_particle(particles[i]).get_flag();
+    m_rng->fill_gaussian(m_noise_trans, 3, m_flags, step, RNG::TRANSLATION);
+  }
   
-  // compute forces in the current configuration
-  if (m_potential)
-    m_potential->compute(m_dt);
+  // compute forces and torques in the configuration at the beginning of the step (shared by all integrators in this step)
+  m_interactions->compute_shared(m_dt);
+  if (!m_step->enabled())
+    this->move(m_dt, T, B);
+  else
+  {
+    // Noise over the whole step is split between substeps
+    m_step->begin(m_rng, m_flags, step, (T > 0.0) ? 3 : 0, m_noise_trans);
+    while (!m_step->done())
+    {
+      double h = m_step->trial();
+      if (T > 0.0)
+      {
+        const vector<double>& dW = m_step->increments();
+        double inv_sqrt_h = 1.0/sqrt(h);
+        for (int i = 0; i < 3*N; i++)
+          m_noise_trans[i] = inv_sqrt_h*dW[i];
+      }
+      if (m_step->accept(this->max_displacement(h, T, B)))
+      {
+        this->move(h, T, B);
+        if (!m_step->done())
+          this->recompute_forces(h);
+      }
+    }
+  }
+  // Update vertex mesh
+  m_system->update_mesh();
+}
+
+// Private methods
+
+/*! Moves particles using forces in the current configuration.
+ *  \param dt step size
+ *  \param T temperature
+ *  \param B magnitude of the noise
+ */
+void IntegratorBrownianPos::move(double dt, double T, double B)
+{
+  int N = m_system->get_group(m_group_name)->get_size();
+  double sqrt_dt = sqrt(dt);
+  double fr_x = 0.0, fr_y = 0.0, fr_z = 0.0;  // Random part of the force
+  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
   // iterate over all particles 
+#pragma omp parallel for private(fr_x,fr_y,fr_z) if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -59,15 +106,15 @@ void IntegratorBrownianPos::integrate()
     p.vy = m_mu*p.fy;
     p.vz = m_mu*p.fz;
     // Update particle position 
-    p.x += m_dt*p.vx;
-    p.y += m_dt*p.vy;
-    p.z += m_dt*p.vz;
+    p.x += dt*p.vx;
+    p.y += dt*p.vy;
+    p.z += dt*p.vz;
     // Check is non-zero T and if non-zero add stochastic part
     if (T > 0.0)
     {
-      fr_x = B*m_rng->gauss_rng(1.0);
-      fr_y = B*m_rng->gauss_rng(1.0);
-      fr_z = B*m_rng->gauss_rng(1.0);
+      fr_x = B*m_noise_trans[3*i];
+      fr_y = B*m_noise_trans[3*i+1];
+      fr_z = B*m_noise_trans[3*i+2];
       p.vx += fr_x; 
       p.vy += fr_y;
       p.vz += fr_z;  
@@ -75,10 +122,36 @@ void IntegratorBrownianPos::integrate()
       p.y += sqrt_dt*fr_y;
       p.z += sqrt_dt*fr_z;
     }
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    p.age += m_dt;
+    p.age += dt;
   }
-  // Update vertex mesh
-  m_system->update_mesh();
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
+}
+
+/*! Computes displacements particles would have in a (sub)step before projecting them onto constraints.
+ *  \param dt step size
+ *  \param T temperature
+ *  \param B magnitude of the noise
+ *  \return largest displacement 
+ */
+double IntegratorBrownianPos::max_displacement(double dt, double T, double B)
+{
+  int N = m_system->get_group(m_group_name)->get_size();
+  double sqrt_dt = sqrt(dt);
+  double max_dr_sq = 0.0;
+  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+#pragma omp parallel for reduction(max:max_dr_sq) if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    double dx = dt*m_mu*p.fx, dy = dt*m_mu*p.fy, dz = dt*m_mu*p.fz;
+    if (T > 0.0)
+    {
+      dx += sqrt_dt*B*m_noise_trans[3*i];
+      dy += sqrt_dt*B*m_noise_trans[3*i+1];
+      dz += sqrt_dt*B*m_noise_trans[3*i+2];
+    }
+    max_dr_sq = std::max(max_dr_sq, dx*dx + dy*dy + dz*dz);
+  }
+  return sqrt(max_dr_sq);
 }
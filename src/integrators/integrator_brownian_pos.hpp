@@ -34,6 +34,7 @@
 
 #include "integrator.hpp"
 #include "rng.hpp"
+#include "step_controller.hpp"
 
 using std::sqrt;
 
@@ -57,6 +58,8 @@ public:
   { 
     m_known_params.push_back("mu");
     m_known_params.push_back("seed");
+    m_known_params.push_back("counter_rng");
+    StepController::add_known_params(m_known_params);
     string param_test = this->params_ok(param);
     if (param_test != "")
     {
@@ -74,28 +77,45 @@ public:
       m_mu = lexical_cast<double>(param["mu"]);
     }
     m_msg->write_config("integrator.brownian_pos.mu",lexical_cast<string>(m_mu));
+    bool counter_rng = (param.find("counter_rng") != param.end());
     if (param.find("seed") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Brownian dynamics integrator for particle position. No random number generator seed specified. Using default 0.");
-      m_rng = make_shared<RNG>(0);
+      m_rng = make_shared<RNG>(0, counter_rng);
       m_msg->write_config("integrator.brownian_pos.seed",lexical_cast<string>(0));
     }
     else
     {
       m_msg->msg(Messenger::INFO,"Brownian dynamics integrator for particle position. Setting random number generator seed to "+param["seed"]+".");
-      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]), counter_rng);
       m_msg->write_config("integrator.brownian_pos.seed",param["seed"]);
     }
+    if (counter_rng)
+      m_msg->msg(Messenger::INFO,"Brownian dynamics integrator for particle position. Using counter-based random numbers for each particle.");
+    m_msg->write_config("integrator.brownian_pos.counter_rng",lexical_cast<string>(counter_rng));
+    m_step = StepControllerPtr(new StepController(m_msg, param, "brownian_pos", m_dt));
   }
   
   
   //! Propagate system for a time step
   void integrate();
   
+  //! Report accepted and rejected substeps
+  void report() { m_step->report(); }
+  
 private:
   
   RNGPtr  m_rng;          //!< Random number generator 
   double  m_mu;           //!< Mobility 
+  vector<int>    m_flags;        //!< Flags of particles in the group (identify random number streams)
+  vector<double> m_noise_trans;  //!< Translational noise for all particles in the current step
+  StepControllerPtr m_step;      //!< Adaptive step size control
+  
+  //! Move particles over a (sub)step 
+  void move(double, double, double);
+  
+  //! Largest displacement of a particle in a (sub)step 
+  double max_displacement(double, double, double);
   
 };
 
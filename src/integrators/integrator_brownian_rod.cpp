@@ -41,10 +41,6 @@ void IntegratorBrownianRod::integrate()
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
   double R1, R2;
   
-  // reset forces and torques
-  m_system->reset_forces();
-  m_system->reset_torques();
-  
   // If nematic, attempt to flip directors
   if (m_nematic)
     for (int i = 0; i < N; i++)
@@ -54,15 +50,12 @@ void IntegratorBrownianRod::integrate()
       if (m_rng->drnd() < m_tau)  // Flip direction n with probability m_tua (dt/tau, where tau is the parameter given in the input file).
       {
         p.nx = -p.nx;  p.ny = -p.ny;  p.nz = -p.nz;
+        m_system->invalidate_forces();  // torques have to be recomputed with the flipped director
       }
     }
   
-  // compute forces in the current configuration
-  if (m_potential)
-    m_potential->compute(m_dt);
-  // compute torques in the current configuration
-  if (m_align)
-    m_align->compute();
+  // compute forces and torques in the configuration at the beginning of the step (shared by all integrators in this step)
+  m_interactions->compute_shared(m_dt);
   // iterate over all particles 
   for (int i = 0; i < N; i++)
   {
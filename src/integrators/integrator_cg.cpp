@@ -0,0 +1,86 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_cg.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of IntegratorCG class
+ */ 
+
+#include "integrator_cg.hpp"
+
+/*! Performs one conjugate gradient iteration, i.e. updates the search direction and does 
+ *  the line search along it.
+**/
+void IntegratorCG::integrate()
+{
+  if (!this->start_iteration())
+    return;
+  double E_old = m_energy;
+  int n = m_g.size();
+  bool has_history = (static_cast<int>(m_g_old.size()) == n && static_cast<int>(m_d.size()) == n);
+  double beta = 0.0;
+  if (has_history && m_since_restart < n)
+  {
+    double gg_old = this->dot(m_g_old, m_g_old);
+    if (gg_old > 0.0)
+      beta = max(0.0, (this->dot(m_g, m_g) - this->dot(m_g, m_g_old))/gg_old);
+  }
+  double dg;
+  if (beta > 0.0)
+  {
+    for (int k = 0; k < n; k++)
+      m_d[k] = -m_g[k] + beta*m_d[k];
+    dg = this->dot(m_g, m_d);
+    if (dg >= 0.0)
+      dg = this->steepest_descent();
+  }
+  else
+    dg = this->steepest_descent();
+  // Initial step such that the first order change of energy is the same as in the previous iteration
+  double step = 1.0;
+  if (has_history && m_step_old > 0.0)
+    step = m_step_old*m_dg_old/dg;
+  m_g_old = m_g;
+  double accepted = this->line_search(dg, step, CG_CURVATURE);
+  if (accepted == 0.0 && m_since_restart > 0)
+  {
+    dg = this->steepest_descent();
+    accepted = this->line_search(dg, step, CG_CURVATURE);
+  }
+  m_dg_old = dg;
+  m_step_old = accepted;
+  m_since_restart++;
+  this->finish_iteration(E_old, accepted);
+}
+
+/*! \return directional derivative of the energy along the new direction */
+double IntegratorCG::steepest_descent()
+{
+  int n = m_g.size();
+  m_d.resize(n);
+  for (int k = 0; k < n; k++)
+    m_d[k] = -m_g[k];
+  m_since_restart = 0;
+  return -this->dot(m_g, m_g);
+}
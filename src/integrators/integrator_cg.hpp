@@ -0,0 +1,95 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_cg.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorCG class
+ */ 
+
+#ifndef __INTEGRATOR_CG_H__
+#define __INTEGRATOR_CG_H__
+
+#include "integrator_minimiser.hpp"
+
+#define CG_CURVATURE 0.1     //!< Curvature condition parameter of the line search
+
+/*! IntegratorCG class handles energy minimisation using the nonlinear conjugate gradient
+ *  method with Polak-Ribiere update (with automatic restart, i.e., PR+). The method is restarted 
+ *  along the steepest descent direction if the conjugate direction is not a descent direction,
+ *  if the line search along it fails and after every 3N iterations. The initial line search 
+ *  step is estimated from the previous iteration.
+ *  \note No activity. Just minimisation. 
+*/
+class IntegratorCG : public IntegratorMinimiser
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  IntegratorCG(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param) : IntegratorMinimiser(sys, msg, pot, align, nlist, cons, temp, param, "CG"),
+                                                                                                                                                                      m_dg_old(0.0),
+                                                                                                                                                                      m_step_old(0.0),
+                                                                                                                                                                      m_since_restart(0)
+  { 
+    string param_test = this->params_ok(param);
+    if (param_test != "")
+    {
+      m_msg->msg(Messenger::ERROR,"Parameter \""+param_test+"\" is not a valid parameter for cg integrator.");
+      throw runtime_error("Unknown parameter \""+param_test+"\" in cg integrator.");
+    }
+  }
+  
+  //! Perform one iteration of the minimiser
+  void integrate();
+  
+protected:
+  
+  //! Discard previous gradient (next iteration goes along the steepest descent)
+  void reset_history()
+  {
+    m_g_old.clear();
+  }
+  
+private:
+  
+  vector<double> m_g_old;    //!< Gradient at the beginning of the previous iteration
+  double m_dg_old;           //!< Directional derivative along the previous search direction
+  double m_step_old;         //!< Previous accepted step
+  int m_since_restart;       //!< Number of iterations since the last restart
+  
+  //! Set search direction to steepest descent
+  double steepest_descent();
+  
+};
+
+typedef shared_ptr<IntegratorCG> IntegratorCGPtr;
+
+#endif
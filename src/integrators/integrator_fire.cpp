@@ -29,30 +29,82 @@
 
 #include "integrator_fire.hpp"
 
-/*! This is the FIRE minimiser.  
+/*! This is the FIRE 2.0 minimiser. Velocity Verlet variant, i.e. FIRE velocity mixing
+ *  is applied after the first half step for the velocity.  
 **/
 void IntegratorFIRE::integrate()
 {
   double P = 0.0;
-  double E; 
   double Fnorm = 0.0;
   double Vnorm = 0.0;
-  double vx, vy, vz;
-  double ax, ay, az;
 
   int N = m_system->get_group(m_group_name)->get_size();
   double sqrt_ndof = sqrt(3*N);
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
-  double dt_2 = 0.5*m_dt;
   
+  // Adapt step size and mixing parameter based on the forces at the beginning of the step
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    P += p.vx*p.fx + p.vy*p.fy + p.vz*p.fz;
+  }
+  if (P > 0.0)
+  {
+    m_last_neg++;
+    if (m_last_neg > m_N_min)
+    {
+      m_dt = min(m_dt*m_f_inc, m_dt_max);
+      m_alpha *= m_f_alpha;
+    }
+  }
+  else
+  {
+    m_last_neg = 0;
+    if (!(m_initial_delay && m_iter < m_N_min))
+    {
+      if (m_dt*m_f_dec >= m_dt_min)
+        m_dt *= m_f_dec;
+      m_alpha = m_alpha_init;
+    }
+    // Correct for overshooting by moving back half a step, and stop
+    for (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(particles[i]);
+      p.x -= 0.5*m_dt*p.vx;
+      p.y -= 0.5*m_dt*p.vy;
+      p.z -= 0.5*m_dt*p.vz;
+      m_constrainer->enforce(p);
+      p.vx = 0.0; p.vy = 0.0; p.vz = 0.0;
+    }
+  }
+  
+  double dt_2 = 0.5*m_dt;
   // Perform first half step for velocity
   for (int i = 0; i < N; i++)
   {
-    int pi = particles[i];
-    Particle& p = m_system->get_particle(pi);
+    Particle& p = m_system->get_particle(particles[i]);
     p.vx += dt_2*p.fx;
     p.vy += dt_2*p.fy;
     p.vz += dt_2*p.fz;
+    Fnorm += p.fx*p.fx + p.fy*p.fy + p.fz*p.fz;
+    Vnorm += p.vx*p.vx + p.vy*p.vy + p.vz*p.vz;
+  }
+  // Mix velocity with the force direction
+  if (Fnorm > 0.0)
+  {
+    double fact_1 = 1.0 - m_alpha;
+    double fact_2 = m_alpha * sqrt(Vnorm/Fnorm);
+    for (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(particles[i]);
+      p.vx = fact_1*p.vx + fact_2 * p.fx;
+      p.vy = fact_1*p.vy + fact_2 * p.fy;
+      p.vz = fact_1*p.vz + fact_2 * p.fz;
+    }
+  }
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
     // Update position
     p.x += m_dt*p.vx;
     p.y += m_dt*p.vy;
@@ -61,32 +113,32 @@ void IntegratorFIRE::integrate()
     m_constrainer->enforce(p);
     // Update angular velocity
     p.omega += dt_2*m_constrainer->project_torque(p);
-    double dtheta = m_dt*p.omega; //m_constraint->project_torque(p);
+    double dtheta = m_dt*p.omega; 
     m_constrainer->rotate_director(p,dtheta);
   }
 
   // reset forces and torques
   m_system->reset_forces();
   m_system->reset_torques();
-  // compute forces in the current configuration
-  if (m_potential)
-    m_potential->compute(m_dt);
-  // compute torques in the current configuration
-  if (m_align)
-    m_align->compute();
+  // Energy is needed only every m_energy_freq iterations and once forces are small enough 
+  // (progress is also reported only in iterations in which energy is evaluated)
+  bool check_energy = m_need_energy || ((m_iter+1) % m_energy_freq == 0);
+  if (check_energy)
+    m_system->set_compute_energy(true);
+  // compute forces and torques in the current configuration
+  m_interactions->compute(m_dt);
 
   // Perform second half step for velocity 
+  Fnorm = 0.0;
   for (int i = 0; i < N; i++)
   {
-    int pi = particles[i];
-    Particle& p = m_system->get_particle(pi);
+    Particle& p = m_system->get_particle(particles[i]);
+    // Only force components tangent to the constraint surface drive the minimisation
+    m_constrainer->project_tangent(p, p.fx, p.fy, p.fz);
     p.vx += dt_2*p.fx;
     p.vy += dt_2*p.fy;
     p.vz += dt_2*p.fz;
-    // Compute FIRE related quantities
-    P += p.vx*p.fx + p.vy*p.fy + p.vz*p.fz;
     Fnorm += p.fx*p.fx + p.fy*p.fy + p.fz*p.fz;
-    Vnorm += p.vx*p.vx + p.vy*p.vy + p.vz*p.vz;
     // Project everything back to the manifold
     m_constrainer->enforce(p);
     // Update angular velocity
@@ -94,55 +146,19 @@ void IntegratorFIRE::integrate()
   }
   // Update vertex mesh
   m_system->update_mesh();
+  m_iter++;
 
-  Fnorm = sqrt(Fnorm);
-  Vnorm = sqrt(Vnorm);  
-
-  E = m_potential->compute_potential_energy();
-  cout << "E = " << E << "  Fnorm  = " << Fnorm/sqrt_ndof << "  Vnorm = " << Vnorm << endl;
-
-  if (Fnorm/sqrt_ndof < m_F_tol && fabs(E - m_old_energy) < m_E_tol)
-  {
-    m_converged = true;
-    m_msg->msg(Messenger::INFO,"FIRE minimisation converged.");
+  double F_rms = sqrt(Fnorm)/sqrt_ndof;
+  m_need_energy = (F_rms < m_F_tol);
+  if (!check_energy)
     return;
-  }
-  
-  double inv_Fnorm = 1.0/Fnorm;
-  double fact_1 = 1.0 - m_alpha;
-  double fact_2 = m_alpha * inv_Fnorm * Vnorm;
-  for (int i = 0; i < N; i++)
-  {
-    int pi = particles[i];
-    Particle& p = m_system->get_particle(pi);
-    p.vx = fact_1*p.vx + fact_2 * p.fx;
-    p.vy = fact_1*p.vy + fact_2 * p.fy;
-    p.vz = fact_1*p.vz + fact_2 * p.fz;
-  }
-  
-  if (P > 0.0)
-  {
-    m_last_neg++;
-    if (m_last_neg > m_N_min)
-    {
-      m_dt = min(m_dt*m_f_inc, m_dt_max);
-      m_alpha *= m_f_alpha;
-    }
-  }
-  else
-  {
-    m_dt *= m_f_dec;
-    m_alpha = m_alpha_init;
-    m_last_neg = 0;
-    for (int i = 0; i < N; i++)
-    {
-      int pi = particles[i];
-      Particle& p = m_system->get_particle(pi);
-      p.vx = 0.0; p.vy = 0.0; p.vz = 0.0;
-    }
-  }
-  
-  m_converged = false;
+  double E = m_potential->compute_potential_energy();
+  bool converged = (F_rms < m_F_tol && fabs(E - m_old_energy) < m_E_tol);
+  if (converged && !m_converged)
+    m_msg->msg(Messenger::INFO,"FIRE minimisation converged after "+lexical_cast<string>(m_iter)+" iterations. Energy = "+lexical_cast<string>(E)+". RMS force = "+lexical_cast<string>(F_rms)+".");
+  else if (!converged && m_log_freq > 0 && m_iter % m_log_freq == 0)
+    m_msg->msg(Messenger::INFO,"FIRE minimiser iteration "+lexical_cast<string>(m_iter)+". Energy = "+lexical_cast<string>(E)+". RMS force = "+lexical_cast<string>(F_rms)+". Step size = "+lexical_cast<string>(m_dt)+".");
+  m_converged = converged;
   m_old_energy = E;
 
 }
@@ -40,6 +40,12 @@ using std::fabs;
 using std::min;
 
 /*! IntegratorFIRE class handles FIRE minimization. 
+ *  Implements FIRE 2.0 variant (Guenole, et al., Comp. Mat. Sci. 175, 109584 (2020)). Compared to the 
+ *  original FIRE, step size is never reduced below dt_min, after a step with \f$ P = \vec F\cdot\vec v \le 0 \f$ 
+ *  particles are moved back by half of the step before velocities are set to zero, and, optionally 
+ *  (initial_delay), step size is not reduced during the first min_neg_steps iterations. 
+ *  Total energy is needed only for the convergence test, and it is evaluated every energy_freq iterations
+ *  (and in every iteration once the force criterion is satisfied).
  *  \note No activity. Just minimization. 
 */
 class IntegratorFIRE : public Integrator
@@ -58,7 +64,9 @@ public:
   IntegratorFIRE(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param) : Integrator(sys, msg, pot, align, nlist, cons, temp, param),
                                                                                                                                                                         m_converged(false),
                                                                                                                                                                         m_old_energy(1e15),
-                                                                                                                                                                        m_last_neg(0)
+                                                                                                                                                                        m_last_neg(0),
+                                                                                                                                                                        m_iter(0),
+                                                                                                                                                                        m_need_energy(false)
   { 
     m_msg->write_config("integrator.fire","");
     if (param.find("alpha") != param.end())
@@ -150,6 +158,52 @@ public:
       m_N_min = 5;
     }
     m_msg->write_config("integrator.FIRE.N_min",lexical_cast<string>(m_N_min));
+    if (param.find("dt_min") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"FIRE integrator minimum step size dt_min set to "+param["dt_min"]+".");
+      m_dt_min = lexical_cast<double>(param["dt_min"]);
+    }
+    else
+    {
+      m_dt_min = 0.02*m_dt;
+      m_msg->msg(Messenger::WARNING,"FIRE integrator minimum step size dt_min not set. Using default value of 0.02*dt = "+lexical_cast<string>(m_dt_min)+".");
+    }
+    m_msg->write_config("integrator.FIRE.dt_min",lexical_cast<string>(m_dt_min));
+    if (param.find("initial_delay") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"FIRE integrator will not decrease step size during the first "+lexical_cast<string>(m_N_min)+" iterations.");
+      m_initial_delay = true;
+    }
+    else
+      m_initial_delay = false;
+    m_msg->write_config("integrator.FIRE.initial_delay",lexical_cast<string>(m_initial_delay));
+    if (param.find("energy_freq") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"FIRE integrator will evaluate total energy every "+param["energy_freq"]+" iterations.");
+      m_energy_freq = lexical_cast<int>(param["energy_freq"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,"FIRE integrator energy evaluation frequency energy_freq not set. Using default value of 10 iterations.");
+      m_energy_freq = 10;
+    }
+    if (m_energy_freq < 1)
+    {
+      m_msg->msg(Messenger::ERROR,"FIRE integrator energy evaluation frequency energy_freq has to be positive.");
+      throw runtime_error("Invalid energy_freq in FIRE integrator.");
+    }
+    m_msg->write_config("integrator.FIRE.energy_freq",lexical_cast<string>(m_energy_freq));
+    if (param.find("log_freq") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"FIRE integrator reports progress every "+param["log_freq"]+" iterations.");
+      m_log_freq = lexical_cast<int>(param["log_freq"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,"FIRE integrator progress report frequency log_freq not set. Using default value of 100 iterations.");
+      m_log_freq = 100;
+    }
+    m_msg->write_config("integrator.FIRE.log_freq",lexical_cast<string>(m_log_freq));
     
   }
   
@@ -166,10 +220,16 @@ private:
   double m_f_dec;                                   //!< Decrease factor for m_dt
   double m_alpha_init;                              //!< Initial value for m_alpha
   double m_f_alpha;                                 //!< Decrease alpha by this much 
-  int    m_last_neg;                                //!< Last time (in terms of step number when force.velocity was negative
+  int    m_last_neg;                                //!< Number of iterations since force.velocity was last negative
   double m_old_energy;                              //!< Old value of energy
   bool   m_converged;                               //!< Flag which tests if the method has converged
   double m_dt_max;                                  //!< Maximum time step
+  double m_dt_min;                                  //!< Minimum time step
+  bool   m_initial_delay;                           //!< If true, do not decrease time step during the first m_N_min iterations
+  int    m_energy_freq;                             //!< Evaluate total energy every so many iterations
+  int    m_log_freq;                                //!< Report progress every so many iterations (0 for never)
+  int    m_iter;                                    //!< Number of iterations so far
+  bool   m_need_energy;                             //!< If true, total energy is evaluated in the next iteration
 
   
 };
@@ -29,20 +29,48 @@
 
 #include "integrator_langevin.hpp"
 
+/*! With adaptive step size, the step is covered by substeps chosen by StepController. 
+ *  Substep size is determined from velocities and forces at its beginning, before the noise 
+ *  is drawn, so fresh random numbers are used in each substep.
+**/
 void IntegratorLangevin::integrate()
+{
+  if (!m_step->enabled())
+    this->advance(m_dt, 0);
+  else
+  {
+    m_step->begin();
+    while (!m_step->done())
+    {
+      double h = m_step->trial();
+      int k = m_step->substep();
+      if (m_step->accept(this->max_displacement(h)))
+      {
+        if (k > 0)
+          this->refresh_nlist();
+        this->advance(h, k);
+      }
+    }
+  }
+}
+
+// Private methods
+
+/*! \param dt step size
+ *  \param draw index of the substep (selects random numbers)
+ */
+void IntegratorLangevin::advance(double dt, int draw)
 {
   if (m_method == "baoab")
-    this->integrate_baoab();
+    this->integrate_baoab(dt, draw);
   else if (m_method == "spv")
-    this->integrate_spv();
+    this->integrate_spv(dt, draw);
   else if (m_method == "bbk")
-    this->integrate_bbk();
+    this->integrate_bbk(dt, draw);
   else
     throw runtime_error("Unknown integration method");
 }
 
-// Private methods
-
 /*! Integrates stochastic equations of motion using Langevin dynamics.
  *  The implementation is based on the BAOAB algorithm in the book
  *  "Molecular Dynamics: With Deterministic and Stochastic Numerical Methods" 
@@ -50,17 +78,30 @@ void IntegratorLangevin::integrate()
  *  Interdisciplinary Applied Mathematics, Vol. 39, Springer (page 271)
  *  \note This integrator applies only to the particle position and does not implement activity.
  *  In order to use activity, you should define, e.g. external self propulsion.  
+ *  \param dt step size
+ *  \param draw index of the substep (selects random numbers)
 **/
-void IntegratorLangevin::integrate_baoab()
+void IntegratorLangevin::integrate_baoab(double dt, int draw)
 {
   int N = m_system->get_group(m_group_name)->get_size();
   double T = m_temp->get_val(m_system->get_run_step());
-  double B = sqrt(T*(1.0-exp(-2.0*m_gamma*m_dt)));
-  double exp_dt = exp(-m_gamma*m_dt);
-  double dt2 = 0.5*m_dt;
+  double B = sqrt(T*(1.0-exp(-2.0*m_gamma*dt)));
+  double exp_dt = exp(-m_gamma*dt);
+  double dt2 = 0.5*dt;
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
+  
+  // generate noise for all particles at once
+  if (B != 0.0)
+  {
+    m_flags.resize(N);
+    for (int i = 0; i < N; i++)
+      m_flags[i] = m_system->get_particle(particles[i]).get_flag();
+    m_rng->fill_gaussian(m_noise, 3, m_flags, step, RNG::TRANSLATION, draw);
+  }
 
   // BAOA steps
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -74,8 +115,13 @@ void IntegratorLangevin::integrate_baoab()
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
     p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
     // O step
     p.vx *= exp_dt;
     p.vy *= exp_dt;
@@ -83,26 +129,27 @@ void IntegratorLangevin::integrate_baoab()
     if (B != 0.0)
     {
       double stoch_fact = B/sqrt(p.mass);
-      p.vx += stoch_fact*m_rng->gauss_rng(1.0);
-      p.vy += stoch_fact*m_rng->gauss_rng(1.0);
-      p.vz += stoch_fact*m_rng->gauss_rng(1.0);
+      p.vx += stoch_fact*m_noise[3*i];
+      p.vy += stoch_fact*m_noise[3*i+1];
+      p.vz += stoch_fact*m_noise[3*i+2];
     }
     // A step
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
     p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
   
   // reset forces 
   m_system->reset_forces();
   
   // compute forces in the current configuration
   if (m_potential)
-    m_potential->compute(m_dt);
+    m_potential->compute(dt);
   
   // B step
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -111,7 +158,7 @@ void IntegratorLangevin::integrate_baoab()
     p.vx += fact*p.fx;
     p.vy += fact*p.fy;
     p.vz += fact*p.fz;
-    p.age += m_dt;
+    p.age += dt;
   }
   // Update vertex mesh
   m_system->update_mesh();
@@ -124,20 +171,33 @@ void IntegratorLangevin::integrate_baoab()
  *  Interdisciplinary Applied Mathematics, Vol. 39, Springer (page 272)
  *  \note This integrator applies only to the particle position and does not implement activity.
  *  In order to use activity, you should define, e.g. external self propulsion.  
+ *  \param dt step size
+ *  \param draw index of the substep (selects random numbers)
 **/
-void IntegratorLangevin::integrate_spv()
+void IntegratorLangevin::integrate_spv(double dt, int draw)
 {
   int N = m_system->get_group(m_group_name)->get_size();
   double T = m_temp->get_val(m_system->get_run_step());
-  double zeta = sqrt(T*(1.0-exp(-2.0*m_gamma*m_dt)));
+  double zeta = sqrt(T*(1.0-exp(-2.0*m_gamma*dt)));
   double eta;
   if (m_gamma == 0.0) eta = 0.0;
-  else eta = (1.0-exp(-m_dt*m_gamma))/m_gamma;
-  double exp_dt = exp(-m_dt*m_gamma);
-  double dt2 = 0.5*m_dt;
+  else eta = (1.0-exp(-dt*m_gamma))/m_gamma;
+  double exp_dt = exp(-dt*m_gamma);
+  double dt2 = 0.5*dt;
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
+  
+  // generate noise for all particles at once
+  if (zeta != 0.0)
+  {
+    m_flags.resize(N);
+    for (int i = 0; i < N; i++)
+      m_flags[i] = m_system->get_particle(particles[i]).get_flag();
+    m_rng->fill_gaussian(m_noise, 3, m_flags, step, RNG::TRANSLATION, draw);
+  }
   
   // Step 1
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -145,18 +205,19 @@ void IntegratorLangevin::integrate_spv()
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
     p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
 
   // reset forces 
   m_system->reset_forces();
   
   // compute forces in the current configuration
   if (m_potential)
-    m_potential->compute(m_dt);
+    m_potential->compute(dt);
 
   // Steps 2 and 3
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -168,18 +229,18 @@ void IntegratorLangevin::integrate_spv()
     if (zeta != 0.0)
     {
       double stoch_fact = zeta/sqrt(p.mass);
-      p.vx += stoch_fact*m_rng->gauss_rng(1.0);
-      p.vy += stoch_fact*m_rng->gauss_rng(1.0);
-      p.vz += stoch_fact*m_rng->gauss_rng(1.0);
+      p.vx += stoch_fact*m_noise[3*i];
+      p.vy += stoch_fact*m_noise[3*i+1];
+      p.vz += stoch_fact*m_noise[3*i+2];
     }
     // Step 3
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
     p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    p.age += m_dt;
+    p.age += dt;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
 }
 
 /*! Integrates stochastic equations of motion using Langevin dynamics.
@@ -189,18 +250,22 @@ void IntegratorLangevin::integrate_spv()
  *  Interdisciplinary Applied Mathematics, Vol. 39, Springer (page 273)
  *  \note This integrator applies only to the particle position and does not implement activity.
  *  In order to use activity, you should define, e.g. external self propulsion.  
+ *  \param dt step size
+ *  \param draw index of the substep (selects random numbers)
 **/
-void IntegratorLangevin::integrate_bbk()
+void IntegratorLangevin::integrate_bbk(double dt, int draw)
 {
   int N = m_system->get_group(m_group_name)->get_size();
   double T = m_temp->get_val(m_system->get_run_step());
-  double B = sqrt(2.0*T*m_dt*m_gamma);
-  double dt2 = 0.5*m_dt;
+  double B = sqrt(2.0*T*dt*m_gamma);
+  double dt2 = 0.5*dt;
   double one_m_dt2 = 1.0 - m_gamma*dt2;
   double one_div_one_p_dt2 = 1.0/(1.0 + m_gamma*dt2);
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
   
   // Steps 1 and 2
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -216,20 +281,30 @@ void IntegratorLangevin::integrate_bbk()
       p.vy += stoch_fact*m_Ry[i];
       p.vz += stoch_fact*m_Rz[i];
     }
-    p.x += m_dt*p.vx;
-    p.y += m_dt*p.vy;
-    p.z += m_dt*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    p.x += dt*p.vx;
+    p.y += dt*p.vy;
+    p.z += dt*p.vz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
 
   // reset forces 
   m_system->reset_forces();
   
   // compute forces in the current configuration
   if (m_potential)
-    m_potential->compute(m_dt);
+    m_potential->compute(dt);
+  
+  // generate noise for all particles at once (it is also used in the first half of the next step)
+  if (B != 0.0)
+  {
+    m_flags.resize(N);
+    for (int i = 0; i < N; i++)
+      m_flags[i] = m_system->get_particle(particles[i]).get_flag();
+    m_rng->fill_gaussian(m_noise, 3, m_flags, step, RNG::TRANSLATION, draw);
+  }
 
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -241,13 +316,36 @@ void IntegratorLangevin::integrate_bbk()
     if (B != 0.0)
     {
       double stoch_fact = 0.5*B*one_div_one_p_dt2/sqrt(p.mass);
-      m_Rx[i] = m_rng->gauss_rng(1.0);
-      m_Ry[i] = m_rng->gauss_rng(1.0);
-      m_Rz[i] = m_rng->gauss_rng(1.0);
+      m_Rx[i] = m_noise[3*i];
+      m_Ry[i] = m_noise[3*i+1];
+      m_Rz[i] = m_noise[3*i+2];
       p.vx += stoch_fact*m_Rx[i];
       p.vy += stoch_fact*m_Ry[i];
       p.vz += stoch_fact*m_Rz[i];
-      p.age += m_dt;
+      p.age += dt;
     }
   }
 }
+
+/*! Displacement is estimated as \f$ \delta t\left|\vec v + \frac{\delta t}{2m}\vec F\right| \f$ using velocities and 
+ *  forces at the beginning of the (sub)step. Noise contributes to it only at higher order in \f$ \delta t \f$. 
+ *  \param dt step size
+ *  \return largest displacement 
+ */
+double IntegratorLangevin::max_displacement(double dt)
+{
+  int N = m_system->get_group(m_group_name)->get_size();
+  double max_dr_sq = 0.0;
+  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+#pragma omp parallel for reduction(max:max_dr_sq) if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    double fact = 0.5*dt/p.mass;
+    double dx = dt*(p.vx + fact*p.fx);
+    double dy = dt*(p.vy + fact*p.fy);
+    double dz = dt*(p.vz + fact*p.fz);
+    max_dr_sq = std::max(max_dr_sq, dx*dx + dy*dy + dz*dz);
+  }
+  return sqrt(max_dr_sq);
+}
@@ -38,6 +38,7 @@
 
 #include "integrator.hpp"
 #include "rng.hpp"
+#include "step_controller.hpp"
 
 using std::sqrt;
 using std::exp;
@@ -66,7 +67,9 @@ public:
   { 
     m_known_params.push_back("gamma");
     m_known_params.push_back("seed");
+    m_known_params.push_back("counter_rng");
     m_known_params.push_back("method");
+    StepController::add_known_params(m_known_params);
     string param_test = this->params_ok(param);
     if (param_test != "")
     {
@@ -84,18 +87,22 @@ public:
       m_gamma = lexical_cast<double>(param["gamma"]);
     }
     m_msg->write_config("integrator.langevin.gamma",lexical_cast<string>(m_gamma));
+    bool counter_rng = (param.find("counter_rng") != param.end());
     if (param.find("seed") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Langevin dynamics integrator for particle position. No random number generator seed specified. Using default 0.");
-      m_rng = make_shared<RNG>(0);
+      m_rng = make_shared<RNG>(0, counter_rng);
       m_msg->write_config("integrator.langevin.seed",lexical_cast<string>(0));
     }
     else
     {
       m_msg->msg(Messenger::INFO,"Langevin dynamics integrator for particle position. Setting random number generator seed to "+param["seed"]+".");
-      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]), counter_rng);
       m_msg->write_config("integrator.langevin.seed",param["seed"]);
     }
+    if (counter_rng)
+      m_msg->msg(Messenger::INFO,"Langevin dynamics integrator for particle position. Using counter-based random numbers for each particle.");
+    m_msg->write_config("integrator.langevin.counter_rng",lexical_cast<string>(counter_rng));
     if (param.find("method") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Langevin dynamics integrator for particle position. No integration method specified. Using default BAOAB.");
@@ -117,6 +124,7 @@ public:
       }
     }
     m_msg->write_config("integrator.langevin.method",m_method);
+    m_step = StepControllerPtr(new StepController(m_msg, param, "langevin", m_dt));
   }
 
   virtual ~IntegratorLangevin()
@@ -127,6 +135,9 @@ public:
   //! Propagate system for a time step
   void integrate();
   
+  //! Report accepted and rejected substeps
+  void report() { m_step->report(); }
+  
 private:
   
   RNGPtr  m_rng;             //!< Random number generator 
@@ -135,15 +146,24 @@ private:
   vector<double>  m_Rx;      //!< Normally distributed random numbers for BBK integrator
   vector<double>  m_Ry;      //!< Normally distributed random numbers for BBK integrator
   vector<double>  m_Rz;      //!< Normally distributed random numbers for BBK integrator
+  vector<int>     m_flags;   //!< Flags of particles in the group (identify random number streams)
+  vector<double>  m_noise;   //!< Normally distributed random numbers for all particles in the current step
+  StepControllerPtr m_step;  //!< Adaptive step size control
+
+  //! Integrate over a (sub)step using the selected method
+  void advance(double, int);
 
   //! Integrate using BAOAB method (defualt)
-  void integrate_baoab();
+  void integrate_baoab(double, int);
 
   //! Integrate using SPV method
-  void integrate_spv();
+  void integrate_spv(double, int);
 
   //! Integrate using BBK method
-  void integrate_bbk();
+  void integrate_bbk(double, int);
+
+  //! Largest free-flight displacement of a particle in a (sub)step
+  double max_displacement(double);
 
 
 };
@@ -0,0 +1,111 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_lbfgs.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of IntegratorLBFGS class
+ */ 
+
+#include "integrator_lbfgs.hpp"
+
+/*! Performs one L-BFGS iteration, i.e. computes the search direction and does 
+ *  the line search along it.
+**/
+void IntegratorLBFGS::integrate()
+{
+  if (!this->start_iteration())
+    return;
+  double E_old = m_energy;
+  this->compute_direction();
+  double dg = this->dot(m_g, m_d);
+  if (dg >= 0.0)
+  {
+    this->reset_history();
+    this->compute_direction();
+    dg = this->dot(m_g, m_d);
+  }
+  m_g_old = m_g;
+  double step = this->line_search(dg, 1.0, LBFGS_CURVATURE);
+  if (step == 0.0 && m_s.size() > 0)
+  {
+    // Try again along the steepest descent direction
+    this->reset_history();
+    this->compute_direction();
+    dg = this->dot(m_g, m_d);
+    step = this->line_search(dg, 1.0, LBFGS_CURVATURE);
+  }
+  if (step > 0.0)
+  {
+    int n = m_g.size();
+    vector<double> s(n), y(n);
+    for (int k = 0; k < n; k++)
+    {
+      s[k] = step*m_d[k];
+      y[k] = m_g[k] - m_g_old[k];
+    }
+    double sy = this->dot(s,y);
+    if (sy > 1e-12*sqrt(this->dot(s,s)*this->dot(y,y)))
+    {
+      m_s.push_back(s);
+      m_y.push_back(y);
+      m_rho.push_back(1.0/sy);
+      if (static_cast<int>(m_s.size()) > m_memory)
+      {
+        m_s.erase(m_s.begin());
+        m_y.erase(m_y.begin());
+        m_rho.erase(m_rho.begin());
+      }
+    }
+  }
+  this->finish_iteration(E_old, step);
+}
+
+/*! Applies the L-BFGS approximation of the inverse Hessian to the gradient. Initial 
+ *  inverse Hessian is scaled by \f$ \vec s\cdot\vec y/\vec y\cdot\vec y \f$ of the last stored pair. 
+ *  Without stored pairs, this is the steepest descent direction.
+ */
+void IntegratorLBFGS::compute_direction()
+{
+  int n = m_g.size();
+  int m = m_s.size();
+  vector<double> alpha(m);
+  m_d = m_g;
+  for (int j = m-1; j >= 0; j--)
+  {
+    alpha[j] = m_rho[j]*this->dot(m_s[j], m_d);
+    for (int k = 0; k < n; k++)
+      m_d[k] -= alpha[j]*m_y[j][k];
+  }
+  double gamma = (m > 0) ? 1.0/(m_rho[m-1]*this->dot(m_y[m-1], m_y[m-1])) : 1.0;
+  for (int k = 0; k < n; k++)
+    m_d[k] *= gamma;
+  for (int j = 0; j < m; j++)
+  {
+    double beta = m_rho[j]*this->dot(m_y[j], m_d);
+    for (int k = 0; k < n; k++)
+      m_d[k] += (alpha[j] - beta)*m_s[j][k];
+  }
+  for (int k = 0; k < n; k++)
+    m_d[k] = -m_d[k];
+}
@@ -0,0 +1,108 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_lbfgs.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorLBFGS class
+ */ 
+
+#ifndef __INTEGRATOR_LBFGS_H__
+#define __INTEGRATOR_LBFGS_H__
+
+#include "integrator_minimiser.hpp"
+
+#define LBFGS_CURVATURE 0.9  //!< Curvature condition parameter of the line search
+
+/*! IntegratorLBFGS class handles energy minimisation using the limited memory 
+ *  Broyden-Fletcher-Goldfarb-Shanno (L-BFGS) method. Inverse Hessian is approximated 
+ *  from the last few position and gradient changes and applied using the standard 
+ *  two-loop recursion. Pairs that violate the curvature condition are discarded. 
+ *  If the search direction is not a descent direction or the line search fails, 
+ *  the history is discarded and the steepest descent direction is used.
+ *  \note No activity. Just minimisation. 
+*/
+class IntegratorLBFGS : public IntegratorMinimiser
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  IntegratorLBFGS(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param) : IntegratorMinimiser(sys, msg, pot, align, nlist, cons, temp, param, "L-BFGS")
+  { 
+    m_known_params.push_back("memory");
+    string param_test = this->params_ok(param);
+    if (param_test != "")
+    {
+      m_msg->msg(Messenger::ERROR,"Parameter \""+param_test+"\" is not a valid parameter for lbfgs integrator.");
+      throw runtime_error("Unknown parameter \""+param_test+"\" in lbfgs integrator.");
+    }
+    if (param.find("memory") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"L-BFGS minimiser. Number of stored correction pairs set to "+param["memory"]+".");
+      m_memory = lexical_cast<int>(param["memory"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,"L-BFGS minimiser. Number of stored correction pairs not set. Using default value of 10.");
+      m_memory = 10;
+    }
+    m_msg->write_config("integrator.L-BFGS.memory",lexical_cast<string>(m_memory));
+  }
+  
+  //! Perform one iteration of the minimiser
+  void integrate();
+  
+protected:
+  
+  //! Discard stored correction pairs
+  void reset_history()
+  {
+    m_s.clear();
+    m_y.clear();
+    m_rho.clear();
+  }
+  
+private:
+  
+  int m_memory;                    //!< Maximum number of stored correction pairs
+  vector< vector<double> > m_s;    //!< Stored position changes
+  vector< vector<double> > m_y;    //!< Stored gradient changes
+  vector<double> m_rho;            //!< Stored values of 1/(s.y)
+  vector<double> m_g_old;          //!< Gradient at the beginning of the iteration
+  
+  //! Compute search direction using two-loop recursion
+  void compute_direction();
+  
+};
+
+typedef shared_ptr<IntegratorLBFGS> IntegratorLBFGSPtr;
+
+#endif
@@ -0,0 +1,211 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_minimiser.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of IntegratorMinimiser class
+ */ 
+
+#include "integrator_minimiser.hpp"
+
+/*! Checks whether the configuration has been changed since the last iteration (e.g., by 
+ *  another integrator or by population control). If so, the history is discarded 
+ *  and the minimisation restarts. Energy and gradient are computed if needed.
+ *  \return false if the minimiser has converged and there is nothing to do
+ */
+bool IntegratorMinimiser::start_iteration()
+{
+  if (m_initialised && this->configuration_changed())
+  {
+    m_initialised = false;
+    m_converged = false;
+    this->reset_history();
+  }
+  if (m_converged)
+    return false;
+  if (!m_initialised)
+  {
+    m_particles = m_system->get_group(m_group_name)->get_particles();
+    m_energy = this->evaluate();
+    m_initialised = true;
+  }
+  return true;
+}
+
+/*! \param E_old energy at the beginning of the iteration
+ *  \param step accepted line search step (0 if the line search failed)
+ */
+void IntegratorMinimiser::finish_iteration(double E_old, double step)
+{
+  m_iter++;
+  double F_rms = (m_g.size() > 0) ? sqrt(this->dot(m_g,m_g)/m_g.size()) : 0.0;
+  string state = "Energy = "+lexical_cast<string>(m_energy)+". RMS force = "+lexical_cast<string>(F_rms)+".";
+  if (step == 0.0)
+  {
+    m_converged = true;
+    m_msg->msg(Messenger::WARNING,m_name+" minimiser. Line search could not lower the energy after "+lexical_cast<string>(m_iter)+" iterations. Stopping minimisation. "+state);
+  }
+  else if (F_rms < m_F_tol && fabs(m_energy - E_old) < m_E_tol)
+  {
+    m_converged = true;
+    m_msg->msg(Messenger::INFO,m_name+" minimisation converged after "+lexical_cast<string>(m_iter)+" iterations. "+state);
+  }
+  else if (m_log_freq > 0 && m_iter % m_log_freq == 0)
+    m_msg->msg(Messenger::INFO,m_name+" minimiser iteration "+lexical_cast<string>(m_iter)+". "+state+" Step = "+lexical_cast<string>(step)+".");
+  this->store_configuration();
+}
+
+/*! Computes forces, total potential energy and the energy gradient, i.e., negative force 
+ *  projected onto the tangent plane of the constraint. Only particles in the group contribute to the gradient.
+ *  \return total potential energy
+ */
+double IntegratorMinimiser::evaluate()
+{
+  int N = m_particles.size();
+  m_system->reset_forces();
+  m_system->reset_torques();
+  // Energy is needed for the line search
+  m_system->set_compute_energy(true);
+  m_interactions->compute(m_dt);
+  m_g.resize(3*N);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(m_particles[i]);
+    double fx = p.fx, fy = p.fy, fz = p.fz;
+    m_constrainer->project_tangent(p, fx, fy, fz);
+    m_g[3*i]   = -fx;
+    m_g[3*i+1] = -fy;
+    m_g[3*i+2] = -fz;
+  }
+  return m_potential->compute_potential_energy();
+}
+
+/*! Line search with sufficient decrease (Armijo) and curvature (weak Wolfe) conditions. If the sufficient
+ *  decrease condition is not met, the step is reduced to the minimum of the quadratic interpolation of the energy (but not 
+ *  less than 1/10 and not more than 1/2 of the current step). If it is met, but the energy is still decreasing steeply 
+ *  along the search direction, the step is doubled. The step is limited so that no particle is displaced by more than 
+ *  max_step. On return, energy and gradient correspond to the new configuration.
+ *  \param dg directional derivative of the energy along the search direction (has to be negative)
+ *  \param step initial step 
+ *  \param c_curv curvature condition parameter (the step is accepted if the directional derivative is larger than c_curv*dg)
+ *  \return accepted step or 0 if no step lowered the energy (particles are then moved back)
+ */
+double IntegratorMinimiser::line_search(double dg, double step, double c_curv)
+{
+  int N = m_particles.size();
+  double E0 = m_energy;
+  double d_max = 0.0;
+  for (int i = 0; i < N; i++)
+    d_max = max(d_max, sqrt(m_d[3*i]*m_d[3*i] + m_d[3*i+1]*m_d[3*i+1] + m_d[3*i+2]*m_d[3*i+2]));
+  if (d_max == 0.0 || dg >= 0.0)
+    return 0.0;
+  double step_max = m_max_step/d_max;
+  step = min(step, step_max);
+  double s_cur = 0.0;       // current displacement along the search direction
+  double s_ok = 0.0;        // largest step that satisfied sufficient decrease condition
+  bool backtracked = false;
+  for (int k = 0; k < MINIMISER_MAX_LINE_SEARCH; k++)
+  {
+    this->displace(step - s_cur);
+    s_cur = step;
+    double E = this->evaluate();
+    if (E <= E0 + MINIMISER_ARMIJO*step*dg)
+    {
+      if (backtracked || step >= step_max || this->dot(m_g, m_d) >= c_curv*dg)
+      {
+        m_energy = E;
+        return step;
+      }
+      s_ok = step;
+      step = min(2.0*step, step_max);
+    }
+    else if (s_ok > 0.0)
+      break;
+    else
+    {
+      backtracked = true;
+      double s_q = -0.5*dg*step*step/(E - E0 - dg*step);
+      step = max(0.1*step, min(0.5*step, s_q));
+    }
+  }
+  // Go back to the last acceptable step (or to the starting configuration)
+  this->displace(s_ok - s_cur);
+  m_energy = this->evaluate();
+  return s_ok;
+}
+
+/*! Moves all particles in the group by ds times the search direction, projects them back 
+ *  onto the constraint, updates the mesh and, if needed, rebuilds the neighbour list.
+ *  \param ds step 
+ */
+void IntegratorMinimiser::displace(double ds)
+{
+  int N = m_particles.size();
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(m_particles[i]);
+    p.x += ds*m_d[3*i];
+    p.y += ds*m_d[3*i+1];
+    p.z += ds*m_d[3*i+2];
+    m_constrainer->enforce(p);
+  }
+  m_system->update_mesh();
+  if (m_nlist && ((m_potential && m_potential->need_nlist()) || (m_align && m_align->need_nlist())))
+  {
+    for (int i = 0; i < N; i++)
+      if (m_nlist->need_update(m_system->get_particle(m_particles[i])))
+      {
+        m_nlist->build();
+        break;
+      }
+  }
+}
+
+//! Stores positions of all particles and topology version after the iteration
+void IntegratorMinimiser::store_configuration()
+{
+  int N = m_system->size();
+  m_pos.resize(3*N);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    m_pos[3*i] = p.x;  m_pos[3*i+1] = p.y;  m_pos[3*i+2] = p.z;
+  }
+  m_topology = m_system->get_topology_version();
+}
+
+//! \return true if any particle moved or particles were added or removed since the last iteration 
+bool IntegratorMinimiser::configuration_changed()
+{
+  int N = m_system->size();
+  if (m_topology != m_system->get_topology_version() || static_cast<int>(m_pos.size()) != 3*N)
+    return true;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    if (m_pos[3*i] != p.x || m_pos[3*i+1] != p.y || m_pos[3*i+2] != p.z)
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,185 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_minimiser.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorMinimiser class
+ */ 
+
+#ifndef __INTEGRATOR_MINIMISER_H__
+#define __INTEGRATOR_MINIMISER_H__
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "integrator.hpp"
+
+using std::sqrt;
+using std::fabs;
+using std::min;
+using std::max;
+using std::vector;
+
+#define MINIMISER_MAX_LINE_SEARCH 20    //!< Maximum number of energy evaluations in a single line search 
+#define MINIMISER_ARMIJO 1e-4           //!< Sufficient decrease parameter of the line search 
+
+/*! IntegratorMinimiser is the base class for line search energy minimisers (L-BFGS, conjugate gradient).
+ *  Each call to integrate() performs one iteration of the minimiser, i.e. one line search. Only particle 
+ *  positions are minimised. Gradients are projected onto the tangent plane of the constraint 
+ *  and particles are projected back onto the constraint surface after each displacement.
+ *  Once converged, the minimiser does not move particles until some other process (e.g., another integrator
+ *  or population control) changes the configuration. 
+ *  Convergence is reached when the RMS value of the projected force per degree of freedom drops 
+ *  below f_tolerance and energy change between two iterations is smaller than e_tolerance.
+ *  \note No activity. Just minimisation.
+*/
+class IntegratorMinimiser : public Integrator
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  //! \param name name of the minimiser (used in messages)
+  IntegratorMinimiser(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param, const string& name) : Integrator(sys, msg, pot, align, nlist, cons, temp, param),
+                                                                                                                                                                                             m_name(name),
+                                                                                                                                                                                             m_initialised(false),
+                                                                                                                                                                                             m_converged(false),
+                                                                                                                                                                                             m_iter(0),
+                                                                                                                                                                                             m_energy(0.0),
+                                                                                                                                                                                             m_topology(-1)
+  { 
+    m_known_params.push_back("f_tolerance");
+    m_known_params.push_back("e_tolerance");
+    m_known_params.push_back("max_step");
+    m_known_params.push_back("log_freq");
+    if (param.find("f_tolerance") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser f_tolerance set to "+param["f_tolerance"]+".");
+      m_F_tol = lexical_cast<double>(param["f_tolerance"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser f_tolerance not set. Using default value of 1e-4.");
+      m_F_tol = 1e-4;
+    }
+    m_msg->write_config("integrator."+m_name+".F_tol",lexical_cast<string>(m_F_tol));
+    if (param.find("e_tolerance") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser e_tolerance set to "+param["e_tolerance"]+".");
+      m_E_tol = lexical_cast<double>(param["e_tolerance"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser e_tolerance not set. Using default value of 1e-6.");
+      m_E_tol = 1e-6;
+    }
+    m_msg->write_config("integrator."+m_name+".E_tol",lexical_cast<string>(m_E_tol));
+    if (param.find("max_step") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser maximum particle displacement in a line search step set to "+param["max_step"]+".");
+      m_max_step = lexical_cast<double>(param["max_step"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser maximum particle displacement in a line search step not set. Using default value of 0.1.");
+      m_max_step = 0.1;
+    }
+    m_msg->write_config("integrator."+m_name+".max_step",lexical_cast<string>(m_max_step));
+    if (param.find("log_freq") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser reports progress every "+param["log_freq"]+" iterations.");
+      m_log_freq = lexical_cast<int>(param["log_freq"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser progress report frequency not set. Using default value of 100 iterations.");
+      m_log_freq = 100;
+    }
+    m_msg->write_config("integrator."+m_name+".log_freq",lexical_cast<string>(m_log_freq));
+  }
+  
+protected:
+  
+  string m_name;              //!< Name of the minimiser
+  bool   m_initialised;       //!< True if gradient and energy correspond to the current configuration
+  bool   m_converged;         //!< Flag which tests if the method has converged
+  int    m_iter;              //!< Number of iterations so far
+  double m_energy;            //!< Energy in the current configuration
+  double m_F_tol;             //!< Force tolerance for checking convergence 
+  double m_E_tol;             //!< Energy tolerance for checking convergence 
+  double m_max_step;          //!< Maximum displacement of a particle in a single line search step
+  int    m_log_freq;          //!< Report progress every so many iterations (0 for never)
+  vector<int> m_particles;    //!< Particles in the group
+  vector<double> m_g;         //!< Energy gradient (negative projected force) of the particles in the group
+  vector<double> m_d;         //!< Search direction
+  
+  //! Prepare an iteration
+  bool start_iteration();
+  
+  //! Finish an iteration (check convergence and report progress)
+  void finish_iteration(double, double);
+  
+  //! Compute energy and its gradient in the current configuration 
+  double evaluate();
+  
+  //! Line search along the search direction 
+  double line_search(double, double, double);
+  
+  //! Dot product of two vectors
+  double dot(const vector<double>& a, const vector<double>& b)
+  {
+    double res = 0.0;
+    for (unsigned int k = 0; k < a.size(); k++)
+      res += a[k]*b[k];
+    return res;
+  }
+  
+  //! Reset minimiser history (called when the configuration changed outside of the minimiser)
+  virtual void reset_history() { }
+  
+private:
+  
+  vector<double> m_pos;       //!< Positions of all particles after the last iteration
+  int m_topology;             //!< Topology version after the last iteration
+  
+  //! Displace particles along the search direction
+  void displace(double);
+  
+  //! Store configuration after the iteration
+  void store_configuration();
+  
+  //! Check if configuration changed since the last iteration
+  bool configuration_changed();
+  
+};
+
+#endif
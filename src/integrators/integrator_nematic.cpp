@@ -46,6 +46,7 @@ void IntegratorNematic::integrate()
 {
   int N = m_system->get_group(m_group_name)->get_size();
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
   // reset forces and torques
   m_system->reset_forces();
   m_system->reset_torques();
@@ -53,13 +54,20 @@ void IntegratorNematic::integrate()
   // No need to compute potential, only compute torques in the current configuration
   if (m_align)
     m_align->compute();
-  // iterate over all particles 
+  // generate rotational noise for all particles at once
+  m_flags.resize(N);
+  for (int i = 0; i < N; i++)
+    m_flags[i] = m_system->get_particle(particles[i]).get_flag();
+  m_rng->fill_gaussian(m_noise_rot, 1, m_flags, step, RNG::ROTATION);
+  // iterate over all particles (in parallel only if each particle has its own random numbers)
+#pragma omp parallel for if (m_rng->counter_based() && N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
     Particle& p = m_system->get_particle(pi);
+    RNGStream rng_trans = m_rng->stream(p.get_flag(), step, RNG::TRANSLATION);
     // Update particle position 
-    double kappa = m_rng->drnd()-0.5;
+    double kappa = rng_trans.drnd()-0.5;
     if (kappa != 0.0)
       kappa /= fabs(kappa);
     else
@@ -68,16 +76,20 @@ void IntegratorNematic::integrate()
     p.x += kappa*p.nx;
     p.y += kappa*p.ny;
     p.z += kappa*p.nz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    p.age += m_dt;
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
+  m_constrainer->project_torques(particles,m_torque);
+  m_dtheta.resize(N);
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
     // Update angular velocity
-    p.omega = m_mu*m_constrainer->project_torque(p);
-    //p.omega = m_dt*m_constraint->project_torque(p);
+    p.omega = m_mu*m_torque[i];
     // Change orientation of the director (in the tangent plane) according to eq. (1b)
-    double dtheta = m_dt*p.omega + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    //double dtheta = m_dt*m_constraint->project_torque(p) + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    m_constrainer->rotate_director(p,dtheta);
-    //p.omega = dtheta*m_dt;
-    p.age += m_dt;
+    m_dtheta[i] = m_dt*p.omega + m_stoch_coeff*m_noise_rot[i];
   }
+  m_constrainer->rotate_directors(particles,m_dtheta);
 }
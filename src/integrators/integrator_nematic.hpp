@@ -89,18 +89,22 @@ public:
       m_mu = lexical_cast<double>(param["mu"]);
     }
     m_msg->write_config("integrator.nematic.mu",lexical_cast<string>(m_mu));
+    bool counter_rng = (param.find("counter_rng") != param.end());
     if (param.find("seed") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Nematic dynamic integrator. No random number generator seed specified. Using default 0.");
-      m_rng = make_shared<RNG>(0);
+      m_rng = make_shared<RNG>(0, counter_rng);
       m_msg->write_config("integrator.nematic.seed",lexical_cast<string>(0));
     }
     else
     {
       m_msg->msg(Messenger::INFO,"Nematic dynamic integrator. Setting random number generator seed to "+param["seed"]+".");
-      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]), counter_rng);
       m_msg->write_config("integrator.nematic.seed",param["seed"]);
     }
+    if (counter_rng)
+      m_msg->msg(Messenger::INFO,"Nematic dynamic integrator. Using counter-based random numbers for each particle.");
+    m_msg->write_config("integrator.nematic.counter_rng",lexical_cast<string>(counter_rng));
     m_stoch_coeff = sqrt(m_nu*m_dt);
   }
   
@@ -114,6 +118,10 @@ private:
   double  m_nu;           //!< Rotational diffusion
   double  m_mu;           //!< Mobility
   double  m_stoch_coeff;  //!< Factor for the stochastic part of the equation of motion (\f$ = \nu \sqrt{dt} \f$)
+  vector<int>    m_flags;        //!< Flags of particles in the group (identify random number streams)
+  vector<double> m_noise_rot;    //!< Rotational noise for all particles in the current step
+  vector<double> m_torque;       //!< Torques projected onto the surface normal for all particles in the current step
+  vector<double> m_dtheta;       //!< Director rotation angles for all particles in the current step
   
 };
 
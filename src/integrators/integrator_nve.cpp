@@ -42,6 +42,7 @@ void IntegratorNVE::integrate()
   
   
   // Perform first half step for velocity
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -50,12 +51,16 @@ void IntegratorNVE::integrate()
     p.vx += dt_2*p.fx;
     p.vy += dt_2*p.fy;
     p.vz += dt_2*p.fz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
+  // Update angular velocity
+  m_constrainer->project_torques(particles,m_torque);
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(particles[i]).omega += dt_2*m_torque[i];
   // update position
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -77,37 +82,35 @@ void IntegratorNVE::integrate()
     p.x += dx;
     p.y += dy; 
     p.z += dz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
 
-  // Enforce constraints and update alignment
+  // Update alignment
+  m_dtheta.resize(N);
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
     Particle& p = m_system->get_particle(pi);
-    //Particle& p = m_system->get_particle(i);
     // Change orientation of the velocity (in the tangent plane) according to eq. (1b)
     double dtheta = m_dt*p.omega; //m_constraint->project_torque(p);
     if (m_has_theta_limit)
       if (fabs(dtheta) > m_theta_limit)
         dtheta = SIGN(dtheta)*m_theta_limit;
-    m_constrainer->rotate_director(p,dtheta);
-    //p.omega = dtheta*m_dt;
+    m_dtheta[i] = dtheta;
   }
+  m_constrainer->rotate_directors(particles,m_dtheta);
 
   // reset forces and torques
   m_system->reset_forces();
   m_system->reset_torques();
 
-  // compute forces in the current configuration
-  if (m_potential)
-    m_potential->compute(m_dt);
-  // compute torques in the current configuration
-  if (m_align)
-    m_align->compute();
+  // compute forces and torques in the current configuration
+  m_interactions->compute(m_dt);
   
   // Perform second half step for velocity only if there is no limit on particle move
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -127,10 +130,16 @@ void IntegratorNVE::integrate()
         p.vz = p.vz/v*m_limit/m_dt;
       }
     }
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce_all(particles);
+  // Update angular velocity
+  m_constrainer->project_torques(particles,m_torque);
+#pragma omp parallel for if (N > INTEGRATOR_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    p.omega += dt_2*m_torque[i];
     if (m_has_limit)
       if (fabs(p.omega)*m_dt > m_theta_limit)
         p.omega = SIGN(p.omega)*m_theta_limit/m_dt;
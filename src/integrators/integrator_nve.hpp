@@ -84,6 +84,8 @@ private:
   double  m_theta_limit;        //!< If set, maximum angular displacement of the director
   bool    m_has_limit;          //!< Flag that determines if maximum particle displacement has been set
   bool    m_has_theta_limit;    //!< Flag that determines if maximum angular displacement of the particle has been set
+  vector<double> m_torque;      //!< Torques projected onto the surface normal for all particles in the current step
+  vector<double> m_dtheta;      //!< Director rotation angles for all particles in the current step
   
 };
 
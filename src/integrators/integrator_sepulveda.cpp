@@ -112,12 +112,8 @@ void IntegratorSepulveda::integrate()
   m_system->reset_torques();
 
 
-  // compute forces in the current configuration
-  if (m_potential)
-    m_potential->compute(m_dt);
-  // compute torques in the current configuration
-  if (m_align)
-    m_align->compute();
+  // compute forces and torques in the current configuration
+  m_interactions->compute(m_dt);
   
   // Generalized Langevin Dynamics, pg. 377 step 4
   // Perform second half step for velocity only if there is no limit on particle move
@@ -46,17 +46,10 @@ void IntegratorVicsek::integrate()
   double noise = m_eta*sqrt(m_dt);
   int N = m_system->get_group(m_group_name)->get_size();
   vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  int step = m_system->get_step();
   
-  // reset forces and torques
-  m_system->reset_forces();
-  m_system->reset_torques();
-  
-  // compute forces in the current configuration
-  if (m_potential)
-    m_potential->compute(m_dt);
-  // compute torques in the current configuration
-  if (m_align)
-    m_align->compute();
+  // compute forces and torques in the configuration at the beginning of the step (shared by all integrators in this step)
+  m_interactions->compute_shared(m_dt);
   // iterate over all particles 
   for (int i = 0; i < N; i++)
   {
@@ -69,7 +62,8 @@ void IntegratorVicsek::integrate()
     // Project everything back to the manifold
     m_constrainer->enforce(p);
     // Change orientation of the velocity (in the tangent plane) 
-    double theta = 2.0*noise*M_PI*(m_rng->drnd() - 0.5);
+    RNGStream rng_rot = m_rng->stream(p.get_flag(), step, RNG::ROTATION);
+    double theta = 2.0*noise*M_PI*(rng_rot.drnd() - 0.5);
     m_constrainer->rotate_velocity(p,theta);
     // Update particle position 
     p.x += m_dt*p.vx;
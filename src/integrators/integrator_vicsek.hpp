@@ -78,18 +78,22 @@ public:
         m_msg->msg(Messenger::WARNING,"Original Vicsek dynamics has no pairwise interaction term beyond the alignment. Using modified approach");
     }
     m_msg->write_config("integrator.vicsek.mu",lexical_cast<string>(m_mu));
+    bool counter_rng = (param.find("counter_rng") != param.end());
     if (param.find("seed") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Vicsek dynamic integrator. No random number generator seed specified. Using default 0.");
-      m_rng = make_shared<RNG>(0);
+      m_rng = make_shared<RNG>(0, counter_rng);
       m_msg->write_config("integrator.vicsek.seed",lexical_cast<string>(0));
     }
     else
     {
       m_msg->msg(Messenger::INFO,"Vicsek dynamic integrator. Setting random number generator seed to "+param["seed"]+".");
-      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]), counter_rng);
       m_msg->write_config("integrator.vicsek.seed",param["seed"]);
     }
+    if (counter_rng)
+      m_msg->msg(Messenger::INFO,"Vicsek dynamic integrator. Using counter-based random numbers for each particle.");
+    m_msg->write_config("integrator.vicsek.counter_rng",lexical_cast<string>(counter_rng));
     if (param.find("v0") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"No velocity magnitude (v0) specified for Vicsek integrator. Setting it to 1.");
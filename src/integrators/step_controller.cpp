@@ -0,0 +1,238 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file step_controller.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of StepController class.
+ */ 
+
+#include "step_controller.hpp"
+
+/*! \param msg Internal message handler
+ *  \param param Contains information about all parameters 
+ *  \param name Name of the integrator (used in messages)
+ *  \param dt time step
+ */
+StepController::StepController(MessengerPtr msg, pairs_type& param, const string& name, double dt) : m_msg(msg),
+                                                                                                       m_name(name),
+                                                                                                       m_dt(dt),
+                                                                                                       m_h(dt),
+                                                                                                       m_h_trial(dt),
+                                                                                                       m_t_left(0.0),
+                                                                                                       m_substep(0),
+                                                                                                       m_step(0),
+                                                                                                       m_n(0),
+                                                                                                       m_draw(0),
+                                                                                                       m_steps(0),
+                                                                                                       m_accepted(0),
+                                                                                                       m_rejected(0),
+                                                                                                       m_forced(0),
+                                                                                                       m_h_smallest(dt)
+{
+  m_enabled = (param.find("adaptive") != param.end());
+  m_msg->write_config("integrator."+m_name+".adaptive",lexical_cast<string>(m_enabled));
+  if (!m_enabled)
+    return;
+  m_msg->msg(Messenger::INFO,"Integrator "+m_name+". Using adaptive step size.");
+  if (param.find("max_disp") == param.end())
+  {
+    m_msg->msg(Messenger::WARNING,"Integrator "+m_name+". Maximum displacement in a substep not set. Using default value 0.1.");
+    m_max_disp = 0.1;
+  }
+  else
+  {
+    m_msg->msg(Messenger::INFO,"Integrator "+m_name+". Setting maximum displacement in a substep to "+param["max_disp"]+".");
+    m_max_disp = lexical_cast<double>(param["max_disp"]);
+  }
+  if (m_max_disp <= 0.0)
+  {
+    m_msg->msg(Messenger::ERROR,"Integrator "+m_name+". Maximum displacement in a substep has to be positive.");
+    throw runtime_error("Non-positive maximum displacement for adaptive step size.");
+  }
+  m_msg->write_config("integrator."+m_name+".max_disp",lexical_cast<string>(m_max_disp));
+  if (param.find("dt_min") == param.end())
+  {
+    m_dt_min = 1e-4*m_dt;
+    m_msg->msg(Messenger::WARNING,"Integrator "+m_name+". Smallest substep not set. Using default value "+lexical_cast<string>(m_dt_min)+".");
+  }
+  else
+  {
+    m_msg->msg(Messenger::INFO,"Integrator "+m_name+". Setting smallest substep to "+param["dt_min"]+".");
+    m_dt_min = lexical_cast<double>(param["dt_min"]);
+  }
+  if (m_dt_min <= 0.0 || m_dt_min > m_dt)
+  {
+    m_msg->msg(Messenger::ERROR,"Integrator "+m_name+". Smallest substep has to be positive and not larger than the time step.");
+    throw runtime_error("Invalid smallest substep for adaptive step size.");
+  }
+  m_msg->write_config("integrator."+m_name+".dt_min",lexical_cast<string>(m_dt_min));
+}
+
+/*! Start a new time step for integrators where noise does not enter the displacement 
+ *  directly (e.g., Langevin dynamics). Random numbers are then drawn for each substep 
+ *  separately, which is allowed since the substep is chosen before they are drawn.
+ */
+void StepController::begin()
+{
+  m_t_left = m_dt;
+  m_substep = 0;
+  m_n = 0;
+  m_segments.clear();
+  m_dW.clear();
+  m_steps++;
+}
+
+/*! Start a new time step for over-damped integrators. 
+ *  \param rng random number generator used for Brownian bridge 
+ *  \param flags unique flags of particles 
+ *  \param step current time step
+ *  \param n number of noise components per particle
+ *  \param noise unit Gaussian numbers for the whole step (n per particle)
+ */
+void StepController::begin(RNGPtr rng, const vector<int>& flags, int step, int n, const vector<double>& noise)
+{
+  this->begin();
+  m_rng = rng;
+  m_flags = flags;
+  m_step = step;
+  m_n = n;
+  m_draw = 0;
+  if (m_n == 0)
+    return;
+  double sqrt_dt = std::sqrt(m_dt);
+  m_segments.resize(1);
+  m_segments[0].length = m_dt;
+  m_segments[0].dW.resize(noise.size());
+  for (unsigned int i = 0; i < noise.size(); i++)
+    m_segments[0].dW[i] = sqrt_dt*noise[i];
+}
+
+/*! Proposed substep is the current substep size, unless that goes beyond the end of the 
+ *  time step. Wiener increments for it are obtained by joining or splitting remaining parts of the step.
+ *  \return length of the proposed substep
+ */
+double StepController::trial()
+{
+  m_h_trial = std::min(m_h, m_t_left);
+  if (m_n == 0)
+    return m_h_trial;
+  // Join parts shorter than the substep (increments over consecutive intervals add up)
+  while (m_segments.size() > 1 && m_segments.back().length < m_h_trial*(1.0 - STEP_TOL))
+  {
+    Segment& first = m_segments.back();
+    Segment& second = m_segments[m_segments.size()-2];
+    second.length += first.length;
+    for (unsigned int i = 0; i < second.dW.size(); i++)
+      second.dW[i] += first.dW[i];
+    m_segments.pop_back();
+  }
+  Segment& seg = m_segments.back();
+  if (m_h_trial < seg.length*(1.0 - STEP_TOL))
+  {
+    this->split(seg.dW, seg.length, m_h_trial, m_dW);
+    seg.length -= m_h_trial;
+  }
+  else
+  {
+    m_h_trial = seg.length;
+    m_dW.swap(seg.dW);
+    m_segments.pop_back();
+  }
+  return m_h_trial;
+}
+
+/*! If the largest displacement exceeds the allowed one, the substep is rejected and halved 
+ *  (unless that would make it smaller than the smallest allowed substep). 
+ *  \param disp largest displacement of a particle in the proposed substep 
+ *  \return true if the substep has been accepted
+ */
+bool StepController::accept(double disp)
+{
+  if (disp > m_max_disp && 0.5*m_h_trial >= m_dt_min)
+  {
+    double h = 0.5*m_h_trial;
+    if (m_n > 0)
+    {
+      m_segments.push_back(Segment());
+      m_segments.push_back(Segment());
+      Segment& first = m_segments.back();
+      Segment& second = m_segments[m_segments.size()-2];
+      this->split(m_dW, m_h_trial, h, first.dW);
+      first.length = h;
+      second.length = m_h_trial - h;
+      second.dW.swap(m_dW);
+    }
+    m_h = h;
+    m_rejected++;
+    return false;
+  }
+  if (disp > m_max_disp)
+    m_forced++;
+  m_t_left -= m_h_trial;
+  m_substep++;
+  m_accepted++;
+  m_h_smallest = std::min(m_h_smallest, m_h_trial);
+  if (disp < STEP_RELAXED*m_max_disp)
+    m_h = std::min(STEP_GROW*m_h, m_dt);
+  return true;
+}
+
+/*! Messages are sent only if adaptive step size is used. Counters are reset, so that 
+ *  each run is reported separately.
+ */
+void StepController::report()
+{
+  if (!m_enabled)
+    return;
+  m_msg->msg(Messenger::INFO,"Integrator "+m_name+". Adaptive step size: "+lexical_cast<string>(m_accepted)+" substeps accepted and "+lexical_cast<string>(m_rejected)+" rejected in "+lexical_cast<string>(m_steps)+" time steps. Smallest substep : "+lexical_cast<string>(m_h_smallest)+".");
+  if (m_forced > 0)
+    m_msg->msg(Messenger::WARNING,"Integrator "+m_name+". "+lexical_cast<string>(m_forced)+" substeps of the smallest allowed size exceeded the maximum displacement. Consider reducing dt_min.");
+  m_steps = 0;
+  m_accepted = 0;
+  m_rejected = 0;
+  m_forced = 0;
+  m_h_smallest = m_dt;
+}
+
+// Private methods
+
+/*! Given increments \f$ \Delta W \f$ over an interval of length \f$ L \f$, draws increments over its first part 
+ *  of length \f$ h \f$ from the Brownian bridge, \f$ \Delta W_1 = \frac{h}{L}\Delta W + \sqrt{\frac{h\left(L-h\right)}{L}}\zeta \f$.
+ *  Increments over the remaining part, \f$ \Delta W - \Delta W_1 \f$, are returned in place. 
+ *  \param dW increments over the whole interval (on return, over the remaining part)
+ *  \param L length of the interval 
+ *  \param h length of the first part
+ *  \param dW1 increments over the first part (returned)
+ */
+void StepController::split(vector<double>& dW, double L, double h, vector<double>& dW1)
+{
+  m_rng->fill_gaussian(m_zeta, m_n, m_flags, m_step, RNG::BRIDGE, m_draw++);
+  double a = h/L, b = std::sqrt(h*(L - h)/L);
+  dW1.resize(dW.size());
+  for (unsigned int i = 0; i < dW.size(); i++)
+  {
+    dW1[i] = a*dW[i] + b*m_zeta[i];
+    dW[i] -= dW1[i];
+  }
+}
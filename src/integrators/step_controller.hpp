@@ -0,0 +1,166 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file step_controller.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of StepController class.
+ */ 
+
+#ifndef __STEP_CONTROLLER_HPP__
+#define __STEP_CONTROLLER_HPP__
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "messenger.hpp"
+#include "parse_parameters.hpp"
+#include "rng.hpp"
+
+using std::vector;
+using std::string;
+using std::runtime_error;
+using boost::shared_ptr;
+using boost::lexical_cast;
+
+//! Substep size is multiplied by this factor after a substep in which particles moved little
+const double STEP_GROW = 2.0;
+//! Substep is considered relaxed if the largest displacement is below this fraction of the allowed one
+const double STEP_RELAXED = 0.5;
+//! Relative tolerance for comparing lengths of substeps
+const double STEP_TOL = 1e-10;
+
+/*! StepController implements adaptive step size control for integrators. Each time step 
+ *  of length \f$ \delta t \f$ is covered with one or more substeps. A substep is rejected 
+ *  and halved if some particle would move by more than the maximum allowed displacement in it.
+ *  After a substep in which all particles moved by less than half of that, the substep size 
+ *  is doubled (up to \f$ \delta t \f$), so that the integrator returns to the full step once 
+ *  the system has relaxed. The substep size is kept between time steps.
+ *  
+ *  For over-damped integrators, noise enters the displacement directly and rejecting a 
+ *  step based on it would bias the dynamics. Noise for the entire step is therefore treated 
+ *  as a set of Wiener increments \f$ \Delta W \f$ over \f$ \delta t \f$. When a substep is halved, the
+ *  increment is split using the Brownian bridge, \f$ \Delta W_1 = \frac{1}{2}\Delta W + \frac{\sqrt{h}}{2}\zeta \f$ and 
+ *  \f$ \Delta W_2 = \Delta W - \Delta W_1 \f$, where \f$ h \f$ is the length of the rejected substep and \f$ \zeta \f$ is 
+ *  a unit Gaussian number. The second half is kept for later, so the noise realisation over the 
+ *  step does not depend on rejections (rejection sampling with memory; C. Rackauckas and Q. Nie, 
+ *  Discrete Contin. Dyn. Syst. Ser. B 22, 2731 (2017)).
+ *  
+ *  Adaptive stepping is switched on with the integrator parameter \c adaptive. Parameter 
+ *  \c max_disp sets the maximum displacement of a particle in a substep (default 0.1) and
+ *  \c dt_min the smallest allowed substep (default \f$ 10^{-4}\delta t \f$). Substeps that 
+ *  cannot be reduced further are accepted regardless of the displacement. 
+ */
+class StepController
+{
+public:
+  
+  //! Constructor
+  //! \param msg Internal message handler
+  //! \param param Contains information about all parameters 
+  //! \param name Name of the integrator (used in messages)
+  //! \param dt time step
+  StepController(MessengerPtr msg, pairs_type& param, const string& name, double dt);
+  
+  //! Add parameters of the step controller to the list of integrator parameters
+  static void add_known_params(vector<string>& known)
+  {
+    known.push_back("adaptive");
+    known.push_back("max_disp");
+    known.push_back("dt_min");
+  }
+  
+  //! \return true if adaptive step size is used
+  bool enabled() { return m_enabled; }
+  
+  //! Start a new time step (without noise)
+  void begin();
+  
+  //! Start a new time step with noise treated as Wiener increments
+  void begin(RNGPtr, const vector<int>&, int, int, const vector<double>&);
+  
+  //! \return true if the whole time step has been covered
+  bool done() { return m_t_left <= STEP_TOL*m_dt; }
+  
+  //! Propose next substep
+  double trial();
+  
+  //! Wiener increments for the proposed substep (n per particle)
+  const vector<double>& increments() { return m_dW; }
+  
+  //! Accept or reject proposed substep based on the largest particle displacement in it
+  bool accept(double);
+  
+  //! \return number of substeps accepted so far in the current step
+  int substep() { return m_substep; }
+  
+  //! Send accepted and rejected substep counts to the messenger and reset them
+  void report();
+  
+private:
+  
+  //! Part of the time step with its Wiener increments
+  struct Segment
+  {
+    double length;       //!< Duration of the segment
+    vector<double> dW;   //!< Wiener increments (n per particle)
+  };
+  
+  MessengerPtr m_msg;          //!< Internal message handler
+  string m_name;               //!< Name of the integrator
+  bool m_enabled;              //!< If true, adaptive step size is used
+  double m_dt;                 //!< Time step
+  double m_max_disp;           //!< Maximum allowed displacement of a particle in a substep
+  double m_dt_min;             //!< Smallest allowed substep
+  double m_h;                  //!< Current substep size
+  double m_h_trial;            //!< Size of the proposed substep
+  double m_t_left;             //!< Part of the time step not yet covered
+  int m_substep;               //!< Number of accepted substeps in the current step
+  RNGPtr m_rng;                //!< Random number generator for Brownian bridge
+  vector<int> m_flags;         //!< Flags of particles (identify random number streams)
+  int m_step;                  //!< Current time step (identifies random number streams)
+  int m_n;                     //!< Number of increments per particle
+  int m_draw;                  //!< Number of Brownian bridge draws in the current step
+  vector<Segment> m_segments;  //!< Remaining parts of the time step (the earliest one is at the back)
+  vector<double> m_dW;         //!< Wiener increments for the proposed substep
+  vector<double> m_zeta;       //!< Gaussian numbers for Brownian bridge
+  int m_steps;                 //!< Number of time steps since the last report
+  int m_accepted;              //!< Number of accepted substeps since the last report
+  int m_rejected;              //!< Number of rejected substeps since the last report
+  int m_forced;                //!< Number of substeps accepted at the smallest substep size since the last report
+  double m_h_smallest;         //!< Smallest accepted substep since the last report
+  
+  //! Split Wiener increments over an interval 
+  void split(vector<double>&, double, double, vector<double>&);
+  
+};
+
+typedef shared_ptr<StepController> StepControllerPtr;
+
+#endif
@@ -61,6 +61,14 @@ public:
   //! \return logged quantity
   virtual string operator()() = 0;
   
+  //! Returns true if the logged quantity requires potential or alignment energies
+  //! to be accumulated during the force computation
+  virtual bool need_energy() { return false; }
+  
+  //! Returns true if the logged quantity requires per particle stress 
+  //! to be accumulated during the force computation
+  virtual bool need_stress() { return false; }
+  
 protected:
   
   SystemPtr m_system;        //!< Pointer to System object
@@ -56,6 +56,9 @@ public:
     return str(format("%12.6e ") % m_potential->compute_bond_potential_energy_of_type(m_type));
   }
   
+  //! This log needs energies
+  bool need_energy() { return true; }
+  
 private:
 
   string m_type;    //!< Bond energy type to log
@@ -0,0 +1,87 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file log_pressure_tensor.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of LogPressureTensor class
+ */ 
+
+#ifndef __LOG_PRESSURE_TENSOR_H__
+#define __LOG_PRESSURE_TENSOR_H__
+
+#include "log.hpp"
+
+//! LogPressureTensor class
+/*! Logs global pressure tensor 
+ *  \f$ P_{\alpha\beta} = \frac{1}{V}\left(\sum_i \frac{v_i^\alpha v_i^\beta}{m_i} + \sum_i W_i^{\alpha\beta}\right) \f$,
+ *  where \f$ W_i \f$ is the per particle virial accumulated by the potentials and \f$ V \f$ is the 
+ *  volume of the simulation box. Components are logged in the order xx, yy, zz, xy, xz, yz.
+ *  \note Stress is only computed on steps it is requested, i.e. on logging steps.
+ */
+class LogPressureTensor : public Log
+{
+public:
+  
+  //! Construct Log object
+  //! \param sys pointer to a system object
+  //! \param compute pointer to a compute object
+  //! \param pot Interaction handler object
+  //! \param align Alignment handler object
+  LogPressureTensor(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align) : Log(sys, msg, pot, align)  { }
+  
+  virtual ~LogPressureTensor() { }
+  
+   //! \return pressure tensor components
+  string operator()()
+  {
+    double P[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (int i = 0; i < m_system->size(); i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      double v[3] = {p.vx, p.vy, p.vz};
+      for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+          P[3*a+b] += v[a]*v[b]/p.mass;
+      if (m_system->has_stress(i))
+      {
+        double* s = m_system->get_stress(i);
+        for (int k = 0; k < 9; k++)
+          P[k] += s[k];
+      }
+    }
+    BoxPtr box = m_system->get_box();
+    double inv_V = 1.0/(box->Lx*box->Ly*box->Lz);
+    return str(format("%12.6e %12.6e %12.6e %12.6e %12.6e %12.6e ") % (P[0]*inv_V) % (P[4]*inv_V) % (P[8]*inv_V) 
+                                                                   % (P[1]*inv_V) % (P[2]*inv_V) % (P[5]*inv_V));
+  }
+  
+  //! This log needs stress
+  bool need_stress() { return true; }
+  
+};
+
+typedef shared_ptr<LogPressureTensor> LogPressureTensorPtr;
+
+#endif
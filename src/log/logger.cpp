@@ -73,6 +73,7 @@ Logger::Logger(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr ali
   m_logger["avg_perim"] = boost::make_shared<LogPerim>(LogPerim(sys, msg, pot, align));
   m_logger["size"] = boost::make_shared<LogSize>(LogSize(sys, msg, pot, align));
   m_logger["kinetic_energy"] = boost::make_shared<LogKineticEng>(LogKineticEng(sys, msg, pot, align));
+  m_logger["pressure_tensor"] = boost::make_shared<LogPressureTensor>(LogPressureTensor(sys, msg, pot, align));
 
   // ------------------------------------------------------------------
     
@@ -103,6 +104,10 @@ Logger::Logger(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr ali
         m_msg->msg(Messenger::INFO,"Adding log quantity : "+logme+".");
         m_to_log.push_back(logme);
         m_msg->add_config("logger."+file_name+".quantity",logme);
+        if (m_logger[logme]->need_energy())
+          m_system->request_energy(m_freq);
+        if (m_logger[logme]->need_stress())
+          m_system->request_stress(m_freq);
       }
       else
       {
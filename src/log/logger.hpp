@@ -56,6 +56,7 @@
 #include "log_perim.hpp"
 #include "log_size.hpp"
 #include "log_kinetic_eng.hpp"
+#include "log_pressure_tensor.hpp"
 
 using std::string;
 using std::ofstream;
@@ -64,6 +64,9 @@ public:
                   | qi::as_string[keyword["nematic"]][phx::bind(&DisableData::type, phx::ref(disable_data)) = qi::_1 ]     /*! Disables nematic integrator */
                   | qi::as_string[keyword["brownian_pos"]][phx::bind(&DisableData::type, phx::ref(disable_data)) = qi::_1 ]     /*! Disables brownian_pos integrator */
                   | qi::as_string[keyword["brownian_rod"]][phx::bind(&DisableData::type, phx::ref(disable_data)) = qi::_1 ]     /*! Disables brownian_rod integrator */
+                  | qi::as_string[keyword["brownian_implicit"]][phx::bind(&DisableData::type, phx::ref(disable_data)) = qi::_1 ]     /*! Disables brownian_implicit integrator */
+                  | qi::as_string[keyword["lbfgs"]][phx::bind(&DisableData::type, phx::ref(disable_data)) = qi::_1 ]     /*! Disables L-BFGS minimiser */
+                  | qi::as_string[keyword["cg"]][phx::bind(&DisableData::type, phx::ref(disable_data)) = qi::_1 ]     /*! Disables conjugate gradient minimiser */
                   /* to add new integrator: | qi::as_string[keyword["newintegrator"]][phx::bind(&DisableData::type, phx::ref(disable_data)) = qi::_1 ] */
                  )
                  >> qi::as_string[qi::no_skip[+qi::char_]][phx::bind(&DisableData::params, phx::ref(disable_data)) = qi::_1 ]
@@ -70,8 +70,11 @@ public:
                   | qi::as_string[keyword["brownian_rod"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ]   /*! Handles stochastic integrator for rods */
                   | qi::as_string[keyword["brownian_pos"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ]   /*! Handles stochastic integrator for particle position */
                   | qi::as_string[keyword["brownian_align"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ] /*! Handles stochastic integrator for particle alignment */
+                  | qi::as_string[keyword["brownian_implicit"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ] /*! Handles semi-implicit stochastic integrator for particle position */
                   | qi::as_string[keyword["langevin"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ]       /*! Handles Langevin stochastic integrator */
                   | qi::as_string[keyword["fire"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ]           /*! Handles FIRE minimisation integrator */
+                  | qi::as_string[keyword["lbfgs"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ]          /*! Handles L-BFGS minimisation integrator */
+                  | qi::as_string[keyword["cg"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ]             /*! Handles conjugate gradient minimisation integrator */
                   | qi::as_string[keyword["sepulveda"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ]      /*! Handles Sepulveda integrator */
                   /* to add new integrator: | qi::as_string[keyword["newintegrator"]][phx::bind(&IntegratorData::type, phx::ref(integrator_data)) = qi::_1 ] */
                  )
@@ -97,7 +97,8 @@ void PopulationCell::divide(int t)
       if (p.in_tissue && !p.boundary && V.area > m_max_A0)
       { 
         double prob_div = fact*(V.area - m_max_A0); // Bell model of division
-        if (m_rng->drnd() < prob_div)  // Only internal verices can divide
+        RNGStream rng_div = m_rng->stream(p.get_flag(), t, RNG::DIVISION);
+        if (rng_div.drnd() < prob_div)  // Only internal verices can divide
         {
           //cout << t << " " << V.area << " " << p.A0 << " " << exp((V.area-p.A0)/m_div_rate) << endl;
           Particle p_new(m_system->size(), p.get_type(), p.get_radius());
@@ -170,7 +171,8 @@ void PopulationCell::remove(int t)
       // Trying a very simple, linearly increasing death chance
       //double prob_death = fact*p.age/m_max_age;
       double prob_death = m_death_rate*m_freq*m_system->get_integrator_step(); // actual probability of dividing now: rate * (attempt_freq * dt)
-      if (p.in_tissue && !p.boundary && m_rng->drnd() < prob_death)
+      RNGStream rng_death = m_rng->stream(p.get_flag(), t, RNG::DEATH);
+      if (p.in_tissue && !p.boundary && rng_death.drnd() < prob_death)
           to_remove.push_back(p.get_id());
     }
     int offset = 0;
@@ -208,7 +210,8 @@ void PopulationCell::grow(int t)
     for (int i = 0; i < N; i++)
     {
 	  // Growth probability stays dimensionless, between 0 and 1. Instead, the actual growth rate is no an inverse time
-      if (m_rng->drnd() < m_growth_prob)
+      RNGStream rng_grow = m_rng->stream(m_system->get_particle(particles[i]).get_flag(), t, RNG::GROWTH);
+      if (rng_grow.drnd() < m_growth_prob)
       {
         int pi = particles[i];
         Particle& p = m_system->get_particle(pi); 
@@ -59,18 +59,22 @@ public:
   //! \param param Reference to the parameters that control given population control
   PopulationCell(SystemPtr sys, const MessengerPtr msg, pairs_type& param) : Population(sys,msg,param)
   { 
+    bool counter_rng = (param.find("counter_rng") != param.end());
     if (param.find("seed") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Cell population control. No random number generator seed specified. Using default 0.");
-      m_rng = make_shared<RNG>(0);
+      m_rng = make_shared<RNG>(0, counter_rng);
       m_msg->write_config("population.cell.seed",lexical_cast<string>(0));
     }
     else
     {
       m_msg->msg(Messenger::INFO,"Cell population control. Setting random number generator seed to "+param["seed"]+".");
-      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]));
+      m_rng = make_shared<RNG>(lexical_cast<int>(param["seed"]), counter_rng);
       m_msg->write_config("population.cell.seed",param["seed"]);
     }
+    if (counter_rng)
+      m_msg->msg(Messenger::INFO,"Cell population control. Using counter-based random numbers for each particle.");
+    m_msg->write_config("population.cell.counter_rng",lexical_cast<string>(counter_rng));
     if (param.find("division_rate") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Cell population control. No division multiplier rate set. Using default 1.0.");
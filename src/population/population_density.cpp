@@ -69,7 +69,8 @@ void PopulationDensity::divide(int t)
     {
       int pi = particles[i];
       Particle& p = m_system->get_particle(pi); 
-      if (m_rng->drnd() < prob_div*(1.0-p.coordination/m_rho_max))
+      RNGStream rng_div = m_rng->stream(p.get_flag(), t, RNG::DIVISION);
+      if (rng_div.drnd() < prob_div*(1.0-p.coordination/m_rho_max))
       {
         cout << " dividing particle of type " << p.get_type() << endl;
         Particle p_new(m_system->size(), p.get_type(), p.get_radius());
@@ -96,7 +97,7 @@ void PopulationDensity::divide(int t)
         p_new.set_length(p.get_length());
         p_new.set_default_area(p.get_A0());
         p_new.A0 = p.A0;
-        if (m_rng->drnd() < m_type_change_prob_1)  // Attempt to change type and group for first child
+        if (rng_div.drnd() < m_type_change_prob_1)  // Attempt to change type and group for first child
         {
           if (m_new_type == 0)
             new_type = p.get_type();
@@ -113,10 +114,10 @@ void PopulationDensity::divide(int t)
           if (m_poly == 0.0)
             new_r = m_new_radius;
           else 
-            new_r = m_new_radius*(1.0 + m_poly*(m_rng->drnd() - 0.5));
+            new_r = m_new_radius*(1.0 + m_poly*(rng_div.drnd() - 0.5));
         }
         p_new.set_radius(new_r);
-        if (m_rng->drnd() < m_type_change_prob_2)  // Attempt to change type and group for second child
+        if (rng_div.drnd() < m_type_change_prob_2)  // Attempt to change type and group for second child
         {
           if (m_new_type == 0)
             new_type = p_new.get_type();
@@ -180,7 +181,8 @@ void PopulationDensity::remove(int t)
     {
       int pi = particles[i];
       Particle& p = m_system->get_particle(pi);
-      if (m_rng->drnd() < prob_death) {
+      RNGStream rng_death = m_rng->stream(p.get_flag(), t, RNG::DEATH);
+      if (rng_death.drnd() < prob_death) {
         cout << "particle of type " << p.get_type() << " died " << endl;
         to_remove.push_back(p.get_id());
       }
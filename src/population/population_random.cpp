@@ -63,7 +63,8 @@ void PopulationRandom::divide(int t)
     {
       int pi = particles[i];
       Particle& p = m_system->get_particle(pi);
-      if (m_rng->drnd() < p.age*prob_div)
+      RNGStream rng_div = m_rng->stream(p.get_flag(), t, RNG::DIVISION);
+      if (rng_div.drnd() < p.age*prob_div)
       {
         Particle p_new(m_system->size(), p.get_type(), p.get_radius());
         p_new.x = p.x + m_alpha*p.get_radius()*p.nx;
@@ -97,7 +98,7 @@ void PopulationRandom::divide(int t)
         p_new.age = 0.0;
         for(list<string>::iterator it_g = p.groups.begin(); it_g != p.groups.end(); it_g++)
           p_new.add_group(*it_g);
-        if (m_rng->drnd() < m_type_change_prob_1)  // Attempt to change type, radius and group for first child
+        if (rng_div.drnd() < m_type_change_prob_1)  // Attempt to change type, radius and group for first child
         {
           if (m_new_type == 0)
             new_type = p.get_type();
@@ -113,7 +114,7 @@ void PopulationRandom::divide(int t)
         }
         m_system->add_particle(p_new);
         Particle& pr = m_system->get_particle(p_new.get_id());
-        if (m_rng->drnd() < m_type_change_prob_2)  // Attempt to change type, radius and group for second child
+        if (rng_div.drnd() < m_type_change_prob_2)  // Attempt to change type, radius and group for second child
         {
           if (m_new_type == 0)
             new_type = pr.get_type();
@@ -158,7 +159,8 @@ void PopulationRandom::remove(int t)
     {
       int pi = particles[i];
       Particle& p = m_system->get_particle(pi);
-      if (m_rng->drnd() < p.age*prob_death)
+      RNGStream rng_death = m_rng->stream(p.get_flag(), t, RNG::DEATH);
+      if (rng_death.drnd() < p.age*prob_death)
         to_remove.push_back(p.get_id());
     }
     int offset = 0;
@@ -31,81 +31,95 @@
 
 void AngleHarmonicPotential::compute()
 {
-  int Nangles = m_system->num_angles();
   bool periodic = m_system->get_periodic();
   BoxPtr box = m_system->get_box();
   double k = m_k;
   double t0 = m_t0;
   
-  m_potential_energy = 0.0;
-  for  (int i = 0; i < Nangles; i++)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  
+  m_engine.update_angles();
+  const vector<int>& angle_i = m_engine.angle_i();
+  const vector<int>& angle_j = m_engine.angle_j();
+  const vector<int>& angle_k = m_engine.angle_k();
+  const vector<int>& angle_type = m_engine.angle_type();
+  const vector<int>& colour = m_engine.angle_colours();
+  double potential_energy = 0.0;
+  // Angles of the same colour share no particles, so each colour class can be processed in parallel
+  for (int col = 0; col < m_engine.num_angle_colours(); col++)
   {
-    Angle& a = m_system->get_angle(i);
-    Particle& pi = m_system->get_particle(a.i);
-    Particle& pj = m_system->get_particle(a.j);
-    Particle& pk = m_system->get_particle(a.k);
-    double dx1 = pi.x - pj.x, dy1 = pi.y - pj.y, dz1 = pi.z - pj.z;
-    double dx2 = pk.x - pj.x, dy2 = pk.y - pj.y, dz2 = pk.z - pj.z;
-    if (periodic)
-    {
-      if (dx1 > box->xhi) dx1 -= box->Lx;
-      else if (dx1 < box->xlo) dx1 += box->Lx;
-      if (dy1 > box->yhi) dy1 -= box->Ly;
-      else if (dy1 < box->ylo) dy1 += box->Ly;
-      if (dz1 > box->zhi) dz1 -= box->Lz;
-      else if (dz1 < box->zlo) dz1 += box->Lz;
-      if (dx2 > box->xhi) dx2 -= box->Lx;
-      else if (dx2 < box->xlo) dx2 += box->Lx;
-      if (dy2 > box->yhi) dy2 -= box->Ly;
-      else if (dy2 < box->ylo) dy2 += box->Ly;
-      if (dz2 > box->zhi) dz2 -= box->Lz;
-      else if (dz2 < box->zlo) dz2 += box->Lz;
-    }
-    if (m_has_angle_params)
+    int begin = colour[col], end = colour[col+1];
+#pragma omp parallel for firstprivate(k,t0) reduction(+:potential_energy) if (end - begin > BONDED_PARALLEL_MIN)
+    for  (int n = begin; n < end; n++)
     {
-      k = m_angle_params[a.type-1].k;
-      t0 = m_angle_params[a.type-1].t0;
-     }
+      Particle& pi = m_system->get_particle(angle_i[n]);
+      Particle& pj = m_system->get_particle(angle_j[n]);
+      Particle& pk = m_system->get_particle(angle_k[n]);
+      double dx1 = pi.x - pj.x, dy1 = pi.y - pj.y, dz1 = pi.z - pj.z;
+      double dx2 = pk.x - pj.x, dy2 = pk.y - pj.y, dz2 = pk.z - pj.z;
+      if (periodic)
+      {
+        if (dx1 > box->xhi) dx1 -= box->Lx;
+        else if (dx1 < box->xlo) dx1 += box->Lx;
+        if (dy1 > box->yhi) dy1 -= box->Ly;
+        else if (dy1 < box->ylo) dy1 += box->Ly;
+        if (dz1 > box->zhi) dz1 -= box->Lz;
+        else if (dz1 < box->zlo) dz1 += box->Lz;
+        if (dx2 > box->xhi) dx2 -= box->Lx;
+        else if (dx2 < box->xlo) dx2 += box->Lx;
+        if (dy2 > box->yhi) dy2 -= box->Ly;
+        else if (dy2 < box->ylo) dy2 += box->Ly;
+        if (dz2 > box->zhi) dz2 -= box->Lz;
+        else if (dz2 < box->zlo) dz2 += box->Lz;
+      }
+      if (m_has_angle_params)
+      {
+        k = m_angle_params[angle_type[n]].k;
+        t0 = m_angle_params[angle_type[n]].t0;
+      }
+        
+      double r_sq_1 = dx1*dx1 + dy1*dy1 + dz1*dz1;
+      double r_sq_2 = dx2*dx2 + dy2*dy2 + dz2*dz2;
+      double r_1 = sqrt(r_sq_1);
+      double r_2 = sqrt(r_sq_2);
+      double c = dx1*dx2 + dy1*dy2 + dz1*dz2;
+      c /= r_1*r_2;
       
-    double r_sq_1 = dx1*dx1 + dy1*dy1 + dz1*dz1;
-    double r_sq_2 = dx2*dx2 + dy2*dy2 + dz2*dz2;
-    double r_1 = sqrt(r_sq_1);
-    double r_2 = sqrt(r_sq_2);
-    double c = dx1*dx2 + dy1*dy2 + dz1*dz2;
-    c /= r_1*r_2;
-    
-    if (c > 1.0) c = 1.0;
-    if (c < -1.0) c = -1.0;
-    
-    double s = sqrt(1.0 - c*c);
-    if (s < 1e-7)
-      s = 1e7;
-    else
-      s = 1.0/s;
+      if (c > 1.0) c = 1.0;
+      if (c < -1.0) c = -1.0;
+      
+      double s = sqrt(1.0 - c*c);
+      if (s < 1e-7)
+        s = 1e7;
+      else
+        s = 1.0/s;
 
-    double dtheta = acos(c) - t0;
-    double tk = k * dtheta;
+      double dtheta = acos(c) - t0;
+      double tk = k * dtheta;
 
-    m_potential_energy += 0.5*k*dtheta*dtheta;
-    
-    double aa = -2.0 * tk * s;
-    double a11 = aa*c / r_sq_1;
-    double a12 = -aa / (r_1*r_2);
-    double a22 = aa*c / r_sq_2;
+      if (compute_eng)
+        potential_energy += 0.5*k*dtheta*dtheta;
+      
+      double aa = -2.0 * tk * s;
+      double a11 = aa*c / r_sq_1;
+      double a12 = -aa / (r_1*r_2);
+      double a22 = aa*c / r_sq_2;
 
-    double fi_x = a11*dx1 + a12*dx2;
-    double fi_y = a11*dy1 + a12*dy2;
-    double fi_z = a11*dz1 + a12*dz2;
-    
-    double fk_x = a22*dx2 + a12*dx1;
-    double fk_y = a22*dy2 + a12*dy1;
-    double fk_z = a22*dz2 + a12*dz1;
-    
-    pi.fx += fi_x; pi.fy += fi_y; pi.fz += fi_z;
-    
-    pj.fx += -(fi_x+fk_x); pj.fy += -(fi_y+fk_y); pj.fz += -(fi_z+fk_z);
-    
-    pk.fx += fk_x; pk.fy += fk_y; pk.fz += fk_z;
-    
+      double fi_x = a11*dx1 + a12*dx2;
+      double fi_y = a11*dy1 + a12*dy2;
+      double fi_z = a11*dz1 + a12*dz2;
+      
+      double fk_x = a22*dx2 + a12*dx1;
+      double fk_y = a22*dy2 + a12*dy1;
+      double fk_z = a22*dz2 + a12*dz1;
+      
+      pi.fx += fi_x; pi.fy += fi_y; pi.fz += fi_z;
+      
+      pj.fx += -(fi_x+fk_x); pj.fy += -(fi_y+fk_y); pj.fz += -(fi_z+fk_z);
+      
+      pk.fx += fk_x; pk.fy += fk_y; pk.fz += fk_z;
+    }
   }
+  if (compute_eng)
+    m_potential_energy = potential_energy;
 }
@@ -35,6 +35,7 @@
 #include <string>
 
 #include "system.hpp"
+#include "bonded_engine.hpp"
 
 #include "parse_parameters.hpp"
 
@@ -58,7 +59,8 @@ public:
   //! \param param Contains information about all parameters 
   AnglePotential(SystemPtr sys, MessengerPtr msg, pairs_type& param) : m_system(sys), 
                                                                        m_msg(msg),
-                                                                       m_has_angle_params(false)
+                                                                       m_has_angle_params(false),
+                                                                       m_engine(sys)
                                                                        { }
                                                                                                        
   //! Destructor 
@@ -80,6 +82,7 @@ protected:
   MessengerPtr m_msg;              //!< Handles messages sent to output
   bool m_has_angle_params;         //!< Flag that controls if angle parameters are set
   double m_potential_energy;       //!< Total potential energy
+  BondedEngine m_engine;           //!< Keeps angles sorted and coloured for force evaluation
   
 };
 
@@ -31,34 +31,43 @@
 
 void BondActiveForce::compute()
 {
-  int Nbonds = m_system->num_bonds();
   bool periodic = m_system->get_periodic();
   double f = m_f;
-    
-  for  (int i = 0; i < Nbonds; i++)
+  
+  m_engine.update_bonds();
+  const vector<int>& bond_i = m_engine.bond_i();
+  const vector<int>& bond_j = m_engine.bond_j();
+  const vector<int>& bond_type = m_engine.bond_type();
+  const vector<int>& colour = m_engine.bond_colours();
+  // Bonds of the same colour share no particles, so each colour class can be processed in parallel
+  for (int col = 0; col < m_engine.num_bond_colours(); col++)
   {
-    Bond& b = m_system->get_bond(i);
-    Particle& pi = m_system->get_particle(b.i);
-    Particle& pj = m_system->get_particle(b.j);
-    double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
-    if (periodic)
-      m_system->apply_periodic(dx,dy,dz);
-    if (m_has_bond_params)
+    int begin = colour[col], end = colour[col+1];
+#pragma omp parallel for firstprivate(f) if (end - begin > BONDED_PARALLEL_MIN)
+    for  (int n = begin; n < end; n++)
     {
-      f = m_bond_params[b.type-1].f;
+      Particle& pi = m_system->get_particle(bond_i[n]);
+      Particle& pj = m_system->get_particle(bond_j[n]);
+      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+      if (periodic)
+        m_system->apply_periodic(dx,dy,dz);
+      if (m_has_bond_params)
+      {
+        f = m_bond_params[bond_type[n]].f;
+      }
+        
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      double r = sqrt(r_sq);
+      // Handle force
+      double force_factor = f/r;
+      pi.fx += force_factor*dx;
+      pi.fy += force_factor*dy;
+      pi.fz += force_factor*dz;
+      // Note that both beads get the same force. This is not a pair force and thus 
+      // 3d Newton's law does not hold for the pair of beads.
+      pj.fx += force_factor*dx;
+      pj.fy += force_factor*dy;
+      pj.fz += force_factor*dz;
     }
-      
-    double r_sq = dx*dx + dy*dy + dz*dz;
-    double r = sqrt(r_sq);
-    // Handle force
-    double force_factor = f/r;
-    pi.fx += force_factor*dx;
-    pi.fy += force_factor*dy;
-    pi.fz += force_factor*dz;
-    // Note that both beads get the same force. This is not a pair force and thus 
-    // 3d Newton's law does not hold for the pair of beads.
-    pj.fx += force_factor*dx;
-    pj.fy += force_factor*dy;
-    pj.fz += force_factor*dz;
   }
 }
@@ -31,39 +31,51 @@
 
 void BondFenePotential::compute()
 {
-  int Nbonds = m_system->num_bonds();
-  BoxPtr box = m_system->get_box();
   double k = m_k;
   double r0 = m_r0;
   
-  m_potential_energy = 0.0;
-  for  (int i = 0; i < Nbonds; i++)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  
+  m_engine.update_bonds();
+  const vector<int>& bond_i = m_engine.bond_i();
+  const vector<int>& bond_j = m_engine.bond_j();
+  const vector<int>& bond_type = m_engine.bond_type();
+  const vector<int>& colour = m_engine.bond_colours();
+  double potential_energy = 0.0;
+  // Bonds of the same colour share no particles, so each colour class can be processed in parallel
+  for (int col = 0; col < m_engine.num_bond_colours(); col++)
   {
-    Bond& b = m_system->get_bond(i);
-    Particle& pi = m_system->get_particle(b.i);
-    Particle& pj = m_system->get_particle(b.j);
-    double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
-    m_system->apply_periodic(dx,dy,dz);
-    if (m_has_bond_params)
+    int begin = colour[col], end = colour[col+1];
+#pragma omp parallel for firstprivate(k,r0) reduction(+:potential_energy) if (end - begin > BONDED_PARALLEL_MIN)
+    for  (int n = begin; n < end; n++)
     {
-      k = m_bond_params[b.type-1].k;
-      r0 = m_bond_params[b.type-1].r0;
+      Particle& pi = m_system->get_particle(bond_i[n]);
+      Particle& pj = m_system->get_particle(bond_j[n]);
+      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+      m_system->apply_periodic(dx,dy,dz);
+      if (m_has_bond_params)
+      {
+        k = m_bond_params[bond_type[n]].k;
+        r0 = m_bond_params[bond_type[n]].r0;
+      }
+        
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      // Handle potential 
+      double r0_sq = r0*r0;
+      double fact = 1.0-r_sq/r0_sq;
+      if (compute_eng)
+        potential_energy += -0.5*k*r0_sq*log(fact);
+      // Handle force
+      double force_factor = -k/fact;
+      pi.fx += force_factor*dx;
+      pi.fy += force_factor*dy;
+      pi.fz += force_factor*dz;
+      // Use 3d Newton's law
+      pj.fx -= force_factor*dx;
+      pj.fy -= force_factor*dy;
+      pj.fz -= force_factor*dz;
     }
-      
-    double r_sq = dx*dx + dy*dy + dz*dz;
-    // Handle potential 
-    double r0_sq = r0*r0;
-    double fact = 1.0-r_sq/r0_sq;
-    double potential_energy = -0.5*k*r0_sq*log(fact);
-    m_potential_energy += potential_energy;
-    // Handle force
-    double force_factor = -k/fact;
-    pi.fx += force_factor*dx;
-    pi.fy += force_factor*dy;
-    pi.fz += force_factor*dz;
-    // Use 3d Newton's law
-    pj.fx -= force_factor*dx;
-    pj.fy -= force_factor*dy;
-    pj.fz -= force_factor*dz;
   }
+  if (compute_eng)
+    m_potential_energy = potential_energy;
 }
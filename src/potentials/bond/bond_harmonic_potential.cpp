@@ -31,39 +31,55 @@
 
 void BondHarmonicPotential::compute()
 {
-  int Nbonds = m_system->num_bonds();
-  BoxPtr box = m_system->get_box();
   double k = m_k;
   double l0 = m_l0;
   
-  m_potential_energy = 0.0;
-  for  (int i = 0; i < Nbonds; i++)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
+  
+  m_engine.update_bonds();
+  const vector<int>& bond_i = m_engine.bond_i();
+  const vector<int>& bond_j = m_engine.bond_j();
+  const vector<int>& bond_type = m_engine.bond_type();
+  const vector<int>& colour = m_engine.bond_colours();
+  double potential_energy = 0.0;
+  // Bonds of the same colour share no particles, so each colour class can be processed in parallel
+  for (int col = 0; col < m_engine.num_bond_colours(); col++)
   {
-    Bond& b = m_system->get_bond(i);
-    Particle& pi = m_system->get_particle(b.i);
-    Particle& pj = m_system->get_particle(b.j);
-    double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
-    m_system->apply_periodic(dx,dy,dz);
-    if (m_has_bond_params)
+    int begin = colour[col], end = colour[col+1];
+#pragma omp parallel for firstprivate(k,l0) reduction(+:potential_energy) if (end - begin > BONDED_PARALLEL_MIN)
+    for  (int n = begin; n < end; n++)
     {
-      k = m_bond_params[b.type-1].k;
-      l0 = m_bond_params[b.type-1].l0;
-     }
-      
-    double r_sq = dx*dx + dy*dy + dz*dz;
-    double r = sqrt(r_sq);
-    double dl = r - l0;
-    // Handle potential 
-    double potential_energy = 0.5*k*dl*dl;
-    m_potential_energy += potential_energy;
-    // Handle force
-    double force_factor = k*dl/r;
-    pi.fx += force_factor*dx;
-    pi.fy += force_factor*dy;
-    pi.fz += force_factor*dz;
-    // Use 3d Newton's law
-    pj.fx -= force_factor*dx;
-    pj.fy -= force_factor*dy;
-    pj.fz -= force_factor*dz;
+      Particle& pi = m_system->get_particle(bond_i[n]);
+      Particle& pj = m_system->get_particle(bond_j[n]);
+      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+      m_system->apply_periodic(dx,dy,dz);
+      if (m_has_bond_params)
+      {
+        k = m_bond_params[bond_type[n]].k;
+        l0 = m_bond_params[bond_type[n]].l0;
+      }
+        
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      double r = sqrt(r_sq);
+      double dl = r - l0;
+      // Handle potential 
+      if (compute_eng)
+        potential_energy += 0.5*k*dl*dl;
+      // Handle force
+      double force_factor = k*dl/r;
+      pi.fx += force_factor*dx;
+      pi.fy += force_factor*dy;
+      pi.fz += force_factor*dz;
+      // Use 3d Newton's law
+      pj.fx -= force_factor*dx;
+      pj.fy -= force_factor*dy;
+      pj.fz -= force_factor*dz;
+      // Accumulate bond virial (note that dx points from i to j)
+      if (compute_stress)
+        m_system->add_pair_stress(bond_i[n], bond_j[n], -dx, -dy, -dz, force_factor*dx, force_factor*dy, force_factor*dz);
+    }
   }
+  if (compute_eng)
+    m_potential_energy = potential_energy;
 }
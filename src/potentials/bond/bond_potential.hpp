@@ -35,6 +35,7 @@
 #include <string>
 
 #include "system.hpp"
+#include "bonded_engine.hpp"
 
 #include "parse_parameters.hpp"
 
@@ -59,7 +60,8 @@ public:
   BondPotential(SystemPtr sys, MessengerPtr msg, pairs_type& param) : m_system(sys), 
                                                                       m_msg(msg),
                                                                       m_has_bond_params(false),
-                                                                      m_use_particle_radii(false)
+                                                                      m_use_particle_radii(false),
+                                                                      m_engine(sys)
                                                                       { }
                                                                                                        
   //! Destructor 
@@ -82,6 +84,7 @@ protected:
   bool m_has_bond_params;         //!< Flag that controls if bond parameters are set
   double m_potential_energy;       //!< Total potential energy
   bool m_use_particle_radii;       //!< If true, base native bond length on particle radii
+  BondedEngine m_engine;           //!< Keeps bonds sorted and coloured for force evaluation
   
 };
 
@@ -0,0 +1,152 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file bonded_engine.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of BondedEngine class
+ */ 
+
+#include "bonded_engine.hpp"
+
+using std::make_pair;
+using std::pair;
+using std::sort;
+
+/*! Bonds are sorted by the index of the first and then second particle. Sorted bonds are 
+ *  coloured and stored colour by colour. 
+ */
+void BondedEngine::update_bonds()
+{
+  int Nbonds = m_system->num_bonds();
+  if (m_system->get_topology_version() == m_bond_version && Nbonds == m_num_bonds)
+    return;
+  vector<pair<pair<int,int>,int> > sorted(Nbonds);
+  for (int i = 0; i < Nbonds; i++)
+  {
+    Bond& b = m_system->get_bond(i);
+    sorted[i] = make_pair(make_pair(b.i,b.j),i);
+  }
+  sort(sorted.begin(), sorted.end());
+  vector<int> parts(2*Nbonds);
+  for (int i = 0; i < Nbonds; i++)
+  {
+    parts[2*i]   = sorted[i].first.first;
+    parts[2*i+1] = sorted[i].first.second;
+  }
+  vector<int> order;
+  this->colour(parts, 2, order, m_bond_colour);
+  m_bond_i.resize(Nbonds);  m_bond_j.resize(Nbonds);  m_bond_type.resize(Nbonds);
+  for (int i = 0; i < Nbonds; i++)
+  {
+    Bond& b = m_system->get_bond(sorted[order[i]].second);
+    m_bond_i[i] = b.i;
+    m_bond_j[i] = b.j;
+    m_bond_type[i] = b.type - 1;
+  }
+  m_bond_version = m_system->get_topology_version();
+  m_num_bonds = Nbonds;
+}
+
+/*! Angles are sorted by the index of the first, then middle and then last particle. Sorted angles are 
+ *  coloured and stored colour by colour. 
+ */
+void BondedEngine::update_angles()
+{
+  int Nangles = m_system->num_angles();
+  if (m_system->get_topology_version() == m_angle_version && Nangles == m_num_angles)
+    return;
+  vector<pair<pair<int,pair<int,int> >,int> > sorted(Nangles);
+  for (int i = 0; i < Nangles; i++)
+  {
+    Angle& a = m_system->get_angle(i);
+    sorted[i] = make_pair(make_pair(a.i,make_pair(a.j,a.k)),i);
+  }
+  sort(sorted.begin(), sorted.end());
+  vector<int> parts(3*Nangles);
+  for (int i = 0; i < Nangles; i++)
+  {
+    parts[3*i]   = sorted[i].first.first;
+    parts[3*i+1] = sorted[i].first.second.first;
+    parts[3*i+2] = sorted[i].first.second.second;
+  }
+  vector<int> order;
+  this->colour(parts, 3, order, m_angle_colour);
+  m_angle_i.resize(Nangles);  m_angle_j.resize(Nangles);  m_angle_k.resize(Nangles);  m_angle_type.resize(Nangles);
+  for (int i = 0; i < Nangles; i++)
+  {
+    Angle& a = m_system->get_angle(sorted[order[i]].second);
+    m_angle_i[i] = a.i;
+    m_angle_j[i] = a.j;
+    m_angle_k[i] = a.k;
+    m_angle_type[i] = a.type - 1;
+  }
+  m_angle_version = m_system->get_topology_version();
+  m_num_angles = Nangles;
+}
+
+/*! Each interaction gets the smallest colour not yet used by any of its particles. For chains and 
+ *  networks of low connectivity this produces only a handful of colours.
+ *  \param parts particles involved in each interaction (m consecutive entries per interaction)
+ *  \param m number of particles per interaction
+ *  \param order on return, interactions ordered by colour (stable within a colour)
+ *  \param offsets on return, offsets of colour classes in order
+ */
+void BondedEngine::colour(const vector<int>& parts, int m, vector<int>& order, vector<int>& offsets)
+{
+  int n = parts.size()/m;
+  int N = m_system->size();
+  vector<vector<int> > used(N);   // colours already taken by each particle
+  vector<int> col(n);
+  int ncol = 0;
+  for (int b = 0; b < n; b++)
+  {
+    int c = 0;
+    bool free = false;
+    while (!free)
+    {
+      free = true;
+      for (int k = 0; k < m && free; k++)
+      {
+        vector<int>& u = used[parts[m*b+k]];
+        if (find(u.begin(), u.end(), c) != u.end())
+          free = false;
+      }
+      if (!free) c++;
+    }
+    col[b] = c;
+    for (int k = 0; k < m; k++)
+      used[parts[m*b+k]].push_back(c);
+    if (c + 1 > ncol) ncol = c + 1;
+  }
+  // Stable counting sort by colour 
+  offsets.assign(ncol+1,0);
+  for (int b = 0; b < n; b++)
+    offsets[col[b]+1]++;
+  for (int c = 0; c < ncol; c++)
+    offsets[c+1] += offsets[c];
+  vector<int> pos(offsets.begin(), offsets.end()-1);
+  order.resize(n);
+  for (int b = 0; b < n; b++)
+    order[pos[col[b]]++] = b;
+}
@@ -0,0 +1,123 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file bonded_engine.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of BondedEngine class
+ */ 
+
+#ifndef __BONDED_ENGINE_HPP__
+#define __BONDED_ENGINE_HPP__
+
+#include <vector>
+#include <algorithm>
+
+#include "system.hpp"
+
+using std::vector;
+
+//! Do not spawn threads for colour classes smaller than this
+const int BONDED_PARALLEL_MIN = 2048;
+
+/*! BondedEngine keeps bonds and angles in the order best suited for force evaluation.
+ *  Bonds (angles) are sorted by the index of their first particle and stored as contiguous 
+ *  arrays of particle indices and (zero based) types, so that the force loop streams through memory. 
+ *  In addition, bonds (angles) are greedily coloured such that no two bonds (angles) of the same 
+ *  colour share a particle. Each colour class is therefore free of write conflicts and can be 
+ *  processed in parallel (if compiled with OpenMP). Ordering within each colour class is fixed,
+ *  so forces do not depend on the number of threads.
+ *  
+ *  Cached data is rebuilt automatically whenever the system topology version changes, i.e. when 
+ *  particles, bonds or angles are added or removed.
+ */
+class BondedEngine
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to the System object
+  BondedEngine(SystemPtr sys) : m_system(sys), m_bond_version(-1), m_angle_version(-1), m_num_bonds(-1), m_num_angles(-1)  { }
+  
+  //! Rebuild bond data if topology has changed since the last call
+  void update_bonds();
+  
+  //! Rebuild angle data if topology has changed since the last call
+  void update_angles();
+  
+  //! Get number of bond colours
+  int num_bond_colours() { return m_bond_colour.size() - 1; }
+  
+  //! Get number of angle colours
+  int num_angle_colours() { return m_angle_colour.size() - 1; }
+  
+  //! Get offsets of bond colour classes (bonds of colour c are stored between bond_colours()[c] and bond_colours()[c+1])
+  const vector<int>& bond_colours() { return m_bond_colour; }
+  
+  //! Get offsets of angle colour classes (angles of colour c are stored between angle_colours()[c] and angle_colours()[c+1])
+  const vector<int>& angle_colours() { return m_angle_colour; }
+  
+  //! Get indices of the first particle in each bond
+  const vector<int>& bond_i() { return m_bond_i; }
+  
+  //! Get indices of the second particle in each bond
+  const vector<int>& bond_j() { return m_bond_j; }
+  
+  //! Get (zero based) bond types
+  const vector<int>& bond_type() { return m_bond_type; }
+  
+  //! Get indices of the first particle in each angle
+  const vector<int>& angle_i() { return m_angle_i; }
+  
+  //! Get indices of the middle particle in each angle
+  const vector<int>& angle_j() { return m_angle_j; }
+  
+  //! Get indices of the last particle in each angle
+  const vector<int>& angle_k() { return m_angle_k; }
+  
+  //! Get (zero based) angle types
+  const vector<int>& angle_type() { return m_angle_type; }
+  
+private:
+  
+  SystemPtr m_system;          //!< Pointer to the System object
+  int m_bond_version;          //!< Topology version for which bond data was built
+  int m_angle_version;         //!< Topology version for which angle data was built
+  int m_num_bonds;             //!< Number of bonds for which bond data was built
+  int m_num_angles;            //!< Number of angles for which angle data was built
+  vector<int> m_bond_colour;   //!< Offsets of bond colour classes
+  vector<int> m_bond_i;        //!< First particle of each bond
+  vector<int> m_bond_j;        //!< Second particle of each bond
+  vector<int> m_bond_type;     //!< Type of each bond (zero based)
+  vector<int> m_angle_colour;  //!< Offsets of angle colour classes
+  vector<int> m_angle_i;       //!< First particle of each angle
+  vector<int> m_angle_j;       //!< Middle particle of each angle
+  vector<int> m_angle_k;       //!< Last particle of each angle
+  vector<int> m_angle_type;    //!< Type of each angle (zero based)
+  
+  //! Greedy colouring of interactions given as lists of particles 
+  void colour(const vector<int>&, int, vector<int>&, vector<int>&);
+  
+};
+
+#endif
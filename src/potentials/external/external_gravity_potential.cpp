@@ -35,13 +35,17 @@ void ExternalGravityPotential::compute()
   int N = m_system->size();
   double g = m_g;
 
-  m_potential_energy = 0.0;
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for (int i = 0; i < N; i++)
   {
     Particle& p = m_system->get_particle(i);
     if (m_has_params)
       g = m_type_params[p.get_type()-1]["g"];
-    m_potential_energy += g*p.z;
+    if (compute_eng)
+      m_potential_energy += g*p.z;
     p.fz -= g;
   }
 }
@@ -36,7 +36,10 @@ void ExternalHarmonicPotential::compute()
   double k = m_k;
   double z0 = m_z0;
   
-  m_potential_energy = 0.0;
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for (int i = 0; i < N; i++)
   {
     Particle& p = m_system->get_particle(i);
@@ -46,7 +49,8 @@ void ExternalHarmonicPotential::compute()
       z0 = m_type_params[p.get_type()-1]["z0"];
     }
     double dz = p.z - z0;
-    m_potential_energy += 0.5*k*dz*dz;
+    if (compute_eng)
+      m_potential_energy += 0.5*k*dz*dz;
     p.fz -= k*dz;
   }
 }
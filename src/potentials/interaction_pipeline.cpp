@@ -0,0 +1,103 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file interaction_pipeline.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of InteractionPipeline class
+ */ 
+
+#include "interaction_pipeline.hpp"
+
+/*! Forces and torques of all fusable pair interactions are computed in a single
+ *  sweep over the neighbour list. All other interactions are computed afterwards.
+ *  \param dt step size (used to phase in particles)
+ */
+void InteractionPipeline::compute(double dt)
+{
+  m_pair_pot.clear();
+  m_pair_align.clear();
+  if (m_potential)
+    m_potential->get_fusable_pair_potentials(m_pair_pot);
+  if (m_align)
+    m_align->get_fusable_pair_aligners(m_pair_align);
+  int n_pot = m_pair_pot.size(), n_align = m_pair_align.size();
+  
+  // Nothing to share, use the standard force and torque computation
+  if (n_pot + n_align < 2)
+  {
+    if (m_potential)
+      m_potential->compute(dt);
+    if (m_align)
+      m_align->compute();
+    return;
+  }
+  
+  int N = m_system->size();
+  for (int k = 0; k < n_pot; k++)
+    m_pair_pot[k]->begin_fused(dt);
+  for (int k = 0; k < n_align; k++)
+    m_pair_align[k]->begin_fused();
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    vector<int>& neigh = m_nlist->get_neighbours(i);
+    for (unsigned int j = 0; j < neigh.size(); j++)
+    {
+      int nj = neigh[j];
+      Particle& pj = m_system->get_particle(nj);
+      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+      m_system->apply_periodic(dx,dy,dz);
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      for (int k = 0; k < n_pot; k++)
+        m_pair_pot[k]->fused_pair(i, nj, pi, pj, dx, dy, dz, r_sq);
+      for (int k = 0; k < n_align; k++)
+        m_pair_align[k]->fused_pair(i, nj, pi, pj, dx, dy, dz, r_sq);
+    }
+  }
+  for (int k = 0; k < n_pot; k++)
+    m_pair_pot[k]->end_fused();
+  for (int k = 0; k < n_align; k++)
+    m_pair_align[k]->end_fused();
+  
+  // Handle everything that has not been fused
+  if (m_potential)
+    m_potential->compute(dt, true);
+  if (m_align)
+    m_align->compute(true);
+}
+
+/*! Forces and torques are computed only once per time step, for the configuration at the 
+ *  beginning of the step. Subsequent calls within the same step return immediately and integrators
+ *  reuse forces and torques stored with particles.
+ *  \param dt step size (used to phase in particles)
+ */
+void InteractionPipeline::compute_shared(double dt)
+{
+  if (m_system->forces_valid())
+    return;
+  m_system->reset_forces();
+  m_system->reset_torques();
+  this->compute(dt);
+  m_system->set_forces_valid();
+}
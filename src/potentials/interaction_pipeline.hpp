@@ -0,0 +1,93 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file interaction_pipeline.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of InteractionPipeline class
+ */ 
+
+#ifndef __INTERACTION_PIPELINE_HPP__
+#define __INTERACTION_PIPELINE_HPP__
+
+#include <vector>
+
+#include "system.hpp"
+#include "neighbour_list.hpp"
+#include "potential.hpp"
+#include "aligner.hpp"
+
+using std::vector;
+
+/*! InteractionPipeline computes forces and torques in a single step. Pair potentials and 
+ *  pair aligners that support it (see PairPotential::fusable() and PairAlign::fusable()) and are
+ *  updated every time step share one sweep over the neighbour list. Distance between each pair of neighbours 
+ *  (with periodic boundary conditions applied) is computed once and handed to all of them, so that forces and 
+ *  torques are accumulated together. Remaining pair interactions, as well as external, bond and angle 
+ *  interactions are then evaluated in the usual way. 
+ *  
+ *  If there are fewer than two fusable pair interactions, this class simply calls Potential::compute() and 
+ *  Aligner::compute().
+ *  
+ *  Integrators that only need forces and torques in the configuration at the beginning of the time step 
+ *  (e.g., Brownian dynamics) use compute_shared(). Forces and torques are then evaluated by the first such integrator
+ *  in the step and reused by all others (e.g., when different groups are integrated by different integrators). 
+ *  Validity is tracked by System through a stamp holding the time step and the topology version at which forces were 
+ *  computed. Any reset of forces or torques (e.g., by an integrator that evaluates forces in the middle of a step) 
+ *  invalidates it.
+ */
+class InteractionPipeline
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to the System object
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  InteractionPipeline(SystemPtr sys, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist) : m_system(sys), 
+                                                                                                     m_potential(pot), 
+                                                                                                     m_align(align), 
+                                                                                                     m_nlist(nlist) 
+                                                                                                     { }
+  
+  //! Compute all forces and torques in the current configuration
+  void compute(double);
+  
+  //! Compute all forces and torques at the beginning of the step, or reuse them if they have already been computed
+  void compute_shared(double);
+  
+private:
+  
+  SystemPtr m_system;                  //!< Pointer to the System object
+  PotentialPtr m_potential;            //!< Pointer to the interaction handler 
+  AlignerPtr m_align;                  //!< Pointer to alignment handler
+  NeighbourListPtr m_nlist;            //!< Pointer to the neighbour list object
+  vector<PairPotentialPtr> m_pair_pot; //!< Pair potentials evaluated in the fused traversal
+  vector<PairAlignPtr> m_pair_align;   //!< Pair aligners evaluated in the fused traversal
+  
+};
+
+typedef shared_ptr<InteractionPipeline> InteractionPipelinePtr;
+
+#endif
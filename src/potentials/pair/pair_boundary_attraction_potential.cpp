@@ -38,6 +38,7 @@ void PairBoundaryAttractionPotential::compute(double dt)
   double wc = m_wc;
   int N = m_system->size();
   Mesh& mesh = m_system->get_mesh();
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
   
   if (m_system->compute_per_particle_energy())
   {
@@ -48,7 +49,8 @@ void PairBoundaryAttractionPotential::compute(double dt)
     }
   }
   
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for (int v = 0; v < mesh.size(); v++)
   {
     Vertex& Vi = mesh.get_vertices()[v];
@@ -72,9 +74,13 @@ void PairBoundaryAttractionPotential::compute(double dt)
           double r = sqrt(dx*dx + dy*dy + dz*dz);
           if (r >= rc && r <= (rc+wc))
           {
-            double cos_fac = cos(0.5*M_PI*(r-rc)/wc);
-            double potential_energy = -epsilon*cos_fac*cos_fac;
-            m_potential_energy += potential_energy;
+            double potential_energy = 0.0;
+            if (compute_eng)
+            {
+              double cos_fac = cos(0.5*M_PI*(r-rc)/wc);
+              potential_energy = -epsilon*cos_fac*cos_fac;
+              m_potential_energy += potential_energy;
+            }
             double fact = -0.5*M_PI*epsilon/wc*sin(M_PI*(r-rc)/wc)/r;
             pi.fx += fact*dx;
             pi.fy += fact*dy;
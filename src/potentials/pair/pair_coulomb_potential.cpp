@@ -30,6 +30,20 @@
 #include "pair_coulomb_potential.hpp"
 
 void PairCoulombPotential::compute(double dt)
+{
+  if (m_pppm)
+  {
+    this->compute_real_space(dt);
+    this->compute_reciprocal();
+  }
+  else if (m_treecode)
+    this->compute_tree(dt);
+  else
+    this->compute_direct(dt);
+}
+
+//! Sums over all pairs of particles. 
+void PairCoulombPotential::compute_direct(double dt)
 {
   int N = m_system->size();
   double sigma = m_sigma;
@@ -38,6 +52,9 @@ void PairCoulombPotential::compute(double dt)
   double phase_fact_i = 1.0;  // phase in factor for particle i
   double phase_fact_j = 1.0;  // phase in factor for particle j
   double phase_fact = 1.0;    // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
   
   if (m_system->compute_per_particle_energy())
   {
@@ -48,18 +65,19 @@ void PairCoulombPotential::compute(double dt)
     }
   }
   
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
     if (m_phase_in)
-      phase_fact_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
+      phase_fact_i = 0.5*(1.0 + phase_in[i]);
     for (int j = i+1; j < N; j++)
     {
       Particle& pj = m_system->get_particle(j);
       if (m_phase_in)
       {
-        phase_fact_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
+        phase_fact_j = 0.5*(1.0 + phase_in[j]);
         // Determine global phase in factor: particles start at 0.5 strength (both daughters of a division replace the mother)
         // Except for the interaction between daughters which starts at 0
         if ( phase_fact_i < 1.0 && phase_fact_j < 1.0)
@@ -81,8 +99,16 @@ void PairCoulombPotential::compute(double dt)
       double inv_r_sq = sigma_sq/r_sq;
       double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
       // Handle potential 
-      double potential_energy = phase_fact*(alpha/r + 4.0*fabs(alpha)*inv_r_6*inv_r_6);
-      m_potential_energy += potential_energy;
+      if (compute_eng)
+      {
+        double potential_energy = phase_fact*(alpha/r + 4.0*fabs(alpha)*inv_r_6*inv_r_6);
+        m_potential_energy += potential_energy;
+        if (m_system->compute_per_particle_energy())
+        {
+          pi.add_pot_energy("coulomb",potential_energy);
+          pj.add_pot_energy("coulomb",potential_energy);
+        }
+      }
       // Handle force
       double r_3 = r*r_sq;
       double force_factor = phase_fact*(alpha/r_3 + 48.0*fabs(alpha)*inv_r_6*inv_r_6*inv_r_sq);
@@ -93,11 +119,464 @@ void PairCoulombPotential::compute(double dt)
       pj.fx += force_factor*dx;
       pj.fy += force_factor*dy;
       pj.fz += force_factor*dz;
+      // Accumulate pair virial
+      if (compute_stress)
+        m_system->add_pair_stress(i, j, dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
+    }
+  }
+}
+
+//! Short-range part of the PPPM method. Only pairs within real space cutoff
+//! are considered, using the neighbour list. 
+void PairCoulombPotential::compute_real_space(double dt)
+{
+  int N = m_system->size();
+  double sigma = m_sigma;
+  double alpha = m_alpha;
+  double sigma_sq = sigma*sigma;
+  double rcut_sq = m_rcut*m_rcut;
+  double beta = m_beta;
+  double two_beta_over_sqrt_pi = 2.0*beta/sqrt(M_PI);
+  double phase_fact_i = 1.0;  // phase in factor for particle i
+  double phase_fact_j = 1.0;  // phase in factor for particle j
+  double phase_fact = 1.0;    // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
+  
+  if (m_system->compute_per_particle_energy())
+  {
+    for  (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      p.set_pot_energy("coulomb",0.0);
+    }
+  }
+  
+  if (compute_eng)
+    m_potential_energy = 0.0;
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    double qi = m_charge[pi.get_type() - 1];
+    if (m_phase_in)
+      phase_fact_i = 0.5*(1.0 + phase_in[i]);
+    vector<int>& neigh = m_nlist->get_neighbours(i);
+    for (unsigned int j = 0; j < neigh.size(); j++)
+    {
+      Particle& pj = m_system->get_particle(neigh[j]);
+      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+      m_system->apply_periodic(dx,dy,dz);
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      if (r_sq > rcut_sq) continue;
+      if (m_phase_in)
+      {
+        phase_fact_j = 0.5*(1.0 + phase_in[neigh[j]]);
+        // Determine global phase in factor: particles start at 0.5 strength (both daughters of a division replace the mother)
+        // Except for the interaction between daughters which starts at 0
+        if ( phase_fact_i < 1.0 && phase_fact_j < 1.0)
+          phase_fact=phase_fact_i + phase_fact_j - 1.0;
+        else 
+          phase_fact = phase_fact_i*phase_fact_j;
+      }
+      if (m_has_pair_params)
+      {
+        int pi_t = pi.get_type() - 1, pj_t = pj.get_type() - 1;
+        alpha = m_pair_params[pi_t][pj_t].alpha;
+        sigma = m_pair_params[pi_t][pj_t].sigma;
+        sigma_sq = sigma*sigma;
+      }
+      double qq = m_alpha*qi*m_charge[pj.get_type() - 1];
+      double r = sqrt(r_sq);
+      double inv_r_sq = sigma_sq/r_sq;
+      double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
+      double erfc_fact = erfc(beta*r);
+      // Handle potential 
+      if (compute_eng)
+      {
+        double potential_energy = phase_fact*(qq*erfc_fact/r + 4.0*fabs(alpha)*inv_r_6*inv_r_6);
+        m_potential_energy += potential_energy;
+        if (m_system->compute_per_particle_energy())
+        {
+          pi.add_pot_energy("coulomb",potential_energy);
+          pj.add_pot_energy("coulomb",potential_energy);
+        }
+      }
+      // Handle force
+      double force_factor = phase_fact*(qq*(erfc_fact/r + two_beta_over_sqrt_pi*exp(-beta*beta*r_sq))/r_sq + 48.0*fabs(alpha)*inv_r_6*inv_r_6/r_sq);
+      pi.fx -= force_factor*dx;
+      pi.fy -= force_factor*dy;
+      pi.fz -= force_factor*dz;
+      // Use 3d Newton's law
+      pj.fx += force_factor*dx;
+      pj.fy += force_factor*dy;
+      pj.fz += force_factor*dz;
+      // Accumulate pair virial
+      if (compute_stress)
+        m_system->add_pair_stress(i, neigh[j], dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
+    }
+  }
+}
+
+/*! Treecode evaluation for non-periodic systems. Short-range repulsive part is computed 
+ *  using the neighbour list, while the electrostatic part is obtained from the potential 
+ *  and field each particle feels, which are computed using the octree. 
+ */
+void PairCoulombPotential::compute_tree(double dt)
+{
+  int N = m_system->size();
+  double sigma = m_sigma;
+  double alpha = m_alpha;
+  double sigma_sq = sigma*sigma;
+  double phase_fact_i = 1.0;  // phase in factor for particle i
+  double phase_fact_j = 1.0;  // phase in factor for particle j
+  double phase_fact = 1.0;    // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
+  
+  if (m_system->compute_per_particle_energy())
+  {
+    for  (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      p.set_pot_energy("coulomb",0.0);
+    }
+  }
+  
+  if (compute_eng)
+    m_potential_energy = 0.0;
+  // Repulsive part
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    if (m_phase_in)
+      phase_fact_i = 0.5*(1.0 + phase_in[i]);
+    vector<int>& neigh = m_nlist->get_neighbours(i);
+    for (unsigned int j = 0; j < neigh.size(); j++)
+    {
+      Particle& pj = m_system->get_particle(neigh[j]);
+      if (m_phase_in)
+      {
+        phase_fact_j = 0.5*(1.0 + phase_in[neigh[j]]);
+        if ( phase_fact_i < 1.0 && phase_fact_j < 1.0)
+          phase_fact=phase_fact_i + phase_fact_j - 1.0;
+        else 
+          phase_fact = phase_fact_i*phase_fact_j;
+      }
+      if (m_has_pair_params)
+      {
+        int pi_t = pi.get_type() - 1, pj_t = pj.get_type() - 1;
+        alpha = m_pair_params[pi_t][pj_t].alpha;
+        sigma = m_pair_params[pi_t][pj_t].sigma;
+        sigma_sq = sigma*sigma;
+      }
+      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      double inv_r_sq = sigma_sq/r_sq;
+      double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
+      if (compute_eng)
+      {
+        double potential_energy = phase_fact*4.0*fabs(alpha)*inv_r_6*inv_r_6;
+        m_potential_energy += potential_energy;
+        if (m_system->compute_per_particle_energy())
+        {
+          pi.add_pot_energy("coulomb",potential_energy);
+          pj.add_pot_energy("coulomb",potential_energy);
+        }
+      }
+      double force_factor = phase_fact*48.0*fabs(alpha)*inv_r_6*inv_r_6/r_sq;
+      pi.fx -= force_factor*dx;
+      pi.fy -= force_factor*dy;
+      pi.fz -= force_factor*dz;
+      pj.fx += force_factor*dx;
+      pj.fy += force_factor*dy;
+      pj.fz += force_factor*dz;
+      // Accumulate pair virial
+      if (compute_stress)
+        m_system->add_pair_stress(i, neigh[j], dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
+    }
+  }
+  
+  // Electrostatic part
+  m_q.resize(N);
+  for (int i = 0; i < N; i++)
+    m_q[i] = m_charge[m_system->get_particle(i).get_type() - 1];
+  m_octree->build(m_q);
+  m_octree->compute_field(0.0, m_phi, m_ex, m_ey, m_ez);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    double fact = m_alpha*m_q[i];
+    p.fx += fact*m_ex[i];
+    p.fy += fact*m_ey[i];
+    p.fz += fact*m_ez[i];
+    if (compute_eng)
+    {
+      m_potential_energy += 0.5*fact*m_phi[i];
       if (m_system->compute_per_particle_energy())
+        p.add_pot_energy("coulomb",fact*m_phi[i]);
+    }
+  }
+}
+
+/*! Long-range part of the PPPM method computed using the smooth particle mesh Ewald 
+ *  approach (U. Essmann, et al., J. Chem. Phys. 103, 8577 (1995)). Charges are spread 
+ *  onto the mesh with B-splines, convolved with the influence function in the Fourier space
+ *  and forces are obtained by analytically differentiating the B-splines. 
+ */
+void PairCoulombPotential::compute_reciprocal()
+{
+  int N = m_system->size();
+  int n = m_order;
+  BoxPtr box = m_system->get_box();
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  double lo[3] = { box->xlo, box->ylo, box->zlo };
+  double L[3] = { box->Lx, box->Ly, box->Lz };
+  int Kx = m_mesh[0], Ky = m_mesh[1], Kz = m_mesh[2];
+  
+  if (L[0] != m_mesh_L[0] || L[1] != m_mesh_L[1] || L[2] != m_mesh_L[2])
+    this->compute_influence_function();
+  
+  m_theta.resize(3*n*N);
+  m_dtheta.resize(3*n*N);
+  m_mesh_idx.resize(3*N);
+  std::fill(m_grid.begin(), m_grid.end(), Complex(0.0,0.0));
+  
+  // Spread charges onto the mesh
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    double r[3] = { p.x, p.y, p.z };
+    for (int d = 0; d < 3; d++)
+    {
+      double u = m_mesh[d]*(r[d] - lo[d])/L[d];
+      u -= m_mesh[d]*floor(u/m_mesh[d]);
+      int k0 = static_cast<int>(u);
+      this->bspline(u - k0, &m_theta[(3*i+d)*n], &m_dtheta[(3*i+d)*n]);
+      m_mesh_idx[3*i+d] = k0 - n + 1 + m_mesh[d];   // kept positive for the modulo below
+    }
+    double q = m_charge[p.get_type() - 1];
+    if (q == 0.0) continue;
+    double* tx = &m_theta[3*i*n];
+    double* ty = &m_theta[(3*i+1)*n];
+    double* tz = &m_theta[(3*i+2)*n];
+    for (int a = 0; a < n; a++)
+    {
+      int ix = (m_mesh_idx[3*i] + a) % Kx;
+      for (int b = 0; b < n; b++)
       {
-        pi.add_pot_energy("coulomb",potential_energy);
-        pj.add_pot_energy("coulomb",potential_energy);
+        int iy = (m_mesh_idx[3*i+1] + b) % Ky;
+        double qxy = q*tx[a]*ty[b];
+        for (int c = 0; c < n; c++)
+        {
+          int iz = (m_mesh_idx[3*i+2] + c) % Kz;
+          m_grid[(ix*Ky + iy)*Kz + iz] += qxy*tz[c];
+        }
       }
     }
   }
+  
+  m_fft->forward(m_grid);
+  double e_rec = 0.0;
+  for (unsigned int k = 0; k < m_grid.size(); k++)
+  {
+    if (compute_eng)
+      e_rec += m_influence[k]*norm(m_grid[k]);
+    m_grid[k] *= m_influence[k];
+  }
+  m_fft->backward(m_grid);
+  
+  // Interpolate forces back to particles 
+  double self_fact = 2.0*m_beta/sqrt(M_PI);
+  double q_sum = 0.0, q_sq_sum = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    double q = m_charge[p.get_type() - 1];
+    if (q == 0.0) continue;
+    double* tx = &m_theta[3*i*n];
+    double* ty = &m_theta[(3*i+1)*n];
+    double* tz = &m_theta[(3*i+2)*n];
+    double* dtx = &m_dtheta[3*i*n];
+    double* dty = &m_dtheta[(3*i+1)*n];
+    double* dtz = &m_dtheta[(3*i+2)*n];
+    double fx = 0.0, fy = 0.0, fz = 0.0, phi = 0.0;
+    for (int a = 0; a < n; a++)
+    {
+      int ix = (m_mesh_idx[3*i] + a) % Kx;
+      for (int b = 0; b < n; b++)
+      {
+        int iy = (m_mesh_idx[3*i+1] + b) % Ky;
+        for (int c = 0; c < n; c++)
+        {
+          int iz = (m_mesh_idx[3*i+2] + c) % Kz;
+          double g = m_grid[(ix*Ky + iy)*Kz + iz].real();
+          fx += dtx[a]*ty[b]*tz[c]*g;
+          fy += tx[a]*dty[b]*tz[c]*g;
+          fz += tx[a]*ty[b]*dtz[c]*g;
+          phi += tx[a]*ty[b]*tz[c]*g;
+        }
+      }
+    }
+    double fact = m_alpha*q;
+    p.fx -= fact*Kx/L[0]*fx;
+    p.fy -= fact*Ky/L[1]*fy;
+    p.fz -= fact*Kz/L[2]*fz;
+    if (compute_eng && m_system->compute_per_particle_energy())
+      p.add_pot_energy("coulomb",fact*(phi - self_fact*q));
+    q_sum += q;
+    q_sq_sum += q*q;
+  }
+  
+  if (compute_eng)
+  {
+    double V = L[0]*L[1]*L[2];
+    // Reciprocal sum, self-interaction and neutralising background (for non-neutral systems)
+    m_potential_energy += m_alpha*(0.5*e_rec - 0.5*self_fact*q_sq_sum - 0.5*M_PI*q_sum*q_sum/(m_beta*m_beta*V));
+  }
+}
+
+/*! Splitting parameter is chosen such that erfc(beta*rcut) equals the requested accuracy. 
+ *  Unless set by the user, number of mesh points in each direction is the smallest power of 2 
+ *  for which the B-spline interpolation error, estimated as \f$ C\left(\beta h\right)^p \f$ with mesh spacing \f$ h \f$, 
+ *  assignment order \f$ p \f$ and empirical prefactor \f$ C \approx 0.03 \f$, does not exceed the accuracy and 
+ *  which resolves all wave vectors for which the Ewald reciprocal sum terms are larger than the accuracy. 
+ */
+void PairCoulombPotential::setup_pppm()
+{
+  BoxPtr box = m_system->get_box();
+  double L[3] = { box->Lx, box->Ly, box->Lz };
+  
+  if (2.0*m_rcut > std::min(L[0], std::min(L[1], L[2])))
+  {
+    m_msg->msg(Messenger::ERROR,"Real space cutoff for PPPM Coulomb pair potential has to be smaller than half of the box size.");
+    throw runtime_error("PPPM real space cutoff too large.");
+  }
+  // Bisect erfc(x) = accuracy
+  double x_lo = 0.0, x_hi = 10.0;
+  while (x_hi - x_lo > 1e-10)
+  {
+    double x = 0.5*(x_lo + x_hi);
+    if (erfc(x) > m_accuracy) x_lo = x;
+    else x_hi = x;
+  }
+  m_beta = 0.5*(x_lo + x_hi)/m_rcut;
+  m_msg->msg(Messenger::INFO,"Ewald splitting parameter for PPPM Coulomb pair potential is set to "+lexical_cast<string>(m_beta)+".");
+  m_msg->write_config("potential.pair.coulomb.beta",lexical_cast<string>(m_beta));
+  
+  double h_max = pow(m_accuracy/0.03, 1.0/m_order)/m_beta;   // largest mesh spacing compatible with the accuracy
+  double log_acc = sqrt(-log(m_accuracy));
+  for (int d = 0; d < 3; d++)
+  {
+    if (m_mesh[d] == 0)
+    {
+      double k_min = std::max(L[d]/h_max, 2.0*m_beta*L[d]*log_acc/M_PI);
+      m_mesh[d] = 1;
+      while (m_mesh[d] < k_min || m_mesh[d] < m_order)
+        m_mesh[d] *= 2;
+    }
+  }
+  m_msg->msg(Messenger::INFO,"PPPM Coulomb pair potential mesh has "+lexical_cast<string>(m_mesh[0])+" x "+lexical_cast<string>(m_mesh[1])+" x "+lexical_cast<string>(m_mesh[2])+" points.");
+  m_msg->write_config("potential.pair.coulomb.mesh",lexical_cast<string>(m_mesh[0])+" "+lexical_cast<string>(m_mesh[1])+" "+lexical_cast<string>(m_mesh[2]));
+  
+  // Error estimates 
+  double h = std::max(L[0]/m_mesh[0], std::max(L[1]/m_mesh[1], L[2]/m_mesh[2]));
+  double err_real = erfc(m_beta*m_rcut);
+  double err_rec = 0.03*pow(m_beta*h, m_order);
+  m_msg->msg(Messenger::INFO,"PPPM Coulomb pair potential estimated relative errors: real space "+lexical_cast<string>(err_real)+", reciprocal space "+lexical_cast<string>(err_rec)+".");
+  
+  m_grid.resize(m_mesh[0]*m_mesh[1]*m_mesh[2]);
+  m_influence.resize(m_mesh[0]*m_mesh[1]*m_mesh[2]);
+  m_fft = boost::make_shared<FFT3D>(m_mesh[0], m_mesh[1], m_mesh[2]);
+  this->compute_influence_function();
+}
+
+//! Influence function of the smooth PME method, 
+//! $ G(\mathbf{m}) = \frac{\exp\left(-\pi^2 m^2/\beta^2\right)}{\pi V m^2} B(\mathbf{m}) \f$, 
+//! where \f$ B \f$ is the product of squared B-spline moduli. It has to be recomputed when box size changes.
+void PairCoulombPotential::compute_influence_function()
+{
+  BoxPtr box = m_system->get_box();
+  double L[3] = { box->Lx, box->Ly, box->Lz };
+  int n = m_order;
+  vector<double> bsq[3];
+  vector<double> theta(n), dtheta(n);
+  
+  // B-spline moduli; theta[n-2-k] = M_n(k+1) 
+  this->bspline(0.0, &theta[0], &dtheta[0]);
+  for (int d = 0; d < 3; d++)
+  {
+    int K = m_mesh[d];
+    bsq[d].resize(K);
+    for (int m = 0; m < K; m++)
+    {
+      double re = 0.0, im = 0.0;
+      for (int k = 0; k <= n - 2; k++)
+      {
+        re += theta[n-2-k]*cos(2.0*M_PI*m*k/K);
+        im += theta[n-2-k]*sin(2.0*M_PI*m*k/K);
+      }
+      double den = re*re + im*im;
+      bsq[d][m] = (den > 1e-10) ? 1.0/den : 0.0;
+    }
+    // For odd orders modulus vanishes at the Nyquist frequency; interpolate from neighbours 
+    for (int m = 0; m < K; m++)
+      if (bsq[d][m] == 0.0)
+        bsq[d][m] = 0.5*(bsq[d][(m - 1 + K) % K] + bsq[d][(m + 1) % K]);
+  }
+  
+  double V = L[0]*L[1]*L[2];
+  double fact = M_PI*M_PI/(m_beta*m_beta);
+  for (int a = 0; a < m_mesh[0]; a++)
+  {
+    double mx = ((a <= m_mesh[0]/2) ? a : a - m_mesh[0])/L[0];
+    for (int b = 0; b < m_mesh[1]; b++)
+    {
+      double my = ((b <= m_mesh[1]/2) ? b : b - m_mesh[1])/L[1];
+      for (int c = 0; c < m_mesh[2]; c++)
+      {
+        double mz = ((c <= m_mesh[2]/2) ? c : c - m_mesh[2])/L[2];
+        double m_sq = mx*mx + my*my + mz*mz;
+        int k = (a*m_mesh[1] + b)*m_mesh[2] + c;
+        if (m_sq == 0.0)
+          m_influence[k] = 0.0;
+        else
+          m_influence[k] = exp(-fact*m_sq)/(M_PI*V*m_sq)*bsq[0][a]*bsq[1][b]*bsq[2][c];
+      }
+    }
+  }
+  for (int d = 0; d < 3; d++)
+    m_mesh_L[d] = L[d];
+}
+
+//! Computes cardinal B-spline weights of order n for the n mesh points a particle is assigned to 
+//! as well as their derivatives (recursive construction).
+//! \param w fractional position of the particle with respect to the closest mesh point below it
+//! \param theta weights (output)
+//! \param dtheta derivatives of the weights (output)
+void PairCoulombPotential::bspline(double w, double* theta, double* dtheta)
+{
+  int n = m_order;
+  theta[n-1] = 0.0;
+  theta[1] = w;
+  theta[0] = 1.0 - w;
+  for (int k = 3; k <= n - 1; k++)
+  {
+    double div = 1.0/(k - 1);
+    theta[k-1] = div*w*theta[k-2];
+    for (int j = 1; j <= k - 2; j++)
+      theta[k-j-1] = div*((w + j)*theta[k-j-2] + (k - j - w)*theta[k-j-1]);
+    theta[0] *= div*(1.0 - w);
+  }
+  // Derivatives are differences of the order n-1 splines
+  dtheta[0] = -theta[0];
+  for (int j = 1; j < n; j++)
+    dtheta[j] = theta[j-1] - theta[j];
+  // Final recursion step to order n
+  double div = 1.0/(n - 1);
+  theta[n-1] = div*w*theta[n-2];
+  for (int j = 1; j <= n - 2; j++)
+    theta[n-j-1] = div*((w + j)*theta[n-j-2] + (n - j - w)*theta[n-j-1]);
+  theta[0] *= div*(1.0 - w);
 }
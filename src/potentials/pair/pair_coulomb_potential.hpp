@@ -31,11 +31,15 @@
 #define __PAIR_COULOMB_POTENTIAL_HPP__
 
 #include <cmath>
+#include <vector>
 
 #include "pair_potential.hpp"
+#include "fft.hpp"
+#include "octree.hpp"
 
 using std::make_pair;
 using std::sqrt;
+using std::vector;
 
 //! Structure that handles parameters for the Coulomb pair potential
 struct CoulombParameters
@@ -49,6 +53,20 @@ struct CoulombParameters
  *  \f$ U_{Coul}\left(r_{ij}\right) = \frac{\alpha}{r_{ij}} + 4\left|\alpha\right|\left(\frac \sigma r_{ij}\right)^{12} \f$,
  *  where \f$ \alpha \f$ is the potential strength, \f$ \sigma \f$ is the particle diameter and \f$ r_{ij} \f$ is the 
  *  interparticle distance.
+ *
+ *  In periodic boxes the long-range part can be evaluated using the particle-particle/particle-mesh 
+ *  (smooth particle mesh Ewald) method (parameter pppm). In that case \f$ \alpha \f$ is the global coupling 
+ *  strength and each particle type carries a charge \f$ q \f$ (set with pair_type_param, default 1), 
+ *  i.e. the electrostatic part of the pair interaction is \f$ \alpha q_i q_j / r_{ij} \f$. Interaction is split into 
+ *  a short-range part, \f$ \alpha q_i q_j \mathrm{erfc}\left(\beta r_{ij}\right)/r_{ij} \f$, evaluated using the neighbour list 
+ *  up to the real space cutoff, and a smooth long-range part evaluated on a mesh with FFTs. The splitting parameter \f$ \beta \f$
+ *  and the mesh size are chosen from the requested accuracy, unless set explicitly. Repulsive LJ part is always
+ *  evaluated in real space. Pair parameter alpha only controls the strength of the repulsive part in this case.
+ *  For planar systems the z direction of the box is treated as periodic as well. 
+ *
+ *  In non-periodic systems (e.g. on closed surfaces) the electrostatic part \f$ \alpha q_i q_j / r_{ij} \f$ can be evaluated 
+ *  with a Barnes-Hut treecode (parameter treecode) with opening angle theta. Repulsive LJ part is then evaluated 
+ *  using the neighbour list. 
  */
 class PairCoulombPotential : public PairPotential
 {
@@ -65,6 +83,13 @@ public:
     m_known_params.push_back("alpha");
     m_known_params.push_back("sigma");
     m_known_params.push_back("phase_i");
+    m_known_params.push_back("pppm");
+    m_known_params.push_back("accuracy");
+    m_known_params.push_back("rcut");
+    m_known_params.push_back("mesh");
+    m_known_params.push_back("order");
+    m_known_params.push_back("treecode");
+    m_known_params.push_back("theta");
     string param_test = this->params_ok(param);
     if (param_test != "")
     {
@@ -100,6 +125,102 @@ public:
       m_phase_in = true;
       m_msg->write_config("potential.pair.coulomb.phase_in","true");
     }    
+    m_charge.resize(m_ntypes, 1.0);
+    m_pppm = false;
+    if (param.find("pppm") != param.end())
+    {
+      if (!m_system->get_periodic())
+      {
+        m_msg->msg(Messenger::ERROR,"PPPM evaluation of Coulomb pair potential requires periodic boundary conditions.");
+        throw runtime_error("PPPM Coulomb potential in a non-periodic system.");
+      }
+      m_msg->msg(Messenger::INFO,"Coulomb pair potential. Long-range part will be computed using the PPPM method.");
+      m_pppm = true;
+      m_msg->write_config("potential.pair.coulomb.pppm","true");
+      if (param.find("accuracy") == param.end())
+      {
+        m_msg->msg(Messenger::WARNING,"No accuracy specified for PPPM Coulomb pair potential. Setting it to 1e-5.");
+        m_accuracy = 1e-5;
+      }
+      else
+      {
+        m_msg->msg(Messenger::INFO,"Relative accuracy for PPPM Coulomb pair potential is set to "+param["accuracy"]+".");
+        m_accuracy = lexical_cast<double>(param["accuracy"]);
+      }
+      m_msg->write_config("potential.pair.coulomb.accuracy",lexical_cast<string>(m_accuracy));
+      if (param.find("rcut") == param.end())
+      {
+        m_msg->msg(Messenger::WARNING,"No real space cutoff specified for PPPM Coulomb pair potential. Using neighbour list cutoff.");
+        m_rcut = m_nlist->get_cutoff();
+      }
+      else
+      {
+        m_msg->msg(Messenger::INFO,"Real space cutoff for PPPM Coulomb pair potential is set to "+param["rcut"]+".");
+        m_rcut = lexical_cast<double>(param["rcut"]);
+      }
+      if (m_rcut > m_nlist->get_cutoff())
+      {
+        m_msg->msg(Messenger::ERROR,"Real space cutoff for PPPM Coulomb pair potential ("+lexical_cast<string>(m_rcut)+") is larger than the neighbour list cutoff ("+lexical_cast<string>(m_nlist->get_cutoff())+").");
+        throw runtime_error("PPPM real space cutoff larger than neighbour list cutoff.");
+      }
+      m_msg->write_config("potential.pair.coulomb.rcut",lexical_cast<string>(m_rcut));
+      if (param.find("order") == param.end())
+        m_order = 4;
+      else
+        m_order = lexical_cast<int>(param["order"]);
+      if (m_order < 3 || m_order > 8)
+      {
+        m_msg->msg(Messenger::ERROR,"Charge assignment order for PPPM Coulomb pair potential has to be between 3 and 8.");
+        throw runtime_error("Invalid PPPM charge assignment order.");
+      }
+      m_msg->msg(Messenger::INFO,"Charge assignment order for PPPM Coulomb pair potential is set to "+lexical_cast<string>(m_order)+".");
+      m_msg->write_config("potential.pair.coulomb.order",lexical_cast<string>(m_order));
+      m_mesh[0] = m_mesh[1] = m_mesh[2] = 0;
+      if (param.find("mesh") != param.end())
+      {
+        int mesh = lexical_cast<int>(param["mesh"]);
+        if (!FFT3D::is_power_of_two(mesh) || mesh < m_order)
+        {
+          m_msg->msg(Messenger::ERROR,"Mesh size for PPPM Coulomb pair potential has to be a power of 2 and not smaller than the assignment order.");
+          throw runtime_error("Invalid PPPM mesh size.");
+        }
+        m_msg->msg(Messenger::INFO,"Mesh size for PPPM Coulomb pair potential is set to "+param["mesh"]+".");
+        m_mesh[0] = m_mesh[1] = m_mesh[2] = mesh;
+      }
+      this->setup_pppm();
+    }
+    m_treecode = false;
+    if (param.find("treecode") != param.end())
+    {
+      if (m_pppm)
+      {
+        m_msg->msg(Messenger::ERROR,"Coulomb pair potential. Only one of pppm and treecode can be used.");
+        throw runtime_error("Both PPPM and treecode requested for Coulomb potential.");
+      }
+      if (m_system->get_periodic())
+      {
+        m_msg->msg(Messenger::ERROR,"Treecode evaluation of Coulomb pair potential does not support periodic boundary conditions. Use pppm instead.");
+        throw runtime_error("Treecode Coulomb potential in a periodic system.");
+      }
+      m_msg->msg(Messenger::INFO,"Coulomb pair potential. Interactions will be computed using the treecode method.");
+      m_treecode = true;
+      m_msg->write_config("potential.pair.coulomb.treecode","true");
+      double theta = 0.5;
+      if (param.find("theta") == param.end())
+        m_msg->msg(Messenger::WARNING,"No opening angle (theta) specified for treecode Coulomb pair potential. Setting it to 0.5.");
+      else
+      {
+        m_msg->msg(Messenger::INFO,"Opening angle (theta) for treecode Coulomb pair potential is set to "+param["theta"]+".");
+        theta = lexical_cast<double>(param["theta"]);
+      }
+      if (theta <= 0.0 || theta >= 1.0)
+      {
+        m_msg->msg(Messenger::ERROR,"Opening angle (theta) for treecode Coulomb pair potential has to be between 0 and 1.");
+        throw runtime_error("Invalid treecode opening angle.");
+      }
+      m_msg->write_config("potential.pair.coulomb.theta",lexical_cast<string>(theta));
+      m_octree = boost::make_shared<Octree>(Octree(m_system, m_msg, theta, OCTREE_LEAF_SIZE));
+    }
     
     m_pair_params = new CoulombParameters*[m_ntypes];
     for (int i = 0; i < m_ntypes; i++)
@@ -173,8 +294,29 @@ public:
     m_has_pair_params = true;
   }
   
-  //! Returns false since Coulomb potential does not need neighbour list
-  bool need_nlist() { return false; }
+  //! Set per type charges (used by the PPPM and treecode methods)
+  void set_type_parameters(pairs_type& pair_param)
+  {
+    if (pair_param.find("type") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type has not been defined for type specific parameters in Coulomb potential.");
+      throw runtime_error("Missing key for pair potential parameters.");
+    }
+    int type = lexical_cast<int>(pair_param["type"]);
+    if (pair_param.find("q") != pair_param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Coulomb pair potential. Setting charge to "+pair_param["q"]+" for particles of type "+lexical_cast<string>(type)+".");
+      m_charge[type-1] = lexical_cast<double>(pair_param["q"]);
+    }
+    else
+      m_msg->msg(Messenger::INFO,"Coulomb pair potential. Using default charge ("+lexical_cast<string>(m_charge[type-1])+") for particles of type "+lexical_cast<string>(type)+".");
+    m_msg->write_config("potential.pair.coulomb.type_"+pair_param["type"]+".q",lexical_cast<string>(m_charge[type-1]));
+    if (!(m_pppm || m_treecode))
+      m_msg->msg(Messenger::WARNING,"Coulomb pair potential. Charges are only used with the PPPM and treecode methods. Use pair parameter alpha otherwise.");
+  }
+  
+  //! Returns true only if the PPPM (real space part) or treecode (repulsive part) methods are used 
+  bool need_nlist() { return m_pppm || m_treecode; }
   
   //! Computes potentials and forces for all particles
   void compute(double);
@@ -185,6 +327,47 @@ private:
   double m_alpha;       //!< potential strength
   double m_sigma;       //!< particle diameter
   CoulombParameters** m_pair_params;   //!< type specific pair parameters 
+  
+  bool m_pppm;                      //!< If true, use PPPM method
+  double m_accuracy;                //!< Requested relative accuracy of the PPPM method 
+  double m_rcut;                    //!< Real space cutoff for the PPPM method
+  double m_beta;                    //!< Ewald splitting parameter
+  int m_order;                      //!< Order of the B-spline charge assignment 
+  int m_mesh[3];                    //!< Number of mesh points in each direction
+  double m_mesh_L[3];               //!< Box size for which the influence function has been computed
+  vector<double> m_charge;          //!< Charge of each particle type
+  vector<Complex> m_grid;           //!< Charge (and later potential) mesh 
+  vector<double> m_influence;       //!< Optimal influence function (including B-spline moduli) 
+  vector<double> m_theta;           //!< B-spline weights for each particle and direction
+  vector<double> m_dtheta;          //!< Derivatives of B-spline weights for each particle and direction
+  vector<int> m_mesh_idx;           //!< First mesh point each particle is assigned to in each direction
+  FFT3DPtr m_fft;                   //!< Handles fast Fourier transforms
+  bool m_treecode;                  //!< If true, use treecode method
+  OctreePtr m_octree;               //!< Octree for the treecode method
+  vector<double> m_q;               //!< Charge of each particle (treecode)
+  vector<double> m_phi;             //!< Potential at each particle (treecode)
+  vector<double> m_ex, m_ey, m_ez;  //!< Field at each particle (treecode)
+  
+  //! Computes all pairs directly (original, non-periodic method)
+  void compute_direct(double);
+  
+  //! Computes real space part of PPPM using neighbour list
+  void compute_real_space(double);
+  
+  //! Computes reciprocal space part of PPPM on the mesh 
+  void compute_reciprocal();
+  
+  //! Computes repulsive part using neighbour list and electrostatic part using treecode
+  void compute_tree(double);
+  
+  //! Chooses splitting parameter and mesh size from requested accuracy
+  void setup_pppm();
+  
+  //! Computes influence function for the current box
+  void compute_influence_function();
+  
+  //! Computes B-spline weights and their derivatives
+  void bspline(double, double*, double*);
     
 };
 
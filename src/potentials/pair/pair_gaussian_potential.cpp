@@ -43,6 +43,9 @@ void PairGaussianPotential::compute(double dt)
   double phase_fact_i = 1.0;  // phase in factor for particle i
   double phase_fact_j = 1.0;  // phase in factor for particle j
   double phase_fact = 1.0; // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
     
    
   if (m_system->compute_per_particle_energy())
@@ -55,19 +58,20 @@ void PairGaussianPotential::compute(double dt)
   }
 
   // Reset total potential energy to zero
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
     if (m_phase_in)
-      phase_fact_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
+      phase_fact_i = 0.5*(1.0 + phase_in[i]);
     vector<int>& neigh = m_nlist->get_neighbours(i);
     for (unsigned int j = 0; j < neigh.size(); j++)
     {
       Particle& pj = m_system->get_particle(neigh[j]);
       if (m_phase_in)
       {
-        phase_fact_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
+        phase_fact_j = 0.5*(1.0 + phase_in[neigh[j]]);
         // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
         // Except for the interaction between daugthers which starts at 0
         if (phase_fact_i < 1.0 && phase_fact_j < 1.0)
@@ -99,17 +103,26 @@ void PairGaussianPotential::compute(double dt)
         if (m_use_particle_radii)
           rB = ai + pj.get_radius();
         double r = sqrt(r_sq);
-        // Handle potential 
         double r_m_rA = r - rA, r_m_rB = r - rB;
-        double potential_energy = A*phase_fact*exp(-alpha*r_m_rA*r_m_rA)+B*exp(-beta*r_m_rB*r_m_rB);
-        if (m_shifted)
+        double exp_A = exp(-alpha*r_m_rA*r_m_rA), exp_B = exp(-beta*r_m_rB*r_m_rB);  // shared between force and energy
+        // Handle potential 
+        if (compute_eng)
         {
-          double rcut_m_rA = rcut - rA, rcut_m_rB = rcut - rB;
-          potential_energy -= A*phase_fact*exp(-alpha*rcut_m_rA*rcut_m_rA)+B*exp(-beta*rcut_m_rB*rcut_m_rB);
+          double potential_energy = A*phase_fact*exp_A+B*exp_B;
+          if (m_shifted)
+          {
+            double rcut_m_rA = rcut - rA, rcut_m_rB = rcut - rB;
+            potential_energy -= A*phase_fact*exp(-alpha*rcut_m_rA*rcut_m_rA)+B*exp(-beta*rcut_m_rB*rcut_m_rB);
+          }
+          m_potential_energy += potential_energy;
+          if (m_system->compute_per_particle_energy())
+          {
+            pi.add_pot_energy("gaussian",potential_energy);
+            pj.add_pot_energy("gaussian",potential_energy);
+          }
         }
-        m_potential_energy += potential_energy;
         // Handle force
-        double force_factor = (2.0/r)*phase_fact*(A*alpha*r_m_rA*exp(-alpha*r_m_rA*r_m_rA)+B*beta*r_m_rB*exp(-beta*r_m_rB*r_m_rB));
+        double force_factor = (2.0/r)*phase_fact*(A*alpha*r_m_rA*exp_A+B*beta*r_m_rB*exp_B);
         pi.fx += force_factor*dx;
         pi.fy += force_factor*dy;
         pi.fz += force_factor*dz;
@@ -117,11 +130,9 @@ void PairGaussianPotential::compute(double dt)
         pj.fx -= force_factor*dx;
         pj.fy -= force_factor*dy;
         pj.fz -= force_factor*dz;
-        if (m_system->compute_per_particle_energy())
-        {
-          pi.add_pot_energy("gaussian",potential_energy);
-          pj.add_pot_energy("gaussian",potential_energy);
-        }
+        // Accumulate pair virial
+        if (compute_stress)
+          m_system->add_pair_stress(i, neigh[j], dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
       }
     }
   }
@@ -37,6 +37,7 @@ void PairLineTensionPotential::compute(double dt)
   double l0 = m_l0;
   int N = m_system->size();
   Mesh& mesh = m_system->get_mesh();
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
   
   if (m_system->compute_per_particle_energy())
   {
@@ -47,7 +48,8 @@ void PairLineTensionPotential::compute(double dt)
     }
   }
   
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for (int e = 0; e < mesh.nedges(); e++)
   {
     Edge& E = mesh.get_edges()[e];
@@ -65,8 +67,12 @@ void PairLineTensionPotential::compute(double dt)
       double r_sq = dx*dx + dy*dy + dz*dz;
       double r = sqrt(r_sq);
       double dl = r - l0;
-      double pot_eng = 0.5*lambda*dl*dl;
-      m_potential_energy += pot_eng;
+      double pot_eng = 0.0;
+      if (compute_eng)
+      {
+        pot_eng = 0.5*lambda*dl*dl;
+        m_potential_energy += pot_eng;
+      }
       // Handle force
       double force_factor = lambda*dl/r;
       pi.fx += force_factor*dx;
@@ -32,93 +32,109 @@
 void PairLJPotential::compute(double dt)
 {
   int N = m_system->size();
-  double sigma = m_sigma;
-  double eps = m_eps;
-  double rcut = m_rcut;
-  double sigma_sq = sigma*sigma, rcut_sq = rcut*rcut;
-  double alpha_i = 1.0;  // phase in factor for particle i
-  double alpha_j = 1.0;  // phase in factor for particle j
-  double alpha = 1.0;    // phase in factor for pair interaction (see below)
  
-  if (m_system->compute_per_particle_energy())
-  {
-    for  (int i = 0; i < N; i++)
-    {
-      Particle& p = m_system->get_particle(i);
-      p.set_pot_energy("lj",0.0);
-    }
-  }
-
-  // Reset total potential energy to zero
-  m_potential_energy = 0.0;
+  this->begin_fused(dt);
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
-    if (m_phase_in)
-      alpha_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
-    double ai = pi.get_radius();
     vector<int>& neigh = m_nlist->get_neighbours(i);
     for (unsigned int j = 0; j < neigh.size(); j++)
     {
       Particle& pj = m_system->get_particle(neigh[j]);
-      if (m_phase_in)
-      {
-        alpha_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
-        // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
-        // Except for the interaction between daugthers which starts at 0
-        if (alpha_i < 1.0 && alpha_j < 1.0)
-          alpha = alpha_i + alpha_j - 1.0;
-	      else 
-	        alpha = alpha_i*alpha_j;
-      }
-      if (m_has_pair_params)
-      {
-        rcut = m_pair_params[pi.get_type()-1][pj.get_type()-1].rcut;
-        rcut_sq = rcut*rcut;
-      }
       double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
       m_system->apply_periodic(dx,dy,dz);
       double r_sq = dx*dx + dy*dy + dz*dz;
-      if (r_sq <= rcut_sq)
-      {
-        if (m_has_pair_params)
-        {
-          int pi_t = pi.get_type() - 1, pj_t = pj.get_type() - 1;
-          sigma = m_pair_params[pi_t][pj_t].sigma;
-          eps = m_pair_params[pi_t][pj_t].eps;
-          sigma_sq = sigma*sigma;
-        }
-        if (m_use_particle_radii)
-        {
-          sigma = ai+pj.get_radius();
-          sigma_sq = sigma*sigma;
-        }
-        double inv_r_sq = sigma_sq/r_sq;
-        double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
-        // Handle potential 
-        double potential_energy = 4.0*eps*alpha*inv_r_6*(inv_r_6 - 1.0);
-        if (m_shifted)
-        {
-          double inv_r_cut_sq = sigma_sq/rcut_sq;
-          double inv_r_cut_6 = inv_r_cut_sq*inv_r_cut_sq*inv_r_cut_sq;
-          potential_energy -= 4.0 * eps * alpha * inv_r_cut_6 * (inv_r_cut_6 - 1.0);
-        }
-        m_potential_energy += potential_energy;
-        // Handle force
-        double force_factor = 48.0*eps*alpha*inv_r_6*(inv_r_6 - 0.5)*inv_r_sq;
-        pi.fx += force_factor*dx;
-        pi.fy += force_factor*dy;
-        pi.fz += force_factor*dz;
-        // Use 3d Newton's law
-        pj.fx -= force_factor*dx;
-        pj.fy -= force_factor*dy;
-        pj.fz -= force_factor*dz;
-        if (m_system->compute_per_particle_energy())
-        {
-          pi.add_pot_energy("lj",potential_energy);
-          pj.add_pot_energy("lj",potential_energy);
-        }
-      }
+      this->pair_force(i, neigh[j], pi, pj, dx, dy, dz, r_sq);
+    }
+  }
+}
+
+/*! Fused traversal provides distance vector pointing from i to j, while 
+ *  the Lennard-Jones kernel uses the opposite convention.
+ *  \param i index of the first particle
+ *  \param j index of the second particle
+ *  \param pi first particle
+ *  \param pj second particle
+ *  \param dx x component of the distance vector
+ *  \param dy y component of the distance vector
+ *  \param dz z component of the distance vector
+ *  \param r_sq squared distance
+ */
+void PairLJPotential::fused_pair(int i, int j, Particle& pi, Particle& pj, double dx, double dy, double dz, double r_sq)
+{
+  this->pair_force(i, j, pi, pj, -dx, -dy, -dz, r_sq);
+}
+
+/*! Computes force and energy for a single pair of particles. Distance vector points from j to i.
+ *  \param i index of the first particle
+ *  \param j index of the second particle
+ *  \param pi first particle
+ *  \param pj second particle
+ *  \param dx x component of the distance vector
+ *  \param dy y component of the distance vector
+ *  \param dz z component of the distance vector
+ *  \param r_sq squared distance
+ */
+void PairLJPotential::pair_force(int i, int j, Particle& pi, Particle& pj, double dx, double dy, double dz, double r_sq)
+{
+  double sigma = m_sigma;
+  double eps = m_eps;
+  double rcut = m_rcut;
+  double alpha = 1.0;    // phase in factor for pair interaction (see below)
+  if (m_has_pair_params)
+    rcut = m_pair_params[pi.get_type()-1][pj.get_type()-1].rcut;
+  double rcut_sq = rcut*rcut;
+  if (r_sq > rcut_sq)
+    return;
+  if (m_phase_in)
+  {
+    double alpha_i = 0.5*(1.0 + m_pass_phase_in[i]);  // phase in factor for particle i
+    double alpha_j = 0.5*(1.0 + m_pass_phase_in[j]);  // phase in factor for particle j
+    // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
+    // Except for the interaction between daugthers which starts at 0
+    if (alpha_i < 1.0 && alpha_j < 1.0)
+      alpha = alpha_i + alpha_j - 1.0;
+    else 
+      alpha = alpha_i*alpha_j;
+  }
+  if (m_has_pair_params)
+  {
+    int pi_t = pi.get_type() - 1, pj_t = pj.get_type() - 1;
+    sigma = m_pair_params[pi_t][pj_t].sigma;
+    eps = m_pair_params[pi_t][pj_t].eps;
+  }
+  if (m_use_particle_radii)
+    sigma = pi.get_radius()+pj.get_radius();
+  double sigma_sq = sigma*sigma;
+  double inv_r_sq = sigma_sq/r_sq;
+  double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
+  // Handle potential 
+  if (m_pass_energy)
+  {
+    double potential_energy = 4.0*eps*alpha*inv_r_6*(inv_r_6 - 1.0);
+    if (m_shifted)
+    {
+      double inv_r_cut_sq = sigma_sq/rcut_sq;
+      double inv_r_cut_6 = inv_r_cut_sq*inv_r_cut_sq*inv_r_cut_sq;
+      potential_energy -= 4.0 * eps * alpha * inv_r_cut_6 * (inv_r_cut_6 - 1.0);
+    }
+    m_potential_energy += potential_energy;
+    if (m_system->compute_per_particle_energy())
+    {
+      pi.add_pot_energy("lj",potential_energy);
+      pj.add_pot_energy("lj",potential_energy);
     }
   }
+  // Handle force
+  double force_factor = 48.0*eps*alpha*inv_r_6*(inv_r_6 - 0.5)*inv_r_sq;
+  pi.fx += force_factor*dx;
+  pi.fy += force_factor*dy;
+  pi.fz += force_factor*dz;
+  // Use 3d Newton's law
+  pj.fx -= force_factor*dx;
+  pj.fy -= force_factor*dy;
+  pj.fz -= force_factor*dz;
+  // Accumulate pair virial
+  if (m_pass_stress)
+    m_system->add_pair_stress(i, j, dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
 }
@@ -253,6 +253,15 @@ public:
   //! Computes potentials and forces for all particles
   void compute(double);
   
+  //! Returns true since Lennard-Jones potential can share neighbour list traversal with other interactions
+  bool fusable() { return true; }
+  
+  //! Prepares fused evaluation
+  void begin_fused(double dt) { this->begin_pass(dt,"lj"); }
+  
+  //! Adds interaction of a single pair of neighbours during the fused traversal
+  void fused_pair(int, int, Particle&, Particle&, double, double, double, double);
+  
   
 private:
        
@@ -260,7 +269,10 @@ private:
   double m_sigma;  //!< particle diameter
   double m_rcut;   //!< cutoff distance
   LJParameters** m_pair_params;   //!< type specific pair parameters 
-    
+  
+  //! Force and energy of a single pair (distance vector is \f$ \vec r_i - \vec r_j \f$)
+  void pair_force(int, int, Particle&, Particle&, double, double, double, double);
+     
 };
 
 typedef shared_ptr<PairLJPotential> PairLJPotentialPtr;
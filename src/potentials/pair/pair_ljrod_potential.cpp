@@ -49,8 +49,10 @@ void PairLJRodPotential::compute(double dt)
   double alpha_i = 1.0;  // phase in factor for particle i
   double alpha_j = 1.0;  // phase in factor for particle j
   double alpha = 1.0;    // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
   double k;
   double inv_core_sq, inv_core_6, lj_core_sq;
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
   
   if (m_system->compute_per_particle_energy())
   {
@@ -61,12 +63,13 @@ void PairLJRodPotential::compute(double dt)
     }
   }
   
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
     if (m_phase_in)
-      alpha_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
+      alpha_i = 0.5*(1.0 + phase_in[i]);
     li2 = 0.5*pi.get_length();
     double ni_x = pi.nx, ni_y = pi.ny, ni_z = pi.nz; 
     vector<int>& neigh = m_nlist->get_neighbours(i);
@@ -75,7 +78,7 @@ void PairLJRodPotential::compute(double dt)
       Particle& pj = m_system->get_particle(neigh[j]);
       if (m_phase_in)
       {
-        alpha_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
+        alpha_j = 0.5*(1.0 + phase_in[neigh[j]]);
         // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
         // Except for the interaction between daugthers which starts at 0
         if (alpha_i<1.0 && alpha_j < 1.0)
@@ -93,52 +96,10 @@ void PairLJRodPotential::compute(double dt)
       double dx_cm = pj.x - pi.x, dy_cm = pj.y - pi.y, dz_cm = pj.z - pi.z;
       m_system->apply_periodic(dx_cm,dy_cm,dz_cm);
       
-      double ni_dot_nj = ni_x*nj_x + ni_y*nj_y + ni_z*nj_z; 
-      double drcm_dot_ni = dx_cm*ni_x + dy_cm*ni_y + dz_cm*ni_z;
-      double drcm_dot_nj = dx_cm*nj_x + dy_cm*nj_y + dz_cm*nj_z;
-      double cc = 1.0 - ni_dot_nj*ni_dot_nj;
-      
-      if (cc <= 1e-10) // rods are nearly parallel
-      {
-        if (fabs(drcm_dot_ni) > 1e-10)
-        {
-          lambda = copysign(li2,drcm_dot_ni);
-          mu = lambda*ni_dot_nj - drcm_dot_nj;
-          if (fabs(mu) > lj2) mu = copysign(lj2,mu);
-        }
-        else
-        {
-          lambda = 0.0;
-          mu = 0.0;
-        }
-//         lambda = 0.5*drcm_dot_ni;
-//         mu = -0.5*drcm_dot_nj;
-//         if (fabs(lambda) > li2) lambda = copysign(li2,lambda); 
-//         if (fabs(mu) > lj2) mu = copysign(lj2,mu);
-      }
-      else
-      {
-        lambda = (drcm_dot_ni-ni_dot_nj*drcm_dot_nj)/cc;
-        mu = (-drcm_dot_nj+ni_dot_nj*drcm_dot_ni)/cc;
-        if (fabs(lambda) > li2 || fabs(mu) > lj2)
-        {
-          if (fabs(lambda) - li2 > fabs(mu) - lj2)
-          {
-            lambda = copysign(li2,lambda);
-            mu = lambda*ni_dot_nj - drcm_dot_nj;
-            if (fabs(mu) > lj2) mu = copysign(lj2,mu);
-          }
-          else
-          {
-            mu =  copysign(lj2,mu);
-            lambda = mu*ni_dot_nj + drcm_dot_ni;
-            if (fabs(lambda) > li2) lambda = copysign(li2,lambda);      
-          }
-        }
-      }
-      dx = dx_cm + mu*nj_x - lambda*ni_x;
-      dy = dy_cm + mu*nj_y - lambda*ni_y;
-      dz = dz_cm + mu*nj_z - lambda*ni_z;
+      // Rods whose bounding spheres are too far apart cannot interact
+      if (!rod_spheres_overlap(dx_cm,dy_cm,dz_cm,li2,lj2,rcut))
+        continue;
+      rod_closest_approach(dx_cm,dy_cm,dz_cm,ni_x,ni_y,ni_z,nj_x,nj_y,nj_z,li2,lj2,lambda,mu,dx,dy,dz);
 
       double r_sq = dx*dx + dy*dy + dz*dz;
       
@@ -171,7 +132,7 @@ void PairLJRodPotential::compute(double dt)
           double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
           // Handle potential 
           potential_energy = 4.0*eps*alpha*inv_r_6*(inv_r_6 - 1.0);
-          if (m_shifted)
+          if (m_shifted && compute_eng)
           {
             double inv_r_cut_sq = sigma_sq/rcut_sq;
             double inv_r_cut_6 = inv_r_cut_sq*inv_r_cut_sq*inv_r_cut_sq;
@@ -179,7 +140,8 @@ void PairLJRodPotential::compute(double dt)
           }
           force_factor = 48.0*eps*alpha*inv_r_6*(inv_r_6 - 0.5)*inv_r_sq;
         }
-        m_potential_energy += potential_energy;
+        if (compute_eng)
+          m_potential_energy += potential_energy;
         // Handle force
         fx = force_factor*dx;  fy = force_factor*dy;  fz = force_factor*dz;
         pi.fx -= fx;
@@ -40,6 +40,9 @@ void PairMorsePotential::compute(double dt)
   double alpha_i = 1.0;  // phase in factor for particle i
   double alpha_j = 1.0;  // phase in factor for particle j
   double alpha = 1.0;    // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
  
   if (m_system->compute_per_particle_energy())
   {
@@ -51,12 +54,13 @@ void PairMorsePotential::compute(double dt)
   }
 
   // Reset total potential energy to zero
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
     if (m_phase_in)
-      alpha_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
+      alpha_i = 0.5*(1.0 + phase_in[i]);
     double ai = pi.get_radius();
     vector<int>& neigh = m_nlist->get_neighbours(i);
     for (unsigned int j = 0; j < neigh.size(); j++)
@@ -64,7 +68,7 @@ void PairMorsePotential::compute(double dt)
       Particle& pj = m_system->get_particle(neigh[j]);
       if (m_phase_in)
       {
-        alpha_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
+        alpha_j = 0.5*(1.0 + phase_in[neigh[j]]);
         // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
         // Except for the interaction between daugthers which starts at 0
         if (alpha_i < 1.0 && alpha_j < 1.0)
@@ -95,13 +99,21 @@ void PairMorsePotential::compute(double dt)
         double exp_fact = exp(-a*(r-re));
         double pot_fact = exp_fact - 1.0;
         // Handle potential 
-        double potential_energy = D*alpha*(pot_fact*pot_fact-1.0);
-        if (m_shifted)
+        if (compute_eng)
         {
-          double shift_fact = exp(-a*(rcut-re)) - 1.0;
-          potential_energy -= D*alpha*(shift_fact*shift_fact-1.0);
+          double potential_energy = D*alpha*(pot_fact*pot_fact-1.0);
+          if (m_shifted)
+          {
+            double shift_fact = exp(-a*(rcut-re)) - 1.0;
+            potential_energy -= D*alpha*(shift_fact*shift_fact-1.0);
+          }
+          m_potential_energy += potential_energy;
+          if (m_system->compute_per_particle_energy())
+          {
+            pi.add_pot_energy("morse",potential_energy);
+            pj.add_pot_energy("morse",potential_energy);
+          }
         }
-        m_potential_energy += potential_energy;
         // Handle force
         double force_factor = 2.0*D*a*alpha*exp_fact*pot_fact/r;
         pi.fx += force_factor*dx;
@@ -111,11 +123,9 @@ void PairMorsePotential::compute(double dt)
         pj.fx -= force_factor*dx;
         pj.fy -= force_factor*dy;
         pj.fz -= force_factor*dz;
-        if (m_system->compute_per_particle_energy())
-        {
-          pi.add_pot_energy("morse",potential_energy);
-          pj.add_pot_energy("morse",potential_energy);
-        }
+        // Accumulate pair virial
+        if (compute_stress)
+          m_system->add_pair_stress(i, neigh[j], dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
       }
     }
   }
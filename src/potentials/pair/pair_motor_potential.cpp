@@ -40,6 +40,7 @@ void PairMotorPotential::compute(double dt)
   double phi_i = 1.0;  // phase in factor for particle i
   double phi_j = 1.0;  // phase in factor for particle j
   double phi = 1.0;    // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
   double activity;     // actual activity on each bead
   
   if (m_system->compute_per_particle_energy())
@@ -65,7 +66,7 @@ void PairMotorPotential::compute(double dt)
   {
     Particle& pi = m_system->get_particle(i);
     if (m_phase_in)
-      phi_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
+      phi_i = 0.5*(1.0 + phase_in[i]);
     ai = pi.get_radius();
     vector<int>& neigh = m_nlist->get_neighbours(i);
     for (unsigned int j = 0; j < neigh.size(); j++)
@@ -76,7 +77,7 @@ void PairMotorPotential::compute(double dt)
         double n_dot_n = pi.nx*pj.nx + pi.ny*pj.ny + pi.nz*pj.nz; 
         if (m_phase_in)
         {
-          phi_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
+          phi_j = 0.5*(1.0 + phase_in[neigh[j]]);
           // Determine global phase in factor: particles start at 0.5 strength (both daughters of a division replace the mother)
           // Except for the interaction between daughters which starts at 0
           if (phi_i < 1.0 && phi_j < 1.0)
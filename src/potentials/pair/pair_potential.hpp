@@ -36,6 +36,7 @@
 
 #include "system.hpp"
 #include "neighbour_list.hpp"
+#include "block_sparse_matrix.hpp"
 #include "value.hpp"
 #include "parse_parameters.hpp"
 
@@ -67,12 +68,16 @@ public:
                                                                                                             m_shifted(false),
                                                                                                             m_use_particle_radii(false),
                                                                                                             m_phase_in(false),
-                                                                                                            m_compute_stress(false)
+                                                                                                            m_compute_stress(false),
+                                                                                                            m_pass_phase_in(0),
+                                                                                                            m_pass_energy(false),
+                                                                                                            m_pass_stress(false)
   {  
     m_known_params.push_back("min_val");
     m_known_params.push_back("max_val");
     m_known_params.push_back("ntypes");
     m_known_params.push_back("steps");
+    m_known_params.push_back("table");
     if (param.find("min_val") != param.end())
     {
       if (lexical_cast<double>(param["min_val"]) != 0.0)
@@ -118,6 +123,30 @@ public:
   
   //! Computes potentials and forces for all particles
   virtual void compute(double) = 0;
+  
+  //! Returns true if the potential can be evaluated as part of a shared (fused) neighbour list traversal
+  virtual bool fusable() { return false; }
+  
+  //! Prepares fused evaluation (resets energies and caches per step flags)
+  virtual void begin_fused(double) { }
+  
+  //! Adds interaction of a single pair of neighbours during the fused traversal
+  //! \param i index of the first particle
+  //! \param j index of the second particle (neighbour of i)
+  //! \param pi first particle
+  //! \param pj second particle
+  //! \param dx x component of \f$ \vec r_j - \vec r_i \f$ (periodic boundary conditions applied)
+  //! \param dy y component of \f$ \vec r_j - \vec r_i \f$ (periodic boundary conditions applied)
+  //! \param dz z component of \f$ \vec r_j - \vec r_i \f$ (periodic boundary conditions applied)
+  //! \param r_sq squared distance between particles
+  virtual void fused_pair(int i, int j, Particle& pi, Particle& pj, double dx, double dy, double dz, double r_sq) { }
+  
+  //! Finishes fused evaluation
+  virtual void end_fused() { }
+  
+  //! Adds (approximate) Hessian of the potential energy to the matrix 
+  //! \return false if the potential does not provide the Hessian
+  virtual bool add_hessian(BlockSparseMatrix&) { return false; }
 
   //! Check if there are no illegal parameters
   string params_ok(pairs_type& params)
@@ -128,6 +157,26 @@ public:
     return "";
   }
 
+  //! Caches per step flags and resets energies at the beginning of a force evaluation
+  //! \param dt step size (used to phase in particles)
+  //! \param name name of the potential (used for per particle energies)
+  void begin_pass(double dt, const string& name)
+  {
+    m_pass_phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;
+    m_pass_energy = m_system->compute_energy();
+    m_pass_stress = m_system->compute_stress();
+    if (m_system->compute_per_particle_energy())
+    {
+      for  (int i = 0; i < m_system->size(); i++)
+      {
+        Particle& p = m_system->get_particle(i);
+        p.set_pot_energy(name,0.0);
+      }
+    }
+    if (m_pass_energy)
+      m_potential_energy = 0.0;
+  }
+
   //! Resets per particle force type
   //! \param name force type
   void reset_force_types(const string& name)
@@ -153,6 +202,9 @@ protected:
   bool m_phase_in;                  //!< If true, gradually switch on potential for particles that are younger than a given age
   bool m_compute_stress;            //!< If true, compute stress tensor
   int m_ntypes;                     //!< Total number of particle types in the system
+  double* m_pass_phase_in;          //!< Per particle phase in values in the current force evaluation (0 if not phasing in)
+  bool m_pass_energy;               //!< If true, current force evaluation accumulates energies
+  bool m_pass_stress;               //!< If true, current force evaluation accumulates pair virial
   vector<string> m_known_params;    //!< Lists all known parameters accepted by a given pair potential
   
 };
@@ -34,6 +34,7 @@
 #include <string>
 
 #include "pair_potential.hpp"
+#include "rod_distance.hpp"
 
 using std::make_pair;
 using std::sqrt;
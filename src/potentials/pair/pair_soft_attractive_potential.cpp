@@ -39,6 +39,9 @@ void PairSoftAttractivePotential::compute(double dt)
   double alpha_i = 1.0;  // phase in factor for particle i
   double alpha_j = 1.0;  // phase in factor for particle j
   double alpha = 1.0; // phase in factor for pair interaction (see below)
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
   
   for  (int i = 0; i < N; i++)
     {
@@ -52,7 +55,8 @@ void PairSoftAttractivePotential::compute(double dt)
 	  p.coordination=0;
    }
   
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
@@ -61,7 +65,7 @@ void PairSoftAttractivePotential::compute(double dt)
     // Second note: I could set the interpolation between 0.5 and 1, however then pair_vertex potential would be dubious
     // Instead this is done manually here
     if (m_phase_in)
-      alpha_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
+      alpha_i = 0.5*(1.0 + phase_in[i]);
     ai = pi.get_radius();
     vector<int>& neigh = m_nlist->get_neighbours(i);
     for (unsigned int j = 0; j < neigh.size(); j++)
@@ -69,7 +73,7 @@ void PairSoftAttractivePotential::compute(double dt)
       Particle& pj = m_system->get_particle(neigh[j]);
       if (m_phase_in)
       {
-        alpha_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
+        alpha_j = 0.5*(1.0 + phase_in[neigh[j]]);
         // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
         // Except for the interaction between daugthers which starts at 0
         if (alpha_i < 1.0 && alpha_j < 1.0)
@@ -110,7 +114,15 @@ void PairSoftAttractivePotential::compute(double dt)
           pot_eng = -0.5*k*alpha*diff*diff;
           force_factor = -k*alpha*diff/r;
         }
-        m_potential_energy += pot_eng;
+        if (compute_eng)
+        {
+          m_potential_energy += pot_eng;
+          if (m_system->compute_per_particle_energy())
+          {
+            pi.add_pot_energy("soft_attractive",pot_eng);
+            pj.add_pot_energy("soft_attractive",pot_eng);
+          }
+        }
         // Handle force
         pi.fx -= force_factor*dx;
         pi.fy -= force_factor*dy;
@@ -119,11 +131,9 @@ void PairSoftAttractivePotential::compute(double dt)
         pj.fx += force_factor*dx;
         pj.fy += force_factor*dy;
         pj.fz += force_factor*dz;
-        if (m_system->compute_per_particle_energy())
-        {
-          pi.add_pot_energy("soft_attractive",pot_eng);
-          pj.add_pot_energy("soft_attractive",pot_eng);
-        }
+        // Accumulate pair virial
+        if (compute_stress)
+          m_system->add_pair_stress(i, neigh[j], dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
       }
     }
   }
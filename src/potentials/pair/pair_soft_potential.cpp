@@ -33,87 +33,101 @@
 void PairSoftPotential::compute(double dt)
 {
   int N = m_system->size();
-  double k = m_k;
-  double ai, aj;
-  double force_factor;
-  double alpha_i = 1.0;  // phase in factor for particle i
-  double alpha_j = 1.0;  // phase in factor for particle j
-  double alpha = 1.0;    // phase in factor for pair interaction (see below)
   
-  if (m_system->compute_per_particle_energy())
-  {
-    for  (int i = 0; i < N; i++)
-    {
-      Particle& p = m_system->get_particle(i);
-      p.set_pot_energy("soft",0.0);
-    }
-  }
-
-  if (m_system->record_force_type())
-    this->reset_force_types("soft");
-  
-  m_potential_energy = 0.0;
-  double tot_pot = m_potential_energy;
+  this->begin_fused(dt);
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
-    if (m_phase_in)
-      alpha_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
-    ai = pi.get_radius();
     vector<int>& neigh = m_nlist->get_neighbours(i);
     for (unsigned int j = 0; j < neigh.size(); j++)
     {
       Particle& pj = m_system->get_particle(neigh[j]);
-      if (m_phase_in)
-      {
-        alpha_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
-        // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
-        // Except for the interaction between daugthers which starts at 0
-        if (alpha_i < 1.0 && alpha_j < 1.0)
-	        alpha = alpha_i + alpha_j - 1.0;
-	      else 
-	        alpha = alpha_i*alpha_j;
-      }
-      k = m_pair_params[pi.get_type()-1][pj.get_type()-1].k;
-      aj = pj.get_radius();
       double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
       m_system->apply_periodic(dx,dy,dz);
       double r_sq = dx*dx + dy*dy + dz*dz;
-      double r = sqrt(r_sq);
-      double ai_p_aj;
-      if (!m_use_particle_radii)
-        ai_p_aj = m_pair_params[pi.get_type()-1][pj.get_type()-1].a;
-      else
-        ai_p_aj = ai+aj;
-      if (r < ai_p_aj)
+      this->pair_force(i, neigh[j], pi, pj, dx, dy, dz, r_sq);
+    }
+  }
+}
+
+/*! Pair distance and its periodic image have already been computed by the fused traversal.
+ *  \param i index of the first particle
+ *  \param j index of the second particle
+ *  \param pi first particle
+ *  \param pj second particle
+ *  \param dx x component of the distance vector
+ *  \param dy y component of the distance vector
+ *  \param dz z component of the distance vector
+ *  \param r_sq squared distance
+ */
+void PairSoftPotential::fused_pair(int i, int j, Particle& pi, Particle& pj, double dx, double dy, double dz, double r_sq)
+{
+  this->pair_force(i, j, pi, pj, dx, dy, dz, r_sq);
+}
+
+/*! Computes force and energy for a single pair of particles. Distance vector points from i to j.
+ *  \param i index of the first particle
+ *  \param j index of the second particle
+ *  \param pi first particle
+ *  \param pj second particle
+ *  \param dx x component of the distance vector
+ *  \param dy y component of the distance vector
+ *  \param dz z component of the distance vector
+ *  \param r_sq squared distance
+ */
+void PairSoftPotential::pair_force(int i, int j, Particle& pi, Particle& pj, double dx, double dy, double dz, double r_sq)
+{
+  double alpha = 1.0;    // phase in factor for pair interaction (see below)
+  double force_factor;
+  if (m_phase_in)
+  {
+    double alpha_i = 0.5*(1.0 + m_pass_phase_in[i]);  // phase in factor for particle i
+    double alpha_j = 0.5*(1.0 + m_pass_phase_in[j]);  // phase in factor for particle j
+    // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
+    // Except for the interaction between daugthers which starts at 0
+    if (alpha_i < 1.0 && alpha_j < 1.0)
+      alpha = alpha_i + alpha_j - 1.0;
+    else 
+      alpha = alpha_i*alpha_j;
+  }
+  double k = m_pair_params[pi.get_type()-1][pj.get_type()-1].k;
+  double r = sqrt(r_sq);
+  double ai_p_aj;
+  if (!m_use_particle_radii)
+    ai_p_aj = m_pair_params[pi.get_type()-1][pj.get_type()-1].a;
+  else
+    ai_p_aj = pi.get_radius()+pj.get_radius();
+  if (r < ai_p_aj)
+  {
+    double diff = ai_p_aj - r;
+    // Handle potential 
+    if (m_pass_energy)
+    {
+      double pot_eng = 0.5*k*alpha*diff*diff;
+      m_potential_energy += pot_eng;
+      if (m_system->compute_per_particle_energy())
       {
-        // Handle potential 
-        double diff = ai_p_aj - r;
-        double pot_eng = 0.5*k*alpha*diff*diff;
-        //m_potential_energy += pot_eng;
-        tot_pot += pot_eng;
-        // Handle force
-        if (r > 0.0) force_factor = k*alpha*diff/r;
-        else force_factor = k*diff;
-        pi.fx -= force_factor*dx;
-        pi.fy -= force_factor*dy;
-        pi.fz -= force_factor*dz;
-        // Use 3d Newton's law
-        pj.fx += force_factor*dx;
-        pj.fy += force_factor*dy;
-        pj.fz += force_factor*dz;
-        if (m_system->compute_per_particle_energy())
-        {
-          pi.add_pot_energy("soft",pot_eng);
-          pj.add_pot_energy("soft",pot_eng);
-        }
-        if (m_system->record_force_type())
-        {
-          pi.add_force_type("soft",-force_factor*dx,-force_factor*dy,-force_factor*dz);
-          pj.add_force_type("soft", force_factor*dx, force_factor*dy, force_factor*dz);
-        }
+        pi.add_pot_energy("soft",pot_eng);
+        pj.add_pot_energy("soft",pot_eng);
       }
     }
+    // Handle force
+    if (r > 0.0) force_factor = k*alpha*diff/r;
+    else force_factor = k*diff;
+    pi.fx -= force_factor*dx;
+    pi.fy -= force_factor*dy;
+    pi.fz -= force_factor*dz;
+    // Use 3d Newton's law
+    pj.fx += force_factor*dx;
+    pj.fy += force_factor*dy;
+    pj.fz += force_factor*dz;
+    // Accumulate pair virial
+    if (m_pass_stress)
+      m_system->add_pair_stress(i, j, dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
+    if (m_system->record_force_type())
+    {
+      pi.add_force_type("soft",-force_factor*dx,-force_factor*dy,-force_factor*dz);
+      pj.add_force_type("soft", force_factor*dx, force_factor*dy, force_factor*dz);
+    }
   }
-  m_potential_energy = tot_pot;
 }
@@ -185,12 +185,29 @@ public:
   //! Computes potentials and forces for all particles
   void compute(double);
   
+  //! Returns true since Soft potential can share neighbour list traversal with other interactions
+  bool fusable() { return true; }
+  
+  //! Prepares fused evaluation
+  void begin_fused(double dt) 
+  { 
+    this->begin_pass(dt,"soft");
+    if (m_system->record_force_type())
+      this->reset_force_types("soft");
+  }
+  
+  //! Adds interaction of a single pair of neighbours during the fused traversal
+  void fused_pair(int, int, Particle&, Particle&, double, double, double, double);
+  
   
 private:
        
   double m_k;                       //!< potential strength
   double m_a;                       //!< potential range
   SoftParameters** m_pair_params;   //!< type specific pair parameters 
+  
+  //! Force and energy of a single pair (distance vector is \f$ \vec r_j - \vec r_i \f$)
+  void pair_force(int, int, Particle&, Particle&, double, double, double, double);
      
 };
 
@@ -45,17 +45,17 @@ static int next(int i, int N)
 void PairVertexParticlePotential::compute(double dt)
 {
   int N = m_system->size();
-  double K = m_K;
-  double gamma = m_gamma;
-  double lambda = m_lambda;
-  double alpha = 1.0;  // phase in factor
-  double pot_eng = 0.0;
+  double* phase_in = (m_phase_in) ? m_system->get_phase_in(m_val, dt) : 0;  // per particle phase in values (computed once per step)
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_compute_stress && m_system->compute_stress();
   
   if (m_mesh_update_steps > 0)
     if (m_system->get_step() % m_mesh_update_steps == 0)
       m_nlist->build_mesh();
   
   Mesh& mesh = m_system->get_mesh();
+  vector<Vertex>& vertices = mesh.get_vertices();
+  vector<Face>& faces = mesh.get_faces();
   
   if (m_system->compute_per_particle_energy())
   {
@@ -66,190 +66,289 @@ void PairVertexParticlePotential::compute(double dt)
     }
   }
   
-  m_potential_energy = 0.0;
+  this->compute_corners(mesh, compute_eng);
+  
+  // Gather forces. Vertex i gets contributions from all cells that share a face with it, 
+  // including its own, i.e. from all corners at the faces in the star of i.
+#pragma omp parallel for
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
-    Vertex& vi = mesh.get_vertices()[i];
-    Vector3d Nvec = Vector3d(pi.Nx, pi.Ny, pi.Nz);
-    if (m_phase_in)
-      alpha = m_val->get_val(static_cast<int>(pi.age/dt));
-    // First handle the vertex itself
-    if (pi.in_tissue && (m_include_boundary || !vi.boundary))
+    Vertex& vi = vertices[i];
+    double alpha = (m_phase_in) ? phase_in[i] : 1.0;  // phase in factor
+    Vector3d force(0.0,0.0,0.0);
+    for (int f = 0; f < vi.n_faces; f++)
     {
-      if (m_has_part_params) 
+      int fid = vi.dual[f];
+      if (faces[fid].is_hole) continue;
+      Vector3d grad(0.0,0.0,0.0);
+      for (int k = 0; k < 3; k++)
       {
-        K  = m_particle_params[vi.type-1].K;
-        gamma = m_particle_params[vi.type-1].gamma;
-        lambda = m_particle_params[vi.type-1].lambda;
+        int c = m_face_corner[3*fid+k];
+        if (c >= 0) grad += m_corner_grad[c];
       }
-      double dA = 0.0; 
-      dA = (vi.area - pi.A0);
-      double area_term = 0.5*K*dA;
-      double perim_term = gamma*vi.perim;
-      pot_eng = 0.5*(K*dA*dA+gamma*vi.perim*vi.perim);
-      Vector3d area_vec(0.0,0.0,0.0);
-      Vector3d perim_vec(0.0,0.0,0.0);
-      Vector3d con_vec(0.0,0.0,0.0);
-      for (int f = 0; f < vi.n_faces; f++)
+      force += grad*m_corner_jacobian[m_corner_offset[i]+f];
+    }
+    pi.fx -= alpha*force.x;
+    pi.fy -= alpha*force.y;
+    pi.fz -= alpha*force.z;
+    if (compute_stress && !vi.boundary && vi.area > 0)
+    {
+      // stress is rescaled once for each neighbouring cell that contributes to the force
+      double inv_area = 1.0/vi.area;
+      double* s = m_system->get_stress(i);
+      for (int j = 0; j < vi.n_edges; j++)
       {
-        int fid = vi.dual[f];
-        int fid_m = vi.dual[prev(f,vi.n_faces)];
-        int fid_p = vi.dual[next(f,vi.n_faces)];
-        
-        Face& f_nu_m = mesh.get_faces()[fid_m];
-        Face& f_nu   = mesh.get_faces()[fid];
-        Face& f_nu_p = mesh.get_faces()[fid_p];
-         
-        Vector3d& r_nu_m = f_nu_m.rc; 
-        Vector3d& r_nu   = f_nu.rc; 
-        Vector3d& r_nu_p = f_nu_p.rc; 
-        
-        Vector3d cross_prod_1(0.0,0.0,0.0);
-        if (!(f_nu.is_hole || f_nu_p.is_hole)) cross_prod_1 = (cross(r_nu_p, Nvec))*f_nu.get_jacobian(i);
-        if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_1 = cross_prod_1 - (cross(r_nu_m, Nvec))*f_nu.get_jacobian(i);
-        area_vec = area_vec + cross_prod_1;  
-        
-        Vector3d cross_prod_2(0.0,0.0,0.0);
-        if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_2 = ((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i);
-        if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_2 -= (((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i));
-        perim_vec = perim_vec + cross_prod_2; 
-        
-        // Adding force contributions from the dual edges associated with face f and face next(f,vi.n_faces)
-        if (m_has_pair_params)
-        {
-          Vertex& vn = mesh.get_vertices()[vi.dual_neighbour_map[f]];
-          lambda = m_pair_params[vi.type-1][vn.type-1].lambda;
-        } 
-        Vector3d cross_prod_3(0.0,0.0,0.0);
-        if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_3 = lambda*(((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i));
-        con_vec = con_vec + cross_prod_3; 
-        
-        // Adding force contributions from the dual edges associated with face f and face prev(f,vi.n_faces)
-        if (m_has_pair_params)
-        {
-          Vertex& vn = mesh.get_vertices()[vi.dual_neighbour_map[next(f,vi.n_faces)]];
-          lambda = m_pair_params[vi.type-1][vn.type-1].lambda;
-        } 
-        Vector3d cross_prod_4(0.0,0.0,0.0);
-        if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_4 = lambda*(((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i));
-        con_vec = con_vec - cross_prod_4; 
-        
-        pot_eng += lambda*(r_nu - r_nu_m).len();
+        Particle& pj = m_system->get_particle(vi.neigh[j]);
+        Vertex& vj = vertices[vi.neigh[j]];
+        if (pj.in_tissue && (m_include_boundary || !vj.boundary))
+          for (int k = 0; k < 9; k++)
+            s[k] *= inv_area;
       }
-      // area term
-      double area_fact = -alpha*area_term;
-      pi.fx += area_fact*area_vec.x;
-      pi.fy += area_fact*area_vec.y;
-      pi.fz += area_fact*area_vec.z;
-      // perimeter term 
-      double perim_fact = -alpha*perim_term;
-      pi.fx += perim_fact*perim_vec.x;
-      pi.fy += perim_fact*perim_vec.y;
-      pi.fz += perim_fact*perim_vec.z;
-      // Add contractile term
-      pi.fx -= alpha*con_vec.x;
-      pi.fy -= alpha*con_vec.y;
-      pi.fz -= alpha*con_vec.z;
-      // add potential energy
-      m_potential_energy += pot_eng;
     }
-    // Now check neighbours
-    for (int j = 0; j < vi.n_edges; j++)
+    if (m_system->compute_per_particle_energy())
+      pi.add_pot_energy("vp",m_cell_energy[i]);
+  }
+  
+  if (compute_eng)
+  {
+    m_potential_energy = 0.0;
+    for (int i = 0; i < N; i++)
+      m_potential_energy += m_cell_energy[i];
+  }
+}
+
+/*! The Hessian of the cell energy \f$ E = \frac{K}{2}\left(A-A_0\right)^2 + \frac{\Gamma}{2}P^2 + \sum\lambda l \f$ 
+ *  is approximated by \f$ K\nabla A\otimes\nabla A + \Gamma\nabla P\otimes\nabla P + \sum\left(\Gamma P+\lambda\right)\nabla\nabla l \f$,
+ *  where the last sum runs over dual edges under positive tension, \f$ \Gamma P+\lambda > 0 \f$. The second derivatives of 
+ *  the area and the edges under negative tension are neglected, which keeps the approximation positive semi-definite while 
+ *  retaining the stiff area, perimeter and line tension modes. For edge length \f$ l=|\mathbf{e}| \f$, 
+ *  \f$ \nabla\nabla l = \frac{1}{l}\left(I-\hat{\mathbf{e}}\otimes\hat{\mathbf{e}}\right) \f$ which is written as a sum of two 
+ *  outer products of vectors perpendicular to the edge.
+ *  Derivatives of area, perimeter and edges of each cell with respect to positions of all vertices of the faces 
+ *  in its dual are obtained from the corner data and face Jacobians.
+ *  \param H matrix to which the Hessian is added
+ *  \return true
+ */
+bool PairVertexParticlePotential::add_hessian(BlockSparseMatrix& H)
+{
+  int N = m_system->size();
+  Mesh& mesh = m_system->get_mesh();
+  vector<Vertex>& vertices = mesh.get_vertices();
+  vector<Face>& faces = mesh.get_faces();
+  vector<int> support;     // vertices that the cell area and perimeter depend on
+  vector<Vector3d> dA;     // derivatives of the cell area with respect to positions of those vertices
+  vector<Vector3d> dP;     // derivatives of the cell perimeter with respect to positions of those vertices
+  vector<int> e_support;   // vertices that a dual edge depends on
+  vector<Vector3d> de_1;   // derivatives of the edge projected onto the first direction perpendicular to it
+  vector<Vector3d> de_2;   // derivatives of the edge projected onto the second direction perpendicular to it
+  
+  this->compute_corners(mesh, false);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    Vertex& vi = vertices[i];
+    if (!(pi.in_tissue && (m_include_boundary || !vi.boundary)))
+      continue;
+    double K = m_K;
+    double gamma = m_gamma;
+    double lambda = m_lambda;
+    if (m_has_part_params) 
     {
-      Particle& pj = m_system->get_particle(vi.neigh[j]);
-      Vertex& vj = mesh.get_vertices()[vi.neigh[j]];
-      if (pj.in_tissue && (m_include_boundary || !vj.boundary))  
+      K  = m_particle_params[vi.type-1].K;
+      gamma = m_particle_params[vi.type-1].gamma;
+      lambda = m_particle_params[vi.type-1].lambda;
+    }
+    Vector3d Nvec = Vector3d(pi.Nx, pi.Ny, pi.Nz);
+    int offset = m_corner_offset[i];
+    int n_faces = vi.n_faces;
+    support.clear();
+    dA.clear();
+    dP.clear();
+    for (int f = 0; f < n_faces; f++)
+    {
+      Face& f_nu = faces[vi.dual[f]];
+      if (f_nu.is_hole) continue;
+      int c_m = offset + f;
+      int c_p = offset + next(f,n_faces);
+      Vector3d dA_nu(0.0,0.0,0.0), dP_nu(0.0,0.0,0.0);   // derivatives with respect to the face centre
+      if (m_edge_ok[c_m])
       {
-        if (m_has_part_params) 
+        dA_nu -= 0.5*cross(faces[vi.dual[prev(f,n_faces)]].rc, Nvec);
+        dP_nu += m_edge_unit[c_m];
+      }
+      if (m_edge_ok[c_p])
+      {
+        dA_nu += 0.5*cross(faces[vi.dual[next(f,n_faces)]].rc, Nvec);
+        dP_nu -= m_edge_unit[c_p];
+      }
+      for (int k = 0; k < 3; k++)
+      {
+        unsigned int s = find(support.begin(), support.end(), f_nu.vertices[k]) - support.begin();
+        if (s == support.size())
         {
-          K  = m_particle_params[vj.type-1].K;
-          gamma = m_particle_params[vj.type-1].gamma;
-          lambda = m_particle_params[vj.type-1].lambda;
+          support.push_back(f_nu.vertices[k]);
+          dA.push_back(Vector3d(0.0,0.0,0.0));
+          dP.push_back(Vector3d(0.0,0.0,0.0));
         }
-        double dA = 0.0;
-        dA = (vj.area - pj.A0);
-        double area_term = 0.5*K*dA;
-        double perim_term = gamma*vj.perim;
-        Vector3d area_vec(0.0,0.0,0.0);
-        Vector3d perim_vec(0.0,0.0,0.0);
-        Vector3d con_vec(0.0,0.0,0.0);
-        Vector3d Nvec = Vector3d(pj.Nx, pj.Ny, pj.Nz);
-        
-        for (int f = 0; f < vj.n_faces; f++)
+        dA[s] += dA_nu*f_nu.drcdr[k];
+        dP[s] += dP_nu*f_nu.drcdr[k];
+      }
+    }
+    for (unsigned int s = 0; s < support.size(); s++)
+      for (unsigned int t = 0; t < support.size(); t++)
+      {
+        H.add_outer(support[s], support[t], K, dA[s], dA[t]);
+        H.add_outer(support[s], support[t], gamma, dP[s], dP[t]);
+      }
+    // Curvature of dual edges under positive tension
+    for (int f = 0; f < n_faces; f++)
+    {
+      int c = offset + f;        // dual edge between faces prev(f) and f
+      if (!m_edge_ok[c] || m_edge_len[c] <= 0.0) continue;
+      double lambda_e = lambda;
+      if (m_has_pair_params)
+        lambda_e = m_pair_params[vi.type-1][vertices[vi.dual_neighbour_map[f]].type-1].lambda;
+      double tension = gamma*vi.perim + lambda_e;
+      if (tension <= 0.0) continue;
+      Vector3d& u = m_edge_unit[c];
+      Vector3d w_1 = cross(Nvec, u);
+      if (w_1.len() < 1e-8)
+        w_1 = cross(Vector3d(fabs(u.x) < 0.9 ? 1.0 : 0.0, fabs(u.x) < 0.9 ? 0.0 : 1.0, 0.0), u);
+      w_1 = w_1.unit();
+      Vector3d w_2 = cross(u, w_1);
+      e_support.clear();
+      de_1.clear();
+      de_2.clear();
+      for (int end = 0; end < 2; end++)
+      {
+        Face& f_nu = faces[vi.dual[end == 0 ? f : prev(f,n_faces)]];
+        double sign = (end == 0) ? 1.0 : -1.0;
+        for (int k = 0; k < 3; k++)
         {
-          int fid = vj.dual[f];
-          Face& f_nu   = mesh.get_faces()[fid];
-          if (f_nu.has_vertex(i))
+          unsigned int s = find(e_support.begin(), e_support.end(), f_nu.vertices[k]) - e_support.begin();
+          if (s == e_support.size())
           {
-            int fid_m = vj.dual[prev(f,vj.n_faces)];
-            int fid_p = vj.dual[next(f,vj.n_faces)];
-            Face& f_nu_m = mesh.get_faces()[fid_m];
-            Face& f_nu_p = mesh.get_faces()[fid_p];
-            Vector3d& r_nu_m = f_nu_m.rc; 
-            Vector3d& r_nu   = f_nu.rc; 
-            Vector3d& r_nu_p = f_nu_p.rc; 
-
-            Vector3d cross_prod_1(0.0,0.0,0.0);
-            if (!(f_nu.is_hole || f_nu_p.is_hole)) cross_prod_1 = cross(r_nu_p, Nvec)*f_nu.get_jacobian(i);
-            if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_1 = cross_prod_1 - cross(r_nu_m, Nvec)*f_nu.get_jacobian(i);
-            area_vec = area_vec + cross_prod_1; 
-            
-            Vector3d cross_prod_2(0.0,0.0,0.0);
-            if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_2 = ((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i);
-            if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_2 -= ((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i);
-            perim_vec = perim_vec + cross_prod_2; 
-            
-            // Adding force contributions from the dual edges associated with face f and face next(f,vi.n_faces)
-            if (m_has_pair_params)
-            {
-              Vertex& vn = mesh.get_vertices()[vj.dual_neighbour_map[f]];
-              lambda = m_pair_params[vj.type-1][vn.type-1].lambda;
-            } 
-            Vector3d cross_prod_3(0.0,0.0,0.0);
-            if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_3 = lambda*(((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i));
-            con_vec = con_vec + cross_prod_3; 
-
-            // Adding force contributions from the dual edges associated with face f and face next(f,vi.n_faces)
-            if (m_has_pair_params)
-            {
-              Vertex& vn = mesh.get_vertices()[vj.dual_neighbour_map[next(f,vj.n_faces)]];
-              lambda = m_pair_params[vj.type-1][vn.type-1].lambda;
-            } 
-            Vector3d cross_prod_4(0.0,0.0,0.0);
-            if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_4 = lambda*(((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i));
-            con_vec = con_vec - cross_prod_4; 
-            
+            e_support.push_back(f_nu.vertices[k]);
+            de_1.push_back(Vector3d(0.0,0.0,0.0));
+            de_2.push_back(Vector3d(0.0,0.0,0.0));
           }
+          de_1[s] += sign*(w_1*f_nu.drcdr[k]);
+          de_2[s] += sign*(w_2*f_nu.drcdr[k]);
         }
-        // area term
-        double area_fact = -alpha*area_term;
-        pi.fx += area_fact*area_vec.x;
-        pi.fy += area_fact*area_vec.y;
-        pi.fz += area_fact*area_vec.z;
-        // perimeter term
-        double perim_fact = -alpha*perim_term;
-        pi.fx += perim_fact*perim_vec.x;
-        pi.fy += perim_fact*perim_vec.y;
-        pi.fz += perim_fact*perim_vec.z;
-        // Add contractile term
-        pi.fx -= alpha*con_vec.x;
-        pi.fy -= alpha*con_vec.y;
-        pi.fz -= alpha*con_vec.z;
-        if (m_compute_stress)
+      }
+      double fact = tension/m_edge_len[c];
+      for (unsigned int s = 0; s < e_support.size(); s++)
+        for (unsigned int t = 0; t < e_support.size(); t++)
         {
-          if (!vi.boundary && vi.area > 0)
+          H.add_outer(e_support[s], e_support[t], fact, de_1[s], de_1[t]);
+          H.add_outer(e_support[s], e_support[t], fact, de_2[s], de_2[t]);
+        }
+    }
+  }
+  return true;
+}
+
+/*! Face-centric precomputation. For each cell (vertex) and each corner of its dual (face centre), 
+ *  stores the dual edge that ends at the corner, the Jacobian of the face centre with respect to the vertex
+ *  and the derivative of the cell energy with respect to the position of the face centre. Also records 
+ *  for each face which corner belongs to which of its vertices. Cells are processed in parallel.
+ *  \param mesh reference to the mesh
+ *  \param compute_eng if true, compute energy of each cell
+ */
+void PairVertexParticlePotential::compute_corners(Mesh& mesh, bool compute_eng)
+{
+  int N = m_system->size();
+  vector<Vertex>& vertices = mesh.get_vertices();
+  vector<Face>& faces = mesh.get_faces();
+  
+  m_corner_offset.resize(N+1);
+  m_corner_offset[0] = 0;
+  for (int i = 0; i < N; i++)
+    m_corner_offset[i+1] = m_corner_offset[i] + vertices[i].n_faces;
+  int n_corners = m_corner_offset[N];
+  m_edge_ok.resize(n_corners);
+  m_edge_len.resize(n_corners);
+  m_edge_unit.resize(n_corners);
+  m_corner_jacobian.resize(n_corners);
+  m_corner_grad.resize(n_corners);
+  m_cell_energy.resize(N);
+  m_face_corner.assign(3*faces.size(),-1);
+  
+#pragma omp parallel for
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    Vertex& vi = vertices[i];
+    int offset = m_corner_offset[i];
+    int n_faces = vi.n_faces;
+    // Dual edges and Jacobians
+    for (int f = 0; f < n_faces; f++)
+    {
+      int c = offset + f;
+      int fid = vi.dual[f];
+      Face& f_nu_m = faces[vi.dual[prev(f,n_faces)]];
+      Face& f_nu   = faces[fid];
+      Vector3d edge = f_nu.rc - f_nu_m.rc;
+      m_edge_ok[c] = !(f_nu_m.is_hole || f_nu.is_hole);
+      m_edge_len[c] = edge.len();
+      m_edge_unit[c] = edge.unit();
+      if (!f_nu.is_hole)
+      {
+        for (int k = 0; k < f_nu.n_sides; k++)
+          if (f_nu.vertices[k] == i)
           {
-            double inv_area = 1.0/vi.area;
-            pi.s_xx *= inv_area;  pi.s_xy *= inv_area; pi.s_xz *= inv_area;
-            pi.s_yx *= inv_area;  pi.s_yy *= inv_area; pi.s_yz *= inv_area;
-            pi.s_zx *= inv_area;  pi.s_zy *= inv_area; pi.s_zz *= inv_area;
+            m_corner_jacobian[c] = f_nu.drcdr[k];
+            if (k < 3) m_face_corner[3*fid+k] = c;
+            break;
           }
-        }
       }
     }
-    // potential energy
-    if (m_system->compute_per_particle_energy())
-      pi.add_pot_energy("vp",pot_eng);
+    // Derivatives of the cell energy with respect to face centres
+    if (!(pi.in_tissue && (m_include_boundary || !vi.boundary)))
+    {
+      for (int f = 0; f < n_faces; f++)
+        m_corner_grad[offset+f] = Vector3d(0.0,0.0,0.0);
+      m_cell_energy[i] = 0.0;
+      continue;
+    }
+    double K = m_K;
+    double gamma = m_gamma;
+    double lambda = m_lambda;
+    if (m_has_part_params) 
+    {
+      K  = m_particle_params[vi.type-1].K;
+      gamma = m_particle_params[vi.type-1].gamma;
+      lambda = m_particle_params[vi.type-1].lambda;
+    }
+    double dA = vi.area - pi.A0;
+    double area_term = 0.5*K*dA;
+    double perim_term = gamma*vi.perim;
+    double pot_eng = 0.0;
+    if (compute_eng)
+      pot_eng = 0.5*(K*dA*dA+gamma*vi.perim*vi.perim);
+    Vector3d Nvec = Vector3d(pi.Nx, pi.Ny, pi.Nz);
+    for (int f = 0; f < n_faces; f++)
+    {
+      int c_m = offset + f;                   // dual edge between faces prev(f) and f
+      int c_p = offset + next(f,n_faces);     // dual edge between faces f and next(f)
+      Vector3d& r_nu_m = faces[vi.dual[prev(f,n_faces)]].rc;
+      Vector3d& r_nu_p = faces[vi.dual[next(f,n_faces)]].rc;
+      double lambda_m = lambda, lambda_p = lambda;
+      if (m_has_pair_params)
+      {
+        lambda_m = m_pair_params[vi.type-1][vertices[vi.dual_neighbour_map[f]].type-1].lambda;
+        lambda_p = m_pair_params[vi.type-1][vertices[vi.dual_neighbour_map[next(f,n_faces)]].type-1].lambda;
+      }
+      Vector3d grad(0.0,0.0,0.0);
+      if (m_edge_ok[c_m])
+        grad += (perim_term + lambda_m)*m_edge_unit[c_m] - area_term*cross(r_nu_m, Nvec);
+      if (m_edge_ok[c_p])
+        grad += area_term*cross(r_nu_p, Nvec) - (perim_term + lambda_p)*m_edge_unit[c_p];
+      m_corner_grad[c_m] = grad;
+      if (compute_eng)
+        pot_eng += lambda_m*m_edge_len[c_m];
+    }
+    m_cell_energy[i] = pot_eng;
   }
 }
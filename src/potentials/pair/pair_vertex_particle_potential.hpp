@@ -31,11 +31,13 @@
 #define __PAIR_VERTEX_PARTICLE_POTENTIAL_HPP__
 
 #include <cmath>
+#include <vector>
 
 #include "pair_potential.hpp"
 
 using std::make_pair;
 using std::sqrt;
+using std::vector;
 
 //! Structure that handles parameters for the vertex-particle pair potential
 struct VertexParticleParameters
@@ -46,6 +48,15 @@ struct VertexParticleParameters
 };
 
 /*! PairVertexParticlePotential implements the vertex-particle model for an active tissue model.
+ *  
+ *  Force is computed in two passes. The first pass goes over all cells (dual of each vertex) and 
+ *  stores, for each corner of the cell (face centre in the dual), the length and the unit vector of the 
+ *  dual edge ending at that corner, the Jacobian of the face centre with respect to the vertex
+ *  and the derivative of the cell energy with respect to the position of the face centre. 
+ *  All this is kept in flat arrays indexed by corners. The second pass gathers the force on each vertex 
+ *  by summing corner derivatives of all cells sharing a face with it and multiplying them by the
+ *  stored Jacobians. Both passes are parallel (if compiled with OpenMP) since each of them writes 
+ *  only into the slots that belong to the cell or vertex it handles.
  *  \todo Document the force.
  */
 class PairVertexParticlePotential : public PairPotential
@@ -275,6 +286,9 @@ public:
   //! Computes potentials and forces for all particles
   void compute(double);
   
+  //! Adds positive semi-definite approximation of the Hessian of the vertex model energy
+  bool add_hessian(BlockSparseMatrix&);
+  
   
 private:
        
@@ -286,6 +300,18 @@ private:
   bool m_include_boundary;          //!< if true, include boudary terms in force calculation
   VertexParticleParameters*  m_particle_params;   //!< type specific particle parameters 
   VertexParticleParameters** m_pair_params;       //!< type specific pair parameters 
+  
+  vector<int> m_corner_offset;          //!< index of the first corner of each cell in the per corner arrays
+  vector<int> m_face_corner;            //!< for each triangular face, corner indices belonging to each of its three vertices (-1 if none)
+  vector<char> m_edge_ok;               //!< true if neither of the two faces bounding the dual edge ending at the corner is a hole
+  vector<double> m_edge_len;            //!< length of the dual edge ending at the corner
+  vector<Vector3d> m_edge_unit;         //!< unit vector along the dual edge ending at the corner
+  vector<Matrix3d> m_corner_jacobian;   //!< Jacobian of the face centre at the corner with respect to the cell vertex
+  vector<Vector3d> m_corner_grad;       //!< derivative of the cell energy with respect to the face centre at the corner
+  vector<double> m_cell_energy;         //!< energy of each cell 
+  
+  //! Compute dual edges, Jacobians and energy derivatives at all cell corners
+  void compute_corners(Mesh&, bool);
      
 };
 
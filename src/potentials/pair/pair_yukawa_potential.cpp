@@ -31,11 +31,18 @@
 
 void PairYukawaPotential::compute(double dt)
 {
+  if (m_treecode)
+  {
+    this->compute_tree();
+    return;
+  }
   int N = m_system->size();
   double g = m_g;
   double kappa = m_kappa;
   double rcut = m_rcut;
   double rcut_sq = rcut*rcut;
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  bool compute_stress = m_system->compute_stress();  // if true, some dump or logger needs stress in this step
   
   if (m_system->compute_per_particle_energy())
   {
@@ -47,7 +54,8 @@ void PairYukawaPotential::compute(double dt)
   }
 
   // Reset total potential energy to zero
-  m_potential_energy = 0.0;
+  if (compute_eng)
+    m_potential_energy = 0.0;
   for  (int i = 0; i < N; i++)
   {
     Particle& pi = m_system->get_particle(i);
@@ -55,6 +63,11 @@ void PairYukawaPotential::compute(double dt)
     for (unsigned int j = 0; j < neigh.size(); j++)
     {
       Particle& pj = m_system->get_particle(neigh[j]);
+      if (m_has_pair_params)
+      {
+        rcut = m_pair_params[pi.get_type()-1][pj.get_type()-1].rcut;
+        rcut_sq = rcut*rcut;
+      }
       double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
       m_system->apply_periodic(dx,dy,dz);
       double r_sq = dx*dx + dy*dy + dz*dz;
@@ -69,8 +82,18 @@ void PairYukawaPotential::compute(double dt)
         double r = sqrt(r_sq);
         double exp_fact = g*exp(-kappa*r);
         // Handle potential 
-        double potential_energy = exp_fact/r;
-        m_potential_energy += potential_energy;
+        if (compute_eng)
+        {
+          double potential_energy = exp_fact/r;
+          if (m_shifted)
+            potential_energy -= g*exp(-kappa*rcut)/rcut;
+          m_potential_energy += potential_energy;
+          if (m_system->compute_per_particle_energy())
+          {
+            pi.add_pot_energy("yukawa",potential_energy);
+            pj.add_pot_energy("yukawa",potential_energy);
+          }
+        }
         // Handle force
         double force_factor = exp_fact*(1 + kappa*r)/(r_sq*r);
         pi.fx += force_factor*dx;
@@ -80,12 +103,101 @@ void PairYukawaPotential::compute(double dt)
         pj.fx -= force_factor*dx;
         pj.fy -= force_factor*dy;
         pj.fz -= force_factor*dz;
-        if (m_system->compute_per_particle_energy())
-        {
-          pi.add_pot_energy("yukawa",potential_energy);
-          pj.add_pot_energy("yukawa",potential_energy);
-        }
+        // Accumulate pair virial
+        if (compute_stress)
+          m_system->add_pair_stress(i, neigh[j], dx, dy, dz, force_factor*dx, force_factor*dy, force_factor*dz);
       }
     }
   }
 }
+
+/*! Treecode evaluation for non-periodic systems. Potential and field each particle feels 
+ *  are computed using the octree. 
+ */
+void PairYukawaPotential::compute_tree()
+{
+  int N = m_system->size();
+  bool compute_eng = m_system->compute_energy();  // if false, this is a forces only step
+  
+  if (m_system->compute_per_particle_energy())
+  {
+    for  (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      p.set_pot_energy("yukawa",0.0);
+    }
+  }
+  
+  if (compute_eng)
+    m_potential_energy = 0.0;
+  m_q.resize(N);
+  for (int i = 0; i < N; i++)
+    m_q[i] = m_charge[m_system->get_particle(i).get_type() - 1];
+  m_octree->build(m_q);
+  m_octree->compute_field(m_kappa, m_phi, m_ex, m_ey, m_ez);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    double fact = m_g*m_q[i];
+    p.fx += fact*m_ex[i];
+    p.fy += fact*m_ey[i];
+    p.fz += fact*m_ez[i];
+    if (compute_eng)
+    {
+      m_potential_energy += 0.5*fact*m_phi[i];
+      if (m_system->compute_per_particle_energy())
+        p.add_pot_energy("yukawa",fact*m_phi[i]);
+    }
+  }
+}
+
+/*! Cutoff distance \f$ r_c \f$ is the solution of \f$ |g|e^{-\kappa r_c}/r_c = tol \f$, i.e. 
+ *  of \f$ \kappa r_c + \ln r_c = \ln\left(|g|/tol\right) \f$. The left hand side is monotonic in \f$ r_c \f$ 
+ *  so we simply bisect.
+ *  \param g potential strength
+ *  \param kappa inverse screening length
+ *  \return cutoff distance
+ */
+double PairYukawaPotential::tolerance_cutoff(double g, double kappa)
+{
+  double target = log(fabs(g)/m_tolerance);
+  double r_lo = 0.0, r_hi = 1.0;
+  while (kappa*r_hi + log(r_hi) < target)
+    r_hi *= 2.0;
+  for (int i = 0; i < 100; i++)
+  {
+    double r = 0.5*(r_lo + r_hi);
+    if (kappa*r + log(r) < target)
+      r_lo = r;
+    else
+      r_hi = r;
+  }
+  return r_hi;
+}
+
+/*! Reports the value of the potential and force at the cutoff and the mean-field estimate of the 
+ *  energy per particle neglected by truncating the potential. The latter assumes uniform density \f$ \rho = N/V \f$ 
+ *  and is given by \f$ \frac{\rho}{2}\int_{r_c}^{\infty}4\pi r^2 U(r) dr = 
+ *  2\pi\rho g e^{-\kappa r_c}\left(\frac{r_c}{\kappa}+\frac{1}{\kappa^2}\right) \f$.
+ *  \param g potential strength
+ *  \param kappa inverse screening length
+ *  \param rcut cutoff distance
+ *  \param what description of the parameter set (global or pair of types)
+ */
+void PairYukawaPotential::report_truncation_error(double g, double kappa, double rcut, const string& what)
+{
+  BoxPtr box = m_system->get_box();
+  double rho = m_system->size()/(box->Lx*box->Ly*box->Lz);
+  double exp_fact = g*exp(-kappa*rcut);
+  double u_cut = exp_fact/rcut;
+  double f_cut = exp_fact*(1.0 + kappa*rcut)/(rcut*rcut);
+  m_msg->msg(Messenger::INFO,what+" Yukawa truncation error at rcut = "+lexical_cast<string>(rcut)+
+                             ". Potential : "+lexical_cast<string>(u_cut)+". Force : "+lexical_cast<string>(f_cut)+".");
+  if (kappa > 0.0)
+  {
+    double u_tail = 2.0*M_PI*rho*exp_fact*(rcut/kappa + 1.0/(kappa*kappa));
+    m_msg->msg(Messenger::INFO,what+" Yukawa truncation error. Neglected energy per particle (uniform density) : "+lexical_cast<string>(u_tail)+".");
+  }
+  else
+    m_msg->msg(Messenger::WARNING,what+" Yukawa potential is unscreened (kappa = 0). Truncation error is not bounded.");
+}
@@ -31,11 +31,14 @@
 #define __PAIR_YUKAWA_POTENTIAL_HPP__
 
 #include <cmath>
+#include <vector>
 
 #include "pair_potential.hpp"
+#include "octree.hpp"
 
 using std::make_pair;
 using std::sqrt;
+using std::vector;
 
 //! Structure that handles parameters for the Yukawa pair potential
 struct YukawaParameters
@@ -49,6 +52,17 @@ struct YukawaParameters
  *  \f$ U_{Yukawa}\left(r_{ij}\right) = g\frac{e^{-\kappa r_{ij}}}{r_{ij}} \f$,
  *  where \f$ g \f$ is the potential strength, \f$ \kappa \f$ is the inverse potentail range and \f$ r_{ij} \f$ is the 
  *  interparticle distance.
+ *
+ *  Interactions are truncated at rcut and evaluated using the neighbour list. Instead of rcut it is possible to 
+ *  specify a tolerance, in which case the cutoff is chosen such that \f$ |g|e^{-\kappa r_c}/r_c \f$ equals the 
+ *  tolerance. If shifted is set, the potential is shifted to zero at the cutoff. For each cutoff the 
+ *  truncation error (potential and force at the cutoff and mean-field estimate of the neglected energy per 
+ *  particle assuming uniform density) is reported.
+ *
+ *  In non-periodic systems (e.g. on closed surfaces) interactions can be evaluated with a Barnes-Hut treecode 
+ *  (parameter treecode) with opening angle theta. In that case each particle type carries a charge \f$ q \f$ 
+ *  (set with pair_type_param, default 1) and the potential is \f$ g q_i q_j e^{-\kappa r_{ij}}/r_{ij} \f$ with global 
+ *  \f$ g \f$ and \f$ \kappa \f$, without a cutoff.
  */
 class PairYukawaPotential : public PairPotential
 {
@@ -65,6 +79,10 @@ public:
     m_known_params.push_back("g");
     m_known_params.push_back("kappa");
     m_known_params.push_back("rcut");
+    m_known_params.push_back("tolerance");
+    m_known_params.push_back("shifted");
+    m_known_params.push_back("treecode");
+    m_known_params.push_back("theta");
     string param_test = this->params_ok(param);
     if (param_test != "")
     {
@@ -94,17 +112,77 @@ public:
       m_kappa = lexical_cast<double>(param["kappa"]);
     }
     m_msg->write_config("potential.pair.Yukawa.kappa",lexical_cast<string>(m_kappa));
-    if (param.find("rcut") == param.end())
+    m_tolerance = 0.0;
+    if (param.find("tolerance") != param.end())
     {
-      m_msg->msg(Messenger::WARNING,"No cutoff distance (rcut) specified for the Yukawa pair potential. Setting it to 3.0.");
-      m_rcut = 3.0;
+      m_tolerance = lexical_cast<double>(param["tolerance"]);
+      if (m_tolerance <= 0.0)
+      {
+        m_msg->msg(Messenger::ERROR,"Tolerance for Yukawa pair potential has to be positive.");
+        throw runtime_error("Invalid tolerance in Yukawa potential.");
+      }
+      m_msg->write_config("potential.pair.yukawa.tolerance",lexical_cast<string>(m_tolerance));
     }
-    else
+    if (param.find("rcut") != param.end())
     {
       m_msg->msg(Messenger::INFO,"Global cutoff distance (rcut) for Yukawa pair potential is set to "+param["rcut"]+".");
       m_rcut = lexical_cast<double>(param["rcut"]);
+      if (m_tolerance > 0.0)
+        m_msg->msg(Messenger::WARNING,"Both rcut and tolerance specified for Yukawa pair potential. Tolerance will be ignored.");
+    }
+    else if (m_tolerance > 0.0)
+    {
+      m_rcut = this->tolerance_cutoff(m_g, m_kappa);
+      m_msg->msg(Messenger::INFO,"Global cutoff distance (rcut) for Yukawa pair potential is set to "+lexical_cast<string>(m_rcut)+" based on tolerance "+param["tolerance"]+".");
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,"No cutoff distance (rcut) specified for the Yukawa pair potential. Setting it to 3.0.");
+      m_rcut = 3.0;
     }
     m_msg->write_config("potential.pair.yukawa.rcut",lexical_cast<string>(m_rcut));
+    if (param.find("shifted") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Yukawa potential shifted to zero at cutoff.");
+      m_shifted = true;
+      m_msg->write_config("potential.pair.yukawa.shifted","true");
+    }
+    m_charge.resize(m_ntypes, 1.0);
+    m_treecode = false;
+    if (param.find("treecode") != param.end())
+    {
+      if (m_system->get_periodic())
+      {
+        m_msg->msg(Messenger::ERROR,"Treecode evaluation of Yukawa pair potential does not support periodic boundary conditions.");
+        throw runtime_error("Treecode Yukawa potential in a periodic system.");
+      }
+      m_msg->msg(Messenger::INFO,"Yukawa pair potential. Interactions will be computed using the treecode method.");
+      m_treecode = true;
+      m_msg->write_config("potential.pair.yukawa.treecode","true");
+      double theta = 0.5;
+      if (param.find("theta") == param.end())
+        m_msg->msg(Messenger::WARNING,"No opening angle (theta) specified for treecode Yukawa pair potential. Setting it to 0.5.");
+      else
+      {
+        m_msg->msg(Messenger::INFO,"Opening angle (theta) for treecode Yukawa pair potential is set to "+param["theta"]+".");
+        theta = lexical_cast<double>(param["theta"]);
+      }
+      if (theta <= 0.0 || theta >= 1.0)
+      {
+        m_msg->msg(Messenger::ERROR,"Opening angle (theta) for treecode Yukawa pair potential has to be between 0 and 1.");
+        throw runtime_error("Invalid treecode opening angle.");
+      }
+      m_msg->write_config("potential.pair.yukawa.theta",lexical_cast<string>(theta));
+      m_octree = boost::make_shared<Octree>(Octree(m_system, m_msg, theta, OCTREE_LEAF_SIZE));
+    }
+    else
+    {
+      if (m_rcut > m_nlist->get_cutoff())
+        m_msg->msg(Messenger::WARNING,"Neighbour list cutoff distance (" + lexical_cast<string>(m_nlist->get_cutoff())+
+        " is smaller than the Yukawa cuttof distance ("+lexical_cast<string>(m_rcut)+
+        "). Results will not be reliable.");
+      this->report_truncation_error(m_g, m_kappa, m_rcut, "Global");
+    }
     
     m_pair_params = new YukawaParameters*[m_ntypes];
     for (int i = 0; i < m_ntypes; i++)
@@ -171,11 +249,24 @@ public:
       m_msg->msg(Messenger::INFO,"Yukawa pair potential. Setting rcut to "+pair_param["rcut"]+" for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
       param["rcut"] = lexical_cast<double>(pair_param["rcut"]);
     }
+    else if (m_tolerance > 0.0)
+    {
+      param["rcut"] = this->tolerance_cutoff(param["g"], param["kappa"]);
+      m_msg->msg(Messenger::INFO,"Yukawa pair potential. Setting rcut to "+lexical_cast<string>(param["rcut"])+" based on tolerance for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
+    }
     else
     {
       m_msg->msg(Messenger::INFO,"Yukawa pair potential. Using default rcut ("+lexical_cast<string>(m_rcut)+") for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
       param["rcut"] = m_rcut;
     }
+    if (!m_treecode)
+    {
+      if (param["rcut"] > m_nlist->get_cutoff())
+        m_msg->msg(Messenger::WARNING,"Neighbour list cutoff distance (" + lexical_cast<string>(m_nlist->get_cutoff())+
+        " is smaller than the Yukawa cuttof distance ("+lexical_cast<string>(param["rcut"])+
+        ") for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+". Results will not be reliable.");
+      this->report_truncation_error(param["g"], param["kappa"], param["rcut"], "Types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2));
+    }
     m_msg->write_config("potential.pair.yukawa.type_"+pair_param["type_1"]+"_and_type_"+pair_param["type_2"]+".rcut",lexical_cast<string>(param["rcut"]));
     m_msg->write_config("potential.pair.Yukawa.type_"+pair_param["type_1"]+"_and_type_"+pair_param["type_2"]+".g",lexical_cast<string>(param["g"]));
     m_msg->write_config("potential.pair.Yukawa.type_"+pair_param["type_1"]+"_and_type_"+pair_param["type_2"]+".kappa",lexical_cast<string>(param["kappa"]));
@@ -193,8 +284,29 @@ public:
     m_has_pair_params = true;
   }
   
-  //! Returns false since Yukawa potential does not need neighbour list
-  bool need_nlist() { return false; }
+  //! Set per type charges (used by the treecode method)
+  void set_type_parameters(pairs_type& pair_param)
+  {
+    if (pair_param.find("type") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type has not been defined for type specific parameters in Yukawa potential.");
+      throw runtime_error("Missing key for pair potential parameters.");
+    }
+    int type = lexical_cast<int>(pair_param["type"]);
+    if (pair_param.find("q") != pair_param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Yukawa pair potential. Setting charge to "+pair_param["q"]+" for particles of type "+lexical_cast<string>(type)+".");
+      m_charge[type-1] = lexical_cast<double>(pair_param["q"]);
+    }
+    else
+      m_msg->msg(Messenger::INFO,"Yukawa pair potential. Using default charge ("+lexical_cast<string>(m_charge[type-1])+") for particles of type "+lexical_cast<string>(type)+".");
+    m_msg->write_config("potential.pair.yukawa.type_"+pair_param["type"]+".q",lexical_cast<string>(m_charge[type-1]));
+    if (!m_treecode)
+      m_msg->msg(Messenger::WARNING,"Yukawa pair potential. Charges are only used with the treecode method. Use pair parameter g otherwise.");
+  }
+  
+  //! Returns true unless interactions are computed with the treecode
+  bool need_nlist() { return !m_treecode; }
   
   //! Computes potentials and forces for all particles
   void compute(double);
@@ -205,7 +317,23 @@ private:
   double m_g;           //!< potential strength
   double m_kappa;       //!< inverse potential range
   double m_rcut;        //!< cutoff distance
+  double m_tolerance;   //!< if positive, cutoff is chosen such that pair potential at cutoff equals this value
   YukawaParameters** m_pair_params;   //!< type specific pair parameters 
+  bool m_treecode;                  //!< If true, use treecode method
+  OctreePtr m_octree;               //!< Octree for the treecode method
+  vector<double> m_charge;          //!< Charge of each particle type (treecode)
+  vector<double> m_q;               //!< Charge of each particle (treecode)
+  vector<double> m_phi;             //!< Potential at each particle (treecode)
+  vector<double> m_ex, m_ey, m_ez;  //!< Field at each particle (treecode)
+  
+  //! Computes interactions using treecode
+  void compute_tree();
+  
+  //! Computes cutoff distance at which the pair potential drops to the tolerance
+  double tolerance_cutoff(double, double);
+  
+  //! Reports the error due to truncating the potential at the cutoff
+  void report_truncation_error(double, double, double, const string&);
     
 };
 
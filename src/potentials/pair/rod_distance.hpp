@@ -0,0 +1,122 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file rod_distance.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Closest approach between two rods (shared by all rod potentials)
+ */ 
+
+#ifndef __ROD_DISTANCE_HPP__
+#define __ROD_DISTANCE_HPP__
+
+#include <cmath>
+
+using std::fabs;
+using std::copysign;
+
+//! Clamp x to the interval [-l,l] 
+inline double rod_clamp(double x, double l)
+{
+  return (x > l) ? l : ((x < -l) ? -l : x);
+}
+
+//! Bounding sphere test for a pair of rods
+//! Rod centres are separated by (dx,dy,dz). Since every point of a rod lies within half of 
+//! its length from its centre, two rods cannot come closer than rc if the distance between 
+//! their centres is larger than li2 + lj2 + rc.
+//! \param dx x component of the distance between rod centres
+//! \param dy y component of the distance between rod centres
+//! \param dz z component of the distance between rod centres
+//! \param li2 half length of the first rod
+//! \param lj2 half length of the second rod
+//! \param rc interaction range 
+//! \return true if the rods can be within distance rc
+inline bool rod_spheres_overlap(double dx, double dy, double dz, double li2, double lj2, double rc)
+{
+  double reach = li2 + lj2 + rc;
+  return (dx*dx + dy*dy + dz*dz <= reach*reach);
+}
+
+//! Closest approach between two rods 
+//! Rod i is given by \f$ \vec r_i + \lambda \vec n_i \f$ with \f$ |\lambda| \le l_i/2 \f$ and similarly for rod j. 
+//! Algorithm follows "A fast algorithm to evaluate the shortest distance between rods",
+//! C. Vega, S. Lago, Computers & Chemistry, Volume 18, 55–59 (1994). All cases are evaluated and 
+//! the result is selected at the end, which avoids hard to predict branches in the inner loop.
+//! \param dx_cm x component of the distance between rod centres (r_j - r_i)
+//! \param dy_cm y component of the distance between rod centres (r_j - r_i)
+//! \param dz_cm z component of the distance between rod centres (r_j - r_i)
+//! \param ni_x x component of the direction of rod i
+//! \param ni_y y component of the direction of rod i
+//! \param ni_z z component of the direction of rod i
+//! \param nj_x x component of the direction of rod j
+//! \param nj_y y component of the direction of rod j
+//! \param nj_z z component of the direction of rod j
+//! \param li2 half length of rod i
+//! \param lj2 half length of rod j
+//! \param lambda position of the closest point along rod i (returned)
+//! \param mu position of the closest point along rod j (returned)
+//! \param dx x component of the shortest distance vector (returned)
+//! \param dy y component of the shortest distance vector (returned)
+//! \param dz z component of the shortest distance vector (returned)
+inline void rod_closest_approach(double dx_cm, double dy_cm, double dz_cm,
+                                 double ni_x, double ni_y, double ni_z,
+                                 double nj_x, double nj_y, double nj_z,
+                                 double li2, double lj2,
+                                 double& lambda, double& mu,
+                                 double& dx, double& dy, double& dz)
+{
+  double ni_dot_nj = ni_x*nj_x + ni_y*nj_y + ni_z*nj_z; 
+  double drcm_dot_ni = dx_cm*ni_x + dy_cm*ni_y + dz_cm*ni_z;
+  double drcm_dot_nj = dx_cm*nj_x + dy_cm*nj_y + dz_cm*nj_z;
+  double cc = 1.0 - ni_dot_nj*ni_dot_nj;
+  bool parallel = (cc <= 1e-10);   // rods are nearly parallel
+  
+  // Unconstrained minimum of the distance between two infinite lines 
+  double denom = parallel ? 1.0 : cc;
+  double lambda_0 = (drcm_dot_ni - ni_dot_nj*drcm_dot_nj)/denom;
+  double mu_0 = (-drcm_dot_nj + ni_dot_nj*drcm_dot_ni)/denom;
+  // Closest point if the end of rod i is the nearest 
+  double lambda_i = copysign(li2,lambda_0);
+  double mu_i = rod_clamp(lambda_i*ni_dot_nj - drcm_dot_nj,lj2);
+  // Closest point if the end of rod j is the nearest
+  double mu_j = copysign(lj2,mu_0);
+  double lambda_j = rod_clamp(mu_j*ni_dot_nj + drcm_dot_ni,li2);
+  bool outside = (fabs(lambda_0) > li2) || (fabs(mu_0) > lj2);
+  bool end_i = (fabs(lambda_0) - li2 > fabs(mu_0) - lj2);
+  double lambda_np = outside ? (end_i ? lambda_i : lambda_j) : lambda_0;
+  double mu_np = outside ? (end_i ? mu_i : mu_j) : mu_0;
+  // Parallel rods: use the end of rod i in the direction of rod j
+  bool offset = (fabs(drcm_dot_ni) > 1e-10);
+  double lambda_p = offset ? copysign(li2,drcm_dot_ni) : 0.0;
+  double mu_p = offset ? rod_clamp(lambda_p*ni_dot_nj - drcm_dot_nj,lj2) : 0.0;
+  
+  lambda = parallel ? lambda_p : lambda_np;
+  mu = parallel ? mu_p : mu_np;
+  
+  dx = dx_cm + mu*nj_x - lambda*ni_x;
+  dy = dy_cm + mu*nj_y - lambda*ni_y;
+  dz = dz_cm + mu*nj_z - lambda*ni_z;
+}
+
+#endif
@@ -32,8 +32,9 @@
 /*! Iterate over all pair and external potential and compute 
  *  potential energies and forces
  *  \param dt step size (used to phase in particles)
+ *  \param skip_fused if true, skip pair potentials that have already been evaluated in the fused traversal
  */
-void Potential::compute(double dt)
+void Potential::compute(double dt, bool skip_fused)
 {
   //m_system->reset_forces();
   PairPotType::iterator it_pair;
@@ -42,13 +43,51 @@ void Potential::compute(double dt)
   AnglePotType::iterator it_angle;
   
   for(it_pair = m_pair_interactions.begin(); it_pair != m_pair_interactions.end(); it_pair++)
-    (*it_pair).second->compute(dt);
+  {
+    int interval = m_pair_interval[(*it_pair).first];
+    if (skip_fused && this->is_fused((*it_pair).first))
+      continue;
+    if (interval == 1)
+      (*it_pair).second->compute(dt);
+    else if (this->begin_slow_update(interval))
+    {
+      (*it_pair).second->compute(dt);
+      this->end_slow_update(interval);
+    }
+  }
   for(it_ext = m_external_potentials.begin(); it_ext != m_external_potentials.end(); it_ext++)
-    (*it_ext).second->compute();
+  {
+    int interval = m_external_interval[(*it_ext).first];
+    if (interval == 1)
+      (*it_ext).second->compute();
+    else if (this->begin_slow_update(interval))
+    {
+      (*it_ext).second->compute();
+      this->end_slow_update(interval);
+    }
+  }
   for(it_bond = m_bond.begin(); it_bond != m_bond.end(); it_bond++)
-    (*it_bond).second->compute();
+  {
+    int interval = m_bond_interval[(*it_bond).first];
+    if (interval == 1)
+      (*it_bond).second->compute();
+    else if (this->begin_slow_update(interval))
+    {
+      (*it_bond).second->compute();
+      this->end_slow_update(interval);
+    }
+  }
   for(it_angle = m_angle.begin(); it_angle != m_angle.end(); it_angle++)
-    (*it_angle).second->compute();
+  {
+    int interval = m_angle_interval[(*it_angle).first];
+    if (interval == 1)
+      (*it_angle).second->compute();
+    else if (this->begin_slow_update(interval))
+    {
+      (*it_angle).second->compute();
+      this->end_slow_update(interval);
+    }
+  }
 }
 
 /*! Iterate over all pair, external, bond and angle force computes  
@@ -73,3 +112,41 @@ double Potential::compute_potential_energy()
 
   return pot_eng;
 }
+
+/*! A potential with update interval \f$ n \f$ is evaluated on every \f$ n \f$-th time step. It is also evaluated 
+ *  on steps when energies or stress are needed, but then its forces are discarded (its stress, being an 
+ *  instantaneous quantity, is kept unscaled). If the potential is to be evaluated,
+ *  current forces are stored so that its contribution can be isolated afterwards.
+ *  \param interval update interval
+ *  \return true if the potential needs to be evaluated in this step
+ */
+bool Potential::begin_slow_update(int interval)
+{
+  if (m_system->get_step() % interval != 0 && !(m_system->compute_energy() || m_system->compute_stress()))
+    return false;
+  int N = m_system->size();
+  m_fx.resize(N);  m_fy.resize(N);  m_fz.resize(N);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    m_fx[i] = p.fx;  m_fy[i] = p.fy;  m_fz[i] = p.fz;
+  }
+  return true;
+}
+
+/*! Force contributed by the potential since begin_slow_update is multiplied by the update interval (impulse 
+ *  multiple time stepping). On steps that are not multiples of the update interval the contribution is removed.
+ *  \param interval update interval
+ */
+void Potential::end_slow_update(int interval)
+{
+  int N = m_system->size();
+  double scale = (m_system->get_step() % interval == 0) ? static_cast<double>(interval) : 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    p.fx = m_fx[i] + scale*(p.fx - m_fx[i]);
+    p.fy = m_fy[i] + scale*(p.fy - m_fy[i]);
+    p.fz = m_fz[i] + scale*(p.fz - m_fz[i]);
+  }
+}
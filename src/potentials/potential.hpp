@@ -49,12 +49,18 @@ typedef map<string,PairPotentialPtr> PairPotType;
 typedef map<string,ExternalPotentialPtr> ExternPotType;
 typedef map<string,BondPotentialPtr> BondPotType;
 typedef map<string,AnglePotentialPtr> AnglePotType;
+typedef map<string,int> UpdateIntervalType;
 
 /*! Potential class handles all potentials (pair interactions, external forces, bonds and angles) present 
  *  in the system. All potentials are stored in two STL maps which both have strings as keys
  *  while items are pointers (boost shared_ptr) to the PairPotential and ExternalPotential abstract classes,
  *  respectively. The integrator part of the code calls member functions of this class
  *  to perform actual force and potential computations.
+ *
+ *  Each potential can be assigned an update interval \f$ n \f$ (multiple time stepping, RESPA). Such potential is 
+ *  evaluated only every \f$ n \f$ steps and its force is then applied as an impulse, i.e. multiplied by \f$ n \f$.
+ *  On other steps it does not contribute to the force. Potentials with \f$ n > 1 \f$ are still evaluated (without
+ *  contributing to forces) on steps when energies are needed, so logged energies are always current.
 */
 class Potential
 {
@@ -77,9 +83,13 @@ public:
   //! Add pair potential to the list of all pair interactions
   //! \param name Unique name of the potential 
   //! \param pot Pointer to the pair potential object
-  void add_pair_potential(const string& name, PairPotentialPtr pot)
+  //! \param interval Update interval (in time steps) for multiple time stepping
+  void add_pair_potential(const string& name, PairPotentialPtr pot, int interval = 1)
   {
     m_pair_interactions[name] = pot;
+    m_pair_interval[name] = interval;
+    if (interval > 1)
+      m_msg->msg(Messenger::INFO,"Pair potential " + name + " will be updated every " + lexical_cast<string>(interval) + " time steps (multiple time stepping).");
     m_need_nlist = m_need_nlist | pot->need_nlist();
     m_msg->msg(Messenger::INFO,"Added pair potential : " + name + " to the list of pair interactions.");
     if (pot->need_nlist())
@@ -89,27 +99,39 @@ public:
   //! Add external potential to the list of all external potentials
   //! \param name Unique name of the potential 
   //! \param pot Pointer to the external potential object
-  void add_external_potential(const string& name, ExternalPotentialPtr pot)
+  //! \param interval Update interval (in time steps) for multiple time stepping
+  void add_external_potential(const string& name, ExternalPotentialPtr pot, int interval = 1)
   {
     m_external_potentials[name] = pot;
+    m_external_interval[name] = interval;
+    if (interval > 1)
+      m_msg->msg(Messenger::INFO,"External potential " + name + " will be updated every " + lexical_cast<string>(interval) + " time steps (multiple time stepping).");
     m_msg->msg(Messenger::INFO,"Added external potential : " + name + " to the list of external forces.");
   }
   
   //! Add bond potential to the list of all bond interactions
   //! \param name Unique name of the potential 
   //! \param pot Pointer to the bond potential object
-  void add_bond_potential(const string& name, BondPotentialPtr pot)
+  //! \param interval Update interval (in time steps) for multiple time stepping
+  void add_bond_potential(const string& name, BondPotentialPtr pot, int interval = 1)
   {
     m_bond[name] = pot;
+    m_bond_interval[name] = interval;
+    if (interval > 1)
+      m_msg->msg(Messenger::INFO,"Bond potential " + name + " will be updated every " + lexical_cast<string>(interval) + " time steps (multiple time stepping).");
     m_msg->msg(Messenger::INFO,"Added bond potential : " + name + " to the list of bond interactions.");
   }
   
   //! Add angle potential to the list of all angle interactions
   //! \param name Unique name of the potential 
   //! \param pot Pointer to the angle potential object
-  void add_angle_potential(const string& name, AnglePotentialPtr pot)
+  //! \param interval Update interval (in time steps) for multiple time stepping
+  void add_angle_potential(const string& name, AnglePotentialPtr pot, int interval = 1)
   {
     m_angle[name] = pot;
+    m_angle_interval[name] = interval;
+    if (interval > 1)
+      m_msg->msg(Messenger::INFO,"Angle potential " + name + " will be updated every " + lexical_cast<string>(interval) + " time steps (multiple time stepping).");
     m_msg->msg(Messenger::INFO,"Added angle potential : " + name + " to the list of angle interactions.");
   }
   
@@ -208,7 +230,28 @@ public:
   double compute_potential_energy();
 
   //! Compute all forces and potentials in the system
-  void compute(double);
+  void compute(double, bool skip_fused = false);
+  
+  //! Collect pair potentials that can be evaluated in a shared (fused) neighbour list traversal
+  //! \param pots list to which fusable pair potentials are appended
+  void get_fusable_pair_potentials(vector<PairPotentialPtr>& pots)
+  {
+    for(PairPotType::iterator it_pair = m_pair_interactions.begin(); it_pair != m_pair_interactions.end(); it_pair++)
+      if (this->is_fused((*it_pair).first))
+        pots.push_back((*it_pair).second);
+  }
+  
+  //! Add Hessians of all pair potentials that provide them (used by implicit integrators)
+  //! \param H matrix to which Hessians are added
+  //! \return true if at least one potential provided its Hessian
+  bool add_hessian(BlockSparseMatrix& H)
+  {
+    bool has_hessian = false;
+    for(PairPotType::iterator it_pair = m_pair_interactions.begin(); it_pair != m_pair_interactions.end(); it_pair++)
+      if ((*it_pair).second->add_hessian(H))
+        has_hessian = true;
+    return has_hessian;
+  }
   
 private:
   
@@ -221,6 +264,22 @@ private:
   AnglePotType m_angle;                 //!< Contains information about all angles
   
   bool m_need_nlist;                  //!< If true, there are potentials that need neighbour list
+  
+  UpdateIntervalType m_pair_interval;       //!< Update interval for each pair potential
+  UpdateIntervalType m_external_interval;   //!< Update interval for each external potential
+  UpdateIntervalType m_bond_interval;       //!< Update interval for each bond potential
+  UpdateIntervalType m_angle_interval;      //!< Update interval for each angle potential
+  vector<double> m_fx, m_fy, m_fz;          //!< Forces before evaluating a potential with update interval > 1
+  
+  //! Returns true if pair potential is evaluated in the fused traversal (only those updated every step)
+  //! \param name pair potential name
+  bool is_fused(const string& name) { return m_pair_interval[name] == 1 && m_pair_interactions[name]->fusable(); }
+  
+  //! Check if a potential with a given update interval needs to be evaluated and if so, store current forces
+  bool begin_slow_update(int);
+  
+  //! Apply force of a potential with a given update interval as an impulse
+  void end_slow_update(int);
    
 };
 
@@ -46,6 +46,28 @@
 using std::map;
 using std::string;
 
+/*! Extracts update interval (for multiple time stepping) from parameters of a potential or aligner. 
+ *  The key is removed since individual potentials and aligners do not handle it.
+ *  \param param parameters of the potential or aligner
+ *  \param msg Pointer to the messenger object
+ *  \return update interval (1 if not set)
+ */
+static int extract_update_interval(pairs_type& param, MessengerPtr msg)
+{
+  int interval = 1;
+  if (param.find("update_interval") != param.end())
+  {
+    interval = lexical_cast<int>(param["update_interval"]);
+    param.erase("update_interval");
+    if (interval < 1)
+    {
+      msg->msg(Messenger::ERROR,"Update interval has to be a positive integer.");
+      throw std::runtime_error("Invalid update interval.");
+    }
+  }
+  return interval;
+}
+
 
 int main(int argc, char* argv[])
 {
@@ -352,13 +374,14 @@ int main(int argc, char* argv[])
                 std::string phase_in = "constant";
                 if (parameter_data.find("phase_in") != parameter_data.end())
                     phase_in = parameter_data["phase_in"];                
+                int update_interval = extract_update_interval(parameter_data, msg);
                 pot->add_pair_potential(potential_data.type, pair_potentials[potential_data.type](
                                                                                                   sys,
                                                                                                   msg,
                                                                                                   nlist,
                                                                                                   boost::shared_ptr<Value>(values[phase_in](msg,parameter_data)),
                                                                                                   parameter_data
-                                                                                                 ));
+                                                                                                 ), update_interval);
                 msg->msg(Messenger::INFO,"Added "+potential_data.type+" to the list of pair potentials.");
               }
               else
@@ -393,7 +416,8 @@ int main(int argc, char* argv[])
               }
               if (qi::phrase_parse(external_data.params.begin(), external_data.params.end(), param_parser, qi::space, parameter_data))
               {
-                pot->add_external_potential(external_data.type, external_potentials[external_data.type](sys,msg,parameter_data));
+                int update_interval = extract_update_interval(parameter_data, msg);
+                pot->add_external_potential(external_data.type, external_potentials[external_data.type](sys,msg,parameter_data), update_interval);
                 msg->msg(Messenger::INFO,"Added "+external_data.type+" to the list of external potentials.");
               }
               else
@@ -435,7 +459,8 @@ int main(int argc, char* argv[])
               }
               if (qi::phrase_parse(bond_data.params.begin(), bond_data.params.end(), param_parser, qi::space, parameter_data))
               {
-                pot->add_bond_potential(bond_data.type, bond_potentials[bond_data.type](sys,msg,parameter_data));
+                int update_interval = extract_update_interval(parameter_data, msg);
+                pot->add_bond_potential(bond_data.type, bond_potentials[bond_data.type](sys,msg,parameter_data), update_interval);
                 msg->msg(Messenger::INFO,"Added "+bond_data.type+" to the list of bond potentials.");
               }
               else
@@ -478,7 +503,8 @@ int main(int argc, char* argv[])
               }
               if (qi::phrase_parse(angle_data.params.begin(), angle_data.params.end(), param_parser, qi::space, parameter_data))
               {
-                pot->add_angle_potential(angle_data.type, angle_potentials[angle_data.type](sys,msg,parameter_data));
+                int update_interval = extract_update_interval(parameter_data, msg);
+                pot->add_angle_potential(angle_data.type, angle_potentials[angle_data.type](sys,msg,parameter_data), update_interval);
                 msg->msg(Messenger::INFO,"Added "+angle_data.type+" to the list of angle potentials.");
               }
               else
@@ -863,7 +889,10 @@ int main(int argc, char* argv[])
                 std::string integrator_name = (*it_integ).first;
                 msg->add_config("run."+integrator_name+".steps",lexical_cast<string>(run_data.steps));
               }
-              // Precompute forces and torques
+              // Precompute forces and torques (with energies, since step 0 may be logged)
+              sys->set_step(time_step);
+              sys->set_compute_energy(true);
+              sys->set_compute_stress(sys->stress_requested(time_step));
               if (pot)
                 pot->compute(1e-3);  // Some value to make sure phase in is working.
               if (aligner)
@@ -873,15 +902,24 @@ int main(int argc, char* argv[])
               {
                 sys->set_step(time_step);
                 sys->set_run_step(t);
-                if (constraint->rescale())
+                double sx, sy, sz;
+                if (constraint->rescale(sx,sy,sz))
                 {
-                  nlist->build();
-                  nlist_builds++;
+                  // Follow the rescaled surface and rebuild the neighbour list only if particles moved too far from it
+                  nlist->rescale(sx,sy,sz);
+                  if (nlist->need_update())
+                  {
+                    nlist->build();
+                    nlist_builds++;
+                  }
                 }
                 for (vector<DumpPtr>::iterator it_d = dump.begin(); it_d != dump.end(); it_d++)
                   (*it_d)->dump(time_step);
 				        for (vector<LoggerPtr>::iterator it_l = log.begin(); it_l != log.end(); it_l++)
                   (*it_l)->log();
+                // Energies and stress computed during this step's force evaluation are consumed by logs and dumps on the next step
+                sys->set_compute_energy(sys->energy_requested(time_step+1));
+                sys->set_compute_stress(sys->stress_requested(time_step+1));
                 for (std::map<std::string, IntegratorPtr>::iterator it_integ = integrator.begin(); it_integ != integrator.end(); it_integ++)
                   (*it_integ).second->integrate();
                 if (has_population)
@@ -936,14 +974,7 @@ int main(int argc, char* argv[])
                     sys->set_force_nlist_rebuild(false);
                   }
                   else
-                  {
-                    for (int i = 0; i < sys->size(); i++)
-                      if (nlist->need_update(sys->get_particle(i)))
-                      {
-                        nlist_rebuild = true;
-                        break;
-                      }
-                  }
+                    nlist_rebuild = nlist->need_update();
                   if (nlist_rebuild)
                   {
                     nlist->build();
@@ -955,6 +986,8 @@ int main(int argc, char* argv[])
                 time_step++;
               }
               msg->msg(Messenger::INFO,"Built neighbour list "+lexical_cast<string>(nlist_builds)+" time. Average number of steps between two builds : "+lexical_cast<string>(static_cast<double>(run_data.steps)/nlist_builds)+".");
+              for (std::map<std::string, IntegratorPtr>::iterator it_integ = integrator.begin(); it_integ != integrator.end(); it_integ++)
+                (*it_integ).second->report();
             }
             else
             {
@@ -987,7 +1020,8 @@ int main(int argc, char* argv[])
                   nlist = boost::make_shared<NeighbourList>(NeighbourList(sys,msg,DEFAULT_CUTOFF,DEFAULT_PADDING, parameter_data));
                   defined["nlist"] = true;
                 }
-                aligner->add_pair_align(pair_align_data.type, pair_aligners[pair_align_data.type](sys,msg,nlist,parameter_data));
+                int update_interval = extract_update_interval(parameter_data, msg);
+                aligner->add_pair_align(pair_align_data.type, pair_aligners[pair_align_data.type](sys,msg,nlist,parameter_data), update_interval);
                 msg->msg(Messenger::INFO,"Added "+pair_align_data.type+" to the list of pairwise aligners.");
               }
               else
@@ -1049,7 +1083,8 @@ int main(int argc, char* argv[])
               }
               if (qi::phrase_parse(external_align_data.params.begin(), external_align_data.params.end(), param_parser, qi::space, parameter_data))
               {
-                aligner->add_external_align(external_align_data.type, external_aligners[external_align_data.type](sys,msg,parameter_data));
+                int update_interval = extract_update_interval(parameter_data, msg);
+                aligner->add_external_align(external_align_data.type, external_aligners[external_align_data.type](sys,msg,parameter_data), update_interval);
                 msg->msg(Messenger::INFO,"Added "+external_align_data.type+" to the list of external aligners.");
               }
               else
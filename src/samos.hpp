@@ -70,6 +70,7 @@
 #include "constraint_none.hpp"
 #include "constraint_tetrahedron.hpp"
 #include "constraint_slab.hpp"
+#include "constraint_mesh.hpp"
 #include "rng.hpp"
 #include "particle.hpp"
 #include "vector3d.hpp"
@@ -107,9 +108,12 @@
 #include "integrator_nematic.hpp"
 #include "integrator_actomyo.hpp"
 #include "integrator_brownian_pos.hpp"
+#include "integrator_brownian_implicit.hpp"
 #include "integrator_brownian_align.hpp"
 #include "integrator_langevin.hpp"
 #include "integrator_fire.hpp"
+#include "integrator_lbfgs.hpp"
+#include "integrator_cg.hpp"
 #include "integrator_sepulveda.hpp"
 #include "aligner.hpp"
 #include "pair_aligner.hpp"
@@ -0,0 +1,124 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file block_sparse_matrix.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of BlockSparseMatrix class.
+ */ 
+
+#include "block_sparse_matrix.hpp"
+
+/*! Row i of the matrix gets blocks for i, its neighbours and 
+ *  neighbours of its neighbours. Columns in each row are sorted.
+ *  \param mesh mesh that defines connectivity
+ */
+void BlockSparseMatrix::build_pattern(Mesh& mesh)
+{
+  vector<Vertex>& vertices = mesh.get_vertices();
+  m_size = vertices.size();
+  m_row_start.resize(m_size+1);
+  m_cols.clear();
+  vector<int> row;
+  m_row_start[0] = 0;
+  for (int i = 0; i < m_size; i++)
+  {
+    Vertex& vi = vertices[i];
+    row.clear();
+    row.push_back(i);
+    for (int j = 0; j < vi.n_edges; j++)
+    {
+      Vertex& vj = vertices[vi.neigh[j]];
+      row.push_back(vj.id);
+      for (int k = 0; k < vj.n_edges; k++)
+        row.push_back(vj.neigh[k]);
+    }
+    std::sort(row.begin(), row.end());
+    row.erase(std::unique(row.begin(), row.end()), row.end());
+    m_cols.insert(m_cols.end(), row.begin(), row.end());
+    m_row_start[i+1] = m_cols.size();
+  }
+  m_blocks.assign(9*m_cols.size(), 0.0);
+}
+
+/*! \param i block row (vertex index)
+ *  \param j block column (vertex index)
+ *  \param c prefactor
+ *  \param a left vector
+ *  \param b right vector
+ */
+void BlockSparseMatrix::add_outer(int i, int j, double c, const Vector3d& a, const Vector3d& b)
+{
+  double* B = &m_blocks[9*this->find_block(i,j)];
+  B[0] += c*a.x*b.x;  B[1] += c*a.x*b.y;  B[2] += c*a.x*b.z;
+  B[3] += c*a.y*b.x;  B[4] += c*a.y*b.y;  B[5] += c*a.y*b.z;
+  B[6] += c*a.z*b.x;  B[7] += c*a.z*b.y;  B[8] += c*a.z*b.z;
+}
+
+/*! Rows are independent, so they are processed in parallel.
+ *  \param x input vector (3N elements, x, y and z components of each vertex)
+ *  \param y result (3N elements)
+ */
+void BlockSparseMatrix::multiply(const vector<double>& x, vector<double>& y)
+{
+  y.resize(3*m_size);
+#pragma omp parallel for
+  for (int i = 0; i < m_size; i++)
+  {
+    double yx = 0.0, yy = 0.0, yz = 0.0;
+    for (int b = m_row_start[i]; b < m_row_start[i+1]; b++)
+    {
+      const double* B = &m_blocks[9*b];
+      const double* xj = &x[3*m_cols[b]];
+      yx += B[0]*xj[0] + B[1]*xj[1] + B[2]*xj[2];
+      yy += B[3]*xj[0] + B[4]*xj[1] + B[5]*xj[2];
+      yz += B[6]*xj[0] + B[7]*xj[1] + B[8]*xj[2];
+    }
+    y[3*i] = yx;  y[3*i+1] = yy;  y[3*i+2] = yz;
+  }
+}
+
+//! \param d diagonal elements (3N elements)
+void BlockSparseMatrix::diagonal(vector<double>& d)
+{
+  d.resize(3*m_size);
+  for (int i = 0; i < m_size; i++)
+  {
+    const double* B = &m_blocks[9*this->find_block(i,i)];
+    d[3*i] = B[0];  d[3*i+1] = B[4];  d[3*i+2] = B[8];
+  }
+}
+
+/*! \param i block row
+ *  \param j block column
+ *  \return index of the block
+ */
+int BlockSparseMatrix::find_block(int i, int j)
+{
+  vector<int>::iterator first = m_cols.begin() + m_row_start[i];
+  vector<int>::iterator last = m_cols.begin() + m_row_start[i+1];
+  vector<int>::iterator it = std::lower_bound(first, last, j);
+  if (it == last || *it != j)
+    throw runtime_error("Block ("+lexical_cast<string>(i)+","+lexical_cast<string>(j)+") is not in the sparsity pattern.");
+  return it - m_cols.begin();
+}
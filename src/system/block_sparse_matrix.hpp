@@ -0,0 +1,94 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file block_sparse_matrix.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of BlockSparseMatrix class.
+ */ 
+
+#ifndef __BLOCK_SPARSE_MATRIX_HPP__
+#define __BLOCK_SPARSE_MATRIX_HPP__
+
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+
+#include <boost/lexical_cast.hpp>
+
+#include "mesh.hpp"
+#include "vector3d.hpp"
+
+using std::vector;
+using std::string;
+using std::runtime_error;
+using boost::lexical_cast;
+
+/*! BlockSparseMatrix stores a symmetric 3N x 3N matrix built of 3x3 blocks 
+ *  in the compressed row format. The sparsity pattern is taken from the mesh 
+ *  connectivity: row i contains blocks for vertex i and all vertices that are 
+ *  at most two edges away from it. This covers all couplings in the vertex model,
+ *  where the energy of each cell depends on positions of the cell vertex and its 
+ *  immediate neighbours. 
+ *  It is used to hold (approximate) Hessians of the potential energy for 
+ *  implicit integrators.
+*/
+class BlockSparseMatrix
+{
+public:
+  
+  //! Construct empty matrix
+  BlockSparseMatrix() : m_size(0) { }
+  
+  //! Build sparsity pattern from the mesh connectivity and set all blocks to zero
+  void build_pattern(Mesh&);
+  
+  //! Set all blocks to zero (pattern is kept)
+  void zero() { std::fill(m_blocks.begin(), m_blocks.end(), 0.0); }
+  
+  //! Returns number of block rows 
+  int size() { return m_size; }
+  
+  //! Add \f$ c \vec a \otimes \vec b \f$ to the block (i,j)
+  void add_outer(int, int, double, const Vector3d&, const Vector3d&);
+  
+  //! Compute y = A x for vectors of length 3N
+  void multiply(const vector<double>&, vector<double>&);
+  
+  //! Extract diagonal (3N elements)
+  void diagonal(vector<double>&);
+  
+private:
+  
+  int m_size;                    //!< Number of block rows
+  vector<int> m_row_start;       //!< Index of the first block in each row (size N+1)
+  vector<int> m_cols;            //!< Column (vertex) index of each block; sorted within each row
+  vector<double> m_blocks;       //!< Block elements, 9 per block stored row-wise
+  
+  //! Find position of the block (i,j)
+  int find_block(int, int);
+  
+};
+
+#endif
@@ -34,7 +34,7 @@
 //! \param sys Pointer to the system object
 //! \param msg Pointer to the messenger object
 //! \param cutoff cell size (currently all cells are cubic)
-CellList::CellList(SystemPtr sys, MessengerPtr msg, double cutoff) : m_system(sys), m_msg(msg)
+CellList::CellList(SystemPtr sys, MessengerPtr msg, double cutoff) : m_system(sys), m_msg(msg), m_cutoff(cutoff)
 {
   m_nx = static_cast<int>(sys->get_box()->Lx/cutoff);
   m_ny = static_cast<int>(sys->get_box()->Ly/cutoff);
@@ -102,3 +102,15 @@ void CellList::populate()
   }
   //m_msg->msg(Messenger::INFO,"Populated cell list.");
 }
+
+//! Adjust cell widths to the current box size (e.g., after the box has been rescaled)
+//! keeping the number of cells and their connectivity
+//! \return false if cells became narrower than the cutoff (cell list has to be rebuilt)
+bool CellList::fit_box()
+{
+  BoxPtr box = m_system->get_box();
+  m_wx = box->Lx/m_nx;
+  m_wy = box->Ly/m_ny;
+  m_wz = box->Lz/m_nz;
+  return (m_wx >= m_cutoff && m_wy >= m_cutoff && m_wz >= m_cutoff);
+}
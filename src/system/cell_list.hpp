@@ -69,6 +69,9 @@ public:
   //! Populates cell list
   void populate();
   
+  //! Adjust cell widths to the current box size (keeping the number of cells)
+  bool fit_box();
+  
 private:
   
   SystemPtr m_system;              //!< Pointer to the System object
@@ -77,6 +80,7 @@ private:
   int m_size;                      //!< Cell list size (number of cells)
   double m_nx, m_ny, m_nz;         //!< Number of cell is x, y, z direction
   double m_wx, m_wy, m_wz;         //!< Cell width in the x, y, and z direction
+  double m_cutoff;                 //!< Smallest allowed cell width
   
 };
 
@@ -117,6 +117,8 @@ void mark_domains(Delaunay& cdt)
 void NeighbourList::build()
 {
  m_list.clear();
+ m_scale = 1.0;
+ m_skin_sq = 0.25*m_pad*m_pad;
  
  if (m_remove_detached)
    this->remove_detached();
@@ -295,12 +297,49 @@ bool NeighbourList::need_update(Particle& p)
     else if (dz < box->zlo) dz += box->Lz;
   }
   
-  if (dx*dx + dy*dy + dz*dz < 0.25*m_pad*m_pad)
+  if (dx*dx + dy*dy + dz*dz < m_skin_sq)
     return false;
   else
     return true;
 }
 
+/*! Map stored particle positions affinely after the constraint has been rescaled. 
+ *  This way particles that simply followed the surface are not counted as moved and
+ *  the list does not have to be rebuilt after each rescaling. 
+ *  Since distances between particles have been scaled by at least \f$ s = \min\left(s_x,s_y,s_z\right) \f$, 
+ *  a pair that was further apart than \f$ r_c + \delta \f$ at the last build can be closer than the 
+ *  cutoff \f$ r_c \f$ only if one of the particles moved by more than \f$ \frac{1}{2}\left(s\left(r_c+\delta\right) - r_c\right) \f$ 
+ *  from its stored position (\f$ \delta \f$ is the padding distance). For compression this is smaller 
+ *  than the usual \f$ \delta/2 \f$, so the list is rebuilt as soon as the padding has been used up.
+ *  If the box has been rescaled as well, cell widths are adjusted to the new box size.
+ *  \param sx scale factor along x
+ *  \param sy scale factor along y
+ *  \param sz scale factor along z
+ */
+void NeighbourList::rescale(double sx, double sy, double sz)
+{
+  for (unsigned int i = 0; i < m_old_state.size(); i++)
+  {
+    m_old_state[i].x *= sx;
+    m_old_state[i].y *= sy;
+    m_old_state[i].z *= sz;
+  }
+  m_scale *= std::min(sx, std::min(sy, sz));
+  double skin = 0.5*(m_scale*(m_cut + m_pad) - m_cut);
+  m_skin_sq = (skin > 0.0) ? skin*skin : -1.0;   // negative value forces rebuild
+  if (m_use_cell_list && !m_cell_list->fit_box())
+  {
+    BoxPtr box = m_system->get_box();
+    if (box->Lx > 2.0*(m_cut+m_pad) && box->Ly > 2.0*(m_cut+m_pad) && box->Lz > 2.0*(m_cut+m_pad))
+      m_cell_list = boost::shared_ptr<CellList>(new CellList(m_system,m_msg,m_cut+m_pad));
+    else
+    {
+      m_use_cell_list = false;
+      m_msg->msg(Messenger::INFO,"Box has been rescaled. No longer possible to use cell lists for neighbour list builds.");
+    }
+  }
+}
+
 
 /*! Build faces using contact network 
  *  Assumes that contacts have been built. 
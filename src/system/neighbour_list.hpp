@@ -125,6 +125,8 @@ public:
                                                                                                  m_msg(msg),
                                                                                                  m_cut(cutoff), 
                                                                                                  m_pad(pad), 
+                                                                                                 m_scale(1.0),
+                                                                                                 m_skin_sq(0.25*pad*pad),
                                                                                                  m_triangulation(false),
                                                                                                  m_max_perim(20.0),
                                                                                                  m_circumcenter(true),
@@ -228,6 +230,18 @@ public:
   //! Check is neighbour list of the given particle needs update
   bool need_update(Particle&);
   
+  //! Check if neighbour list needs update for any of the particles
+  bool need_update()
+  {
+    for (int i = 0; i < m_system->size(); i++)
+      if (this->need_update(m_system->get_particle(i)))
+        return true;
+    return false;
+  }
+  
+  //! Map stored particle positions affinely after the constraint has been rescaled
+  void rescale(double, double, double);
+  
   //! Returns true is faces list exists
   bool has_faces() { return m_triangulation; }
   
@@ -284,6 +298,8 @@ private:
   vector<PartPos> m_old_state;     //!< Coordinates of particles right after the build
   double m_cut;                    //!< List build cutoff distance 
   double m_pad;                    //!< Padding distance (m_cut should be set to potential cutoff + m_pad)
+  double m_scale;                  //!< Lower bound of the factor by which distances between particles have been scaled by rescaling constraints since the last build
+  double m_skin_sq;                //!< Square of the distance a particle can move away from its stored position before the list has to be rebuilt
   bool m_use_cell_list;            //!< If true, use cell list to speed up neighbour list builds
   bool m_triangulation;            //!< If true, build Delaunay triangulation for faces
   double m_max_perim;              //!< Maximum value of the perimeter beyond which face becomes a hole.
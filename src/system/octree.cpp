@@ -0,0 +1,245 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file octree.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of Octree class members.
+ */ 
+
+#include "octree.hpp"
+
+//! Construct octree
+//! \param sys Pointer to the system object
+//! \param msg Pointer to the messenger object
+//! \param theta opening angle
+//! \param leaf_size maximum number of particles in a leaf cell
+Octree::Octree(SystemPtr sys, MessengerPtr msg, double theta, int leaf_size) : m_system(sys), 
+                                                                              m_msg(msg), 
+                                                                              m_theta(theta), 
+                                                                              m_leaf_size(leaf_size)
+{
+  
+}
+
+//! Build the tree 
+//! \param charge charge of each particle
+void Octree::build(const vector<double>& charge)
+{
+  int N = m_system->size();
+  m_charge = charge;
+  m_nodes.clear();
+  m_idx.resize(N);
+  if (N == 0) return;
+  double xmin = 1e100, ymin = 1e100, zmin = 1e100;
+  double xmax = -1e100, ymax = -1e100, zmax = -1e100;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    m_idx[i] = i;
+    xmin = std::min(xmin, p.x);  xmax = std::max(xmax, p.x);
+    ymin = std::min(ymin, p.y);  ymax = std::max(ymax, p.y);
+    zmin = std::min(zmin, p.z);  zmax = std::max(zmax, p.z);
+  }
+  OctreeNode root;
+  root.cx = 0.5*(xmin + xmax);  root.cy = 0.5*(ymin + ymax);  root.cz = 0.5*(zmin + zmax);
+  root.size = 1.0001*std::max(xmax - xmin, std::max(ymax - ymin, zmax - zmin)) + 1e-10;
+  root.begin = 0;  root.end = N;
+  m_nodes.push_back(root);
+  this->split(0, 0);
+  // Children are always stored after their parents, so moments can be accumulated in reverse order
+  for (int n = m_nodes.size() - 1; n >= 0; n--)
+    this->compute_moments(n);
+}
+
+//! Recursively subdivide cell until it has at most leaf_size particles
+//! \param n cell index 
+//! \param depth current depth
+void Octree::split(int n, int depth)
+{
+  for (int c = 0; c < 8; c++) m_nodes[n].child[c] = -1;
+  m_nodes[n].leaf = true;
+  if (m_nodes[n].end - m_nodes[n].begin <= m_leaf_size || depth >= OCTREE_MAX_DEPTH)
+    return;
+  m_nodes[n].leaf = false;
+  double cx = m_nodes[n].cx, cy = m_nodes[n].cy, cz = m_nodes[n].cz;
+  double half = 0.5*m_nodes[n].size;
+  int begin = m_nodes[n].begin, end = m_nodes[n].end;
+  // Sort particles by octant (counting sort)
+  vector<int> octant(end - begin);
+  int count[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int i = begin; i < end; i++)
+  {
+    Particle& p = m_system->get_particle(m_idx[i]);
+    int o = ((p.x >= cx) ? 1 : 0) + ((p.y >= cy) ? 2 : 0) + ((p.z >= cz) ? 4 : 0);
+    octant[i - begin] = o;
+    count[o]++;
+  }
+  int start[8];
+  start[0] = begin;
+  for (int o = 1; o < 8; o++) start[o] = start[o-1] + count[o-1];
+  vector<int> sorted(end - begin);
+  int pos[8];
+  for (int o = 0; o < 8; o++) pos[o] = start[o];
+  for (int i = begin; i < end; i++)
+    sorted[pos[octant[i - begin]]++ - begin] = m_idx[i];
+  std::copy(sorted.begin(), sorted.end(), m_idx.begin() + begin);
+  for (int o = 0; o < 8; o++)
+  {
+    if (count[o] == 0) continue;
+    OctreeNode child;
+    child.size = half;
+    child.cx = cx + ((o & 1) ? 0.5 : -0.5)*half;
+    child.cy = cy + ((o & 2) ? 0.5 : -0.5)*half;
+    child.cz = cz + ((o & 4) ? 0.5 : -0.5)*half;
+    child.begin = start[o];
+    child.end = start[o] + count[o];
+    m_nodes.push_back(child);
+    int c = m_nodes.size() - 1;
+    m_nodes[n].child[o] = c;
+    this->split(c, depth + 1);
+  }
+}
+
+//! Compute moments of a cell either directly from its particles (leaf) or by 
+//! shifting moments of its children to the cell centre
+//! \param n cell index
+void Octree::compute_moments(int n)
+{
+  OctreeNode& node = m_nodes[n];
+  node.Q = 0.0;
+  node.px = node.py = node.pz = 0.0;
+  node.Mxx = node.Myy = node.Mzz = node.Mxy = node.Mxz = node.Myz = 0.0;
+  if (node.leaf)
+  {
+    for (int i = node.begin; i < node.end; i++)
+    {
+      Particle& p = m_system->get_particle(m_idx[i]);
+      double q = m_charge[m_idx[i]];
+      double dx = p.x - node.cx, dy = p.y - node.cy, dz = p.z - node.cz;
+      node.Q += q;
+      node.px += q*dx;  node.py += q*dy;  node.pz += q*dz;
+      node.Mxx += q*dx*dx;  node.Myy += q*dy*dy;  node.Mzz += q*dz*dz;
+      node.Mxy += q*dx*dy;  node.Mxz += q*dx*dz;  node.Myz += q*dy*dz;
+    }
+  }
+  else
+  {
+    for (int o = 0; o < 8; o++)
+    {
+      if (node.child[o] < 0) continue;
+      OctreeNode& c = m_nodes[node.child[o]];
+      double dx = c.cx - node.cx, dy = c.cy - node.cy, dz = c.cz - node.cz;
+      node.Q += c.Q;
+      node.px += c.px + c.Q*dx;  node.py += c.py + c.Q*dy;  node.pz += c.pz + c.Q*dz;
+      node.Mxx += c.Mxx + 2.0*dx*c.px + c.Q*dx*dx;
+      node.Myy += c.Myy + 2.0*dy*c.py + c.Q*dy*dy;
+      node.Mzz += c.Mzz + 2.0*dz*c.pz + c.Q*dz*dz;
+      node.Mxy += c.Mxy + dx*c.py + dy*c.px + c.Q*dx*dy;
+      node.Mxz += c.Mxz + dx*c.pz + dz*c.px + c.Q*dx*dz;
+      node.Myz += c.Myz + dy*c.pz + dz*c.py + c.Q*dy*dz;
+    }
+  }
+}
+
+/*! Compute potential \f$ \phi_i = \sum_{j \neq i} q_j K(r_{ij}) \f$ and field \f$ \mathbf{E}_i = -\nabla_i \phi_i \f$ 
+ *  at the position of every particle. For radial kernels derivatives are expressed through 
+ *  \f$ g_1 = K'/r \f$, \f$ g_2 = g_1'/r \f$ and \f$ g_3 = g_2'/r \f$.
+ *  \param kappa inverse screening length (0 for Coulomb)
+ *  \param phi potential (output)
+ *  \param ex x component of the field (output)
+ *  \param ey y component of the field (output)
+ *  \param ez z component of the field (output)
+ */
+void Octree::compute_field(double kappa, vector<double>& phi, vector<double>& ex, vector<double>& ey, vector<double>& ez)
+{
+  int N = m_system->size();
+  phi.assign(N, 0.0);
+  ex.assign(N, 0.0);  ey.assign(N, 0.0);  ez.assign(N, 0.0);
+  if (m_nodes.empty()) return;
+  double theta_sq = m_theta*m_theta;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    double ph = 0.0, gx = 0.0, gy = 0.0, gz = 0.0;   // potential and its gradient
+    m_stack.clear();
+    m_stack.push_back(0);
+    while (!m_stack.empty())
+    {
+      int n = m_stack.back();
+      m_stack.pop_back();
+      OctreeNode& node = m_nodes[n];
+      double Rx = pi.x - node.cx, Ry = pi.y - node.cy, Rz = pi.z - node.cz;
+      double R_sq = Rx*Rx + Ry*Ry + Rz*Rz;
+      if (node.size*node.size < theta_sq*R_sq)
+      {
+        // Far cell, use multipole expansion
+        double R = sqrt(R_sq);
+        double e = exp(-kappa*R);
+        double kR = kappa*R;
+        double inv_R = 1.0/R, inv_R_sq = inv_R*inv_R;
+        double K = e*inv_R;
+        double g1 = -e*(1.0 + kR)*inv_R*inv_R_sq;
+        double g2 = e*(kR*kR + 3.0*kR + 3.0)*inv_R*inv_R_sq*inv_R_sq;
+        double g3 = -e*(kR*kR*kR + 6.0*kR*kR + 15.0*kR + 15.0)*inv_R*inv_R_sq*inv_R_sq*inv_R_sq;
+        double pR = node.px*Rx + node.py*Ry + node.pz*Rz;
+        double trM = node.Mxx + node.Myy + node.Mzz;
+        double MRx = node.Mxx*Rx + node.Mxy*Ry + node.Mxz*Rz;
+        double MRy = node.Mxy*Rx + node.Myy*Ry + node.Myz*Rz;
+        double MRz = node.Mxz*Rx + node.Myz*Ry + node.Mzz*Rz;
+        double RMR = Rx*MRx + Ry*MRy + Rz*MRz;
+        ph += node.Q*K - pR*g1 + 0.5*trM*g1 + 0.5*RMR*g2;
+        double radial = node.Q*g1 - pR*g2 + 0.5*trM*g2 + 0.5*RMR*g3;
+        gx += radial*Rx - node.px*g1 + MRx*g2;
+        gy += radial*Ry - node.py*g1 + MRy*g2;
+        gz += radial*Rz - node.pz*g1 + MRz*g2;
+      }
+      else if (node.leaf)
+      {
+        // Near leaf, sum directly 
+        for (int k = node.begin; k < node.end; k++)
+        {
+          int j = m_idx[k];
+          if (j == i) continue;
+          Particle& pj = m_system->get_particle(j);
+          double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
+          double r_sq = dx*dx + dy*dy + dz*dz;
+          double r = sqrt(r_sq);
+          double e = exp(-kappa*r);
+          double q = m_charge[j];
+          ph += q*e/r;
+          double g1 = -q*e*(1.0 + kappa*r)/(r*r_sq);
+          gx += g1*dx;  gy += g1*dy;  gz += g1*dz;
+        }
+      }
+      else
+      {
+        for (int o = 0; o < 8; o++)
+          if (node.child[o] >= 0)
+            m_stack.push_back(node.child[o]);
+      }
+    }
+    phi[i] = ph;
+    ex[i] = -gx;  ey[i] = -gy;  ez[i] = -gz;
+  }
+}
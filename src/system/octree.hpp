@@ -0,0 +1,105 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file octree.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of Octree class.
+ */ 
+
+#ifndef __OCTREE_HPP__
+#define __OCTREE_HPP__
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "messenger.hpp"
+#include "system.hpp"
+
+using std::vector;
+
+//! Default maximum number of particles in a leaf cell
+#define OCTREE_LEAF_SIZE 8
+//! Maximum depth of the tree (protects against coincident particles)
+#define OCTREE_MAX_DEPTH 30
+
+//! Single cell of the octree
+struct OctreeNode
+{
+  double cx, cy, cz;      //!< Geometric centre of the cell
+  double size;            //!< Edge length of the (cubic) cell
+  int begin, end;         //!< Range of the cell's particles in the sorted index array
+  int child[8];           //!< Children cells (-1 if not present)
+  bool leaf;              //!< True if the cell is not subdivided
+  double Q;               //!< Total charge (monopole)
+  double px, py, pz;      //!< Dipole moment with respect to the cell centre
+  double Mxx, Myy, Mzz, Mxy, Mxz, Myz;   //!< Second moment of charge (quadrupole) with respect to the cell centre
+};
+
+/*! Octree implements a Barnes-Hut hierarchical evaluation of the potential and the field 
+ *  produced by a set of charges interacting via the radial kernel \f$ K(r) = e^{-\kappa r}/r \f$ 
+ *  (\f$ \kappa = 0 \f$ is the Coulomb potential). Far cells, i.e. cells whose size as seen from the 
+ *  target particle is smaller than the opening angle \f$ \theta \f$, are approximated by their 
+ *  multipole expansion (up to quadrupole order) about the cell centre. Near cells are opened and leaf 
+ *  cells are summed over directly. Periodic boundaries are not taken into account, so the method is 
+ *  intended for closed surfaces and other non-periodic systems.
+*/
+class Octree
+{
+public:
+  
+  //! Construct octree
+  Octree(SystemPtr, MessengerPtr, double, int); 
+  
+  //! Build the tree for current particle positions and compute multipole moments
+  void build(const vector<double>&);
+  
+  //! Compute potential and field at the position of each particle
+  void compute_field(double, vector<double>&, vector<double>&, vector<double>&, vector<double>&);
+  
+  //! Return total number of cells
+  int get_size() { return m_nodes.size(); }
+  
+private:
+  
+  SystemPtr m_system;              //!< Pointer to the System object
+  MessengerPtr m_msg;              //!< Handles messages sent to output
+  double m_theta;                  //!< Opening angle 
+  int m_leaf_size;                 //!< Maximum number of particles in a leaf cell
+  vector<OctreeNode> m_nodes;      //!< All cells; root is the first one
+  vector<int> m_idx;               //!< Particle indices sorted such that each cell owns a contiguous range
+  vector<double> m_charge;         //!< Charge of each particle 
+  vector<int> m_stack;             //!< Stack of cells to visit during traversal
+  
+  //! Recursively subdivide cell
+  void split(int, int);
+  
+  //! Compute multipole moments of a cell from its particles or children
+  void compute_moments(int);
+  
+};
+
+typedef shared_ptr<Octree> OctreePtr;
+
+#endif
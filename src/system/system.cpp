@@ -65,6 +65,14 @@ System::System(const string& input_filename, MessengerPtr msg, BoxPtr box) : m_m
                                                                              m_box(box), 
                                                                              m_mesh(Mesh()),
                                                                              m_periodic(false),
+                                                                             m_time_step(0),
+                                                                             m_run_step(0),
+                                                                             m_topology_version(0),
+                                                                             m_force_step(-1),
+                                                                             m_force_topology(0),
+                                                                             m_compute_per_particle_eng(false),
+                                                                             m_compute_energy(true),
+                                                                             m_compute_stress(false),
                                                                              m_force_nlist_rebuild(false),
                                                                              m_nlist_rescale(1.0),
                                                                              m_current_particle_flag(0),
@@ -589,6 +597,7 @@ void System::add_particle(Particle& p)
   // We need to force neighbour list rebuild
   m_force_nlist_rebuild = true;
   m_current_particle_flag++;
+  m_topology_version++;
 }
 
 /*! Remove particle from the system
@@ -640,6 +649,7 @@ void System::remove_particle(int id)
     if (m_boundary[i] > id) m_boundary[i]--;
   
   m_force_nlist_rebuild = true;
+  m_topology_version++;
 }
 
 /*! Change group of the particle
@@ -674,6 +684,30 @@ void System::change_group(int id, const string& old_group, const string& new_gro
     m_group[new_group]->add_particle(p.get_id());
 }
 
+/*! Phase in values depend only on particle age, so they are computed once per time step for 
+ *  each phase in schedule and then shared by all pair interactions of a particle. Values are 
+ *  recomputed if the time step, step size or the number of particles changes.
+ *  \param val phase in schedule (Value object)
+ *  \param dt step size (used to convert particle age into number of steps)
+ *  \return pointer to the array of per particle phase in values
+ */
+double* System::get_phase_in(ValuePtr val, double dt)
+{
+  PhaseInCache& cache = m_phase_in[val.get()];
+  int N = this->size();
+  if (cache.val.size() != static_cast<unsigned int>(N) || cache.step != m_time_step || cache.dt != dt)
+  {
+    cache.val.resize(N);
+    for (int i = 0; i < N; i++)
+      cache.val[i] = val->get_val(static_cast<int>(m_particles[i].age/dt));
+    cache.step = m_time_step;
+    cache.dt = dt;
+  }
+  if (N == 0)
+    return 0;
+  return &cache.val[0];
+}
+
 /*! Kill off any non-zero momentum and angular momentum that a group of particles might have pick up
  * if the 3d-Newton's law breaking m_limit was enabled.
  * \param group Group name
@@ -796,6 +830,7 @@ void System::read_bonds(const string& bond_file)
   m_msg->msg(Messenger::INFO,"Read data for "+lexical_cast<string>(m_bonds.size())+" bonds.");
   m_msg->write_config("system.n_bonds",lexical_cast<string>(m_bonds.size()));
   inp.close();
+  m_topology_version++;
   
   m_n_bond_types = types.size();
   
@@ -903,6 +938,7 @@ void System::read_angles(const string& angle_file)
   m_msg->msg(Messenger::INFO,"Read data for "+lexical_cast<string>(m_angles.size())+" angles.");
   m_msg->write_config("system.n_angles",lexical_cast<string>(m_angles.size()));
   inp.close();
+  m_topology_version++;
   m_has_exclusions = true;
   m_n_angle_types = types.size();
 }
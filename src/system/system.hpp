@@ -55,6 +55,7 @@
 #include "group.hpp"
 #include "defaults.hpp"
 #include "mesh.hpp"
+#include "value.hpp"
 
 #include "parse_parameters.hpp"
 
@@ -76,6 +77,14 @@ using boost::shared_ptr;
 using boost::make_shared;
 using namespace boost::algorithm;
 
+//! Per particle phase in values for one phase in schedule
+struct PhaseInCache
+{
+  int step;               //!< Time step at which values were computed
+  double dt;              //!< Step size used to convert particle age into number of steps
+  vector<double> val;     //!< Phase in value of each particle
+};
+
 /*! This class handles collection of all particles, i.e. the entire system.
  */
 
@@ -97,6 +106,9 @@ public:
   //! Get number of angles
   int num_angles() { return m_angles.size(); } //!< \return Number of angles in the system.
   
+  //! Get topology version
+  int get_topology_version() { return m_topology_version; } //!< \return Counter that changes every time particles, bonds or angles are added or removed
+  
   //! Get particle 
   //! \param i index of the particle to return 
   Particle& get_particle(int i) { return m_particles[i]; }  
@@ -141,12 +153,16 @@ public:
     {
       Particle& p = m_particles[i];
       p.fx = 0.0; p.fy = 0.0; p.fz = 0.0;
-      p.s_xx = 0.0; p.s_xy = 0.0; p.s_xz = 0.0;
-      p.s_yx = 0.0; p.s_yy = 0.0; p.s_yz = 0.0;
-      p.s_zx = 0.0; p.s_zy = 0.0; p.s_zz = 0.0;
     }
+    m_force_step = -1;
+    // Stress is only reset on steps when some dump or logger needs it
+    if (m_compute_stress)
+      this->reset_stress();
   }
   
+  //! Reset per particle stress (virial) tensors to zero
+  void reset_stress() { m_stress.assign(9*this->size(), 0.0); }
+  
   //! Reset all torques to zero
   void reset_torques()
   {
@@ -155,8 +171,19 @@ public:
       Particle& p = m_particles[i];
       p.tau_x = 0.0; p.tau_y = 0.0; p.tau_z = 0.0;
     }
+    m_force_step = -1;
   }
   
+  //! Mark forces and torques stored with particles as evaluated in the configuration at the beginning of the current step
+  void set_forces_valid() { m_force_step = m_time_step; m_force_topology = m_topology_version; }
+  
+  //! Returns true if forces and torques stored with particles were evaluated at the beginning of the current step 
+  //! (and no particles have been added or removed since), i.e. if they can be reused by another integrator
+  bool forces_valid() { return m_force_step == m_time_step && m_force_topology == m_topology_version; }
+  
+  //! Forces and torques stored with particles can no longer be reused (e.g. orientations have been changed)
+  void invalidate_forces() { m_force_step = -1; }
+  
   
   //! Set the periodic boundary conditions flag
   //! \param periodic value of the periodic boundary conditions flag
@@ -224,8 +251,98 @@ public:
   //! disable per particle energy tracking
   void disable_per_particle_eng() { m_compute_per_particle_eng = false; }
   
-  //! Compute per particle energy 
-  bool compute_per_particle_energy() { return m_compute_per_particle_eng; }
+  //! Compute per particle energy (only on steps when energies are computed at all)
+  bool compute_per_particle_energy() { return m_compute_per_particle_eng && m_compute_energy; }
+  
+  //! Request potential and alignment energies every freq time steps (used by loggers and dumps)
+  //! \param freq step frequency at which energies will be read
+  void request_energy(int freq) 
+  { 
+    if (freq > 0 && find(m_energy_freq.begin(), m_energy_freq.end(), freq) == m_energy_freq.end())
+      m_energy_freq.push_back(freq); 
+  }
+  
+  //! Check if any logger or dump needs energies at a given time step
+  //! \param step time step 
+  bool energy_requested(int step)
+  {
+    for (unsigned int i = 0; i < m_energy_freq.size(); i++)
+      if (step % m_energy_freq[i] == 0)
+        return true;
+    return false;
+  }
+  
+  //! Set the compute energy flag (if false, potentials and aligners compute only forces and torques)
+  //! \param flag new value of the compute energy flag
+  void set_compute_energy(bool flag) { m_compute_energy = flag; }
+  
+  //! Returns true if potentials and aligners need to compute energies in the current step
+  bool compute_energy() { return m_compute_energy; }
+  
+  //! Request per particle stress every freq time steps (used by loggers and dumps)
+  //! \param freq step frequency at which stress will be read
+  void request_stress(int freq) 
+  { 
+    if (freq > 0 && find(m_stress_freq.begin(), m_stress_freq.end(), freq) == m_stress_freq.end())
+      m_stress_freq.push_back(freq); 
+  }
+  
+  //! Check if any logger or dump needs stress at a given time step
+  //! \param step time step 
+  bool stress_requested(int step)
+  {
+    for (unsigned int i = 0; i < m_stress_freq.size(); i++)
+      if (step % m_stress_freq[i] == 0)
+        return true;
+    return false;
+  }
+  
+  //! Set the compute stress flag (if true, potentials accumulate per particle virial stress)
+  //! \param flag new value of the compute stress flag
+  void set_compute_stress(bool flag) 
+  { 
+    m_compute_stress = flag; 
+    if (flag)
+      this->reset_stress();
+  }
+  
+  //! Returns true if potentials need to accumulate stress in the current step
+  bool compute_stress() { return m_compute_stress; }
+  
+  //! Returns true if stress tensor of particle i has been computed 
+  //! \param i particle index
+  bool has_stress(int i) { return 9*i + 8 < static_cast<int>(m_stress.size()); }
+  
+  //! Get stress tensor of particle i (nine components stored row by row, i.e. xx, xy, xz, yx, ...)
+  //! \param i particle index
+  double* get_stress(int i) { return &m_stress[9*i]; }
+  
+  //! Add contribution of a pair interaction to the stress of both particles
+  //! Each particle receives half of the pair virial \f$ \frac{1}{2} r_{ij}^\alpha f_{ij}^\beta \f$
+  //! \param i index of the first particle
+  //! \param j index of the second particle
+  //! \param dx x component of the distance vector r_i - r_j
+  //! \param dy y component of the distance vector r_i - r_j
+  //! \param dz z component of the distance vector r_i - r_j
+  //! \param fx x component of the force on particle i due to particle j
+  //! \param fy y component of the force on particle i due to particle j
+  //! \param fz z component of the force on particle i due to particle j
+  void add_pair_stress(int i, int j, double dx, double dy, double dz, double fx, double fy, double fz)
+  {
+    double w[9] = { 0.5*dx*fx, 0.5*dx*fy, 0.5*dx*fz, 
+                    0.5*dy*fx, 0.5*dy*fy, 0.5*dy*fz,
+                    0.5*dz*fx, 0.5*dz*fy, 0.5*dz*fz };
+    double* si = &m_stress[9*i];
+    double* sj = &m_stress[9*j];
+    for (int k = 0; k < 9; k++)
+    {
+      si[k] += w[k];
+      sj[k] += w[k];
+    }
+  }
+  
+  //! Get per particle phase in values for a given phase in schedule
+  double* get_phase_in(ValuePtr, double);
   
   //! Zero centre of mass momentum
   void zero_cm_momentum(const string&);
@@ -338,7 +455,16 @@ private:
   bool m_periodic;                      //!< If true, we use periodic boundary conditions 
   int m_time_step;                      //!< Current time step
   int m_run_step;                       //!< Time step for the current run
+  int m_topology_version;               //!< Incremented every time particles, bonds or angles are added or removed (used to update cached bonded data) 
+  int m_force_step;                     //!< Time step at which current forces and torques were evaluated (-1 if they cannot be reused)
+  int m_force_topology;                 //!< Topology version at which current forces and torques were evaluated
   bool m_compute_per_particle_eng;      //!< If true, compute per particle potential and alignment energy (we need to be able to turn it on and off since it is slow - STL map in the inner loop!)
+  bool m_compute_energy;                //!< If false, skip computing energies in the current step (forces and torques only)
+  vector<int> m_energy_freq;            //!< Step frequencies at which loggers and dumps read energies
+  bool m_compute_stress;                //!< If true, potentials accumulate per particle stress in the current step
+  vector<int> m_stress_freq;            //!< Step frequencies at which loggers and dumps read stress
+  vector<double> m_stress;              //!< Per particle stress (virial) tensors, nine components per particle
+  map<Value*, PhaseInCache> m_phase_in; //!< Per particle phase in values for each phase in schedule (refreshed once per step)
   int m_num_groups;                     //!< Total number of groups in the system
   bool m_force_nlist_rebuild;           //!< Forced rebuilding of neighbour list
   double m_nlist_rescale;               //!< Rescale neighbour list cutoff by this much
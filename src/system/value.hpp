@@ -32,6 +32,10 @@
 
 #include <string>
 #include <exception>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
 
 #include <boost/make_shared.hpp>
 #include <boost/lexical_cast.hpp>
@@ -41,6 +45,7 @@
 
 using std::string;
 using std::runtime_error;
+using std::vector;
 
 using boost::make_shared;
 using boost::lexical_cast;
@@ -181,5 +186,119 @@ private:
 
 typedef shared_ptr<ValueLinear> ValueLinearPtr;
 
+//! ValueSmoothstep class
+/*! ValueSmoothstep interpolates between min_val and max_val using the smoothstep 
+ *  function \f$ s^2\left(3-2s\right) \f$, where \f$ s \f$ is the fraction of the steps 
+ *  elapsed. Unlike linear interpolation, its derivative vanishes at both ends. 
+ *  If step is larger than the number of steps, max_val will be returned.
+*/
+class ValueSmoothstep : public Value
+{
+public:
+  
+  //! Construct ValueSmoothstep object
+  //! \param param list of parameters that are passed to the appropriate instance
+  ValueSmoothstep(MessengerPtr msg, pairs_type& param) : Value(msg, param)  
+  { 
+    m_msg->msg(Messenger::INFO,"Using smoothstep interpolation value object.");
+    if (m_steps <= 0)
+    {
+      m_msg->msg(Messenger::ERROR,"Value object. Number of steps has to be positive non-zero integer.");
+      throw runtime_error("Value parameters. Zero steps given.");
+    }
+    m_msg->write_config("value.smoothstep.min_val",lexical_cast<string>(m_min_val));
+    m_msg->write_config("value.smoothstep.max_val",lexical_cast<string>(m_max_val));
+    m_msg->write_config("value.smoothstep.steps",lexical_cast<string>(m_steps));
+  }
+        
+  //! Return current value
+  double get_val(int step) 
+  { 
+    if (step >= m_steps)
+      return m_max_val;
+    if (step <= 0)
+      return m_min_val;
+    double s = static_cast<double>(step)/static_cast<double>(m_steps);
+    return m_min_val + (m_max_val - m_min_val)*s*s*(3.0 - 2.0*s); 
+  };
+  
+};
+
+typedef shared_ptr<ValueSmoothstep> ValueSmoothstepPtr;
+
+//! ValueTabulated class
+/*! ValueTabulated reads pairs (step, value) from a file (parameter table) and 
+ *  linearly interpolates between them. Steps have to be given in increasing order.
+ *  Before the first tabulated step the first value is returned and after the last 
+ *  tabulated step the last value is returned. Parameters min_val, max_val and 
+ *  steps are ignored.
+*/
+class ValueTabulated : public Value
+{
+public:
+  
+  //! Construct ValueTabulated object
+  //! \param param list of parameters that are passed to the appropriate instance
+  ValueTabulated(MessengerPtr msg, pairs_type& param) : Value(msg, param)  
+  { 
+    m_msg->msg(Messenger::INFO,"Using tabulated value object.");
+    if (param.find("table") == param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"Value object. Tabulated value requires a file with steps and values (parameter table).");
+      throw runtime_error("Value parameters. No table file given.");
+    }
+    std::ifstream inp(param["table"].c_str());
+    if (!inp)
+    {
+      m_msg->msg(Messenger::ERROR,"Value object. Could not open table file "+param["table"]+".");
+      throw runtime_error("Value parameters. Could not open table file.");
+    }
+    string line;
+    while (std::getline(inp, line))
+    {
+      std::istringstream iss(line);
+      int step;
+      double val;
+      if (line.empty() || line[0] == '#' || !(iss >> step >> val))
+        continue;
+      if (m_step.size() > 0 && step <= m_step.back())
+      {
+        m_msg->msg(Messenger::ERROR,"Value object. Steps in table file "+param["table"]+" have to be strictly increasing.");
+        throw runtime_error("Value parameters. Table steps not increasing.");
+      }
+      m_step.push_back(step);
+      m_val.push_back(val);
+    }
+    inp.close();
+    if (m_step.size() == 0)
+    {
+      m_msg->msg(Messenger::ERROR,"Value object. Table file "+param["table"]+" contains no data.");
+      throw runtime_error("Value parameters. Empty table file.");
+    }
+    m_msg->msg(Messenger::INFO,"Value object. Read "+lexical_cast<string>(m_step.size())+" entries from table file "+param["table"]+".");
+    m_msg->write_config("value.tabulated.table",param["table"]);
+  }
+        
+  //! Return current value
+  double get_val(int step) 
+  { 
+    if (step <= m_step.front())
+      return m_val.front();
+    if (step >= m_step.back())
+      return m_val.back();
+    int k = std::upper_bound(m_step.begin(), m_step.end(), step) - m_step.begin();
+    double s = static_cast<double>(step - m_step[k-1])/static_cast<double>(m_step[k] - m_step[k-1]);
+    return m_val[k-1] + s*(m_val[k] - m_val[k-1]);
+  };
+  
+private:
+  
+  vector<int> m_step;       //!< Tabulated steps
+  vector<double> m_val;     //!< Tabulated values 
+  
+};
+
+typedef shared_ptr<ValueTabulated> ValueTabulatedPtr;
+
 
 #endif
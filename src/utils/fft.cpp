@@ -0,0 +1,106 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file fft.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of FFT3D class
+ */ 
+
+#include "fft.hpp"
+
+//! Set up grid and pre-compute roots of unity
+//! \param nx number of grid points in x direction
+//! \param ny number of grid points in y direction
+//! \param nz number of grid points in z direction
+FFT3D::FFT3D(int nx, int ny, int nz)
+{
+  m_n[0] = nx;  m_n[1] = ny;  m_n[2] = nz;
+  int nmax = 1;
+  for (int d = 0; d < 3; d++)
+  {
+    m_twiddle[d].resize(m_n[d]/2 + 1);
+    for (int k = 0; k <= m_n[d]/2; k++)
+      m_twiddle[d][k] = Complex(cos(2.0*M_PI*k/m_n[d]), sin(2.0*M_PI*k/m_n[d]));
+    if (m_n[d] > nmax) nmax = m_n[d];
+  }
+  m_line.resize(nmax);
+}
+
+//! Transform the whole grid, one direction at a time
+//! \param data grid data (transformed in place)
+//! \param sign sign of the exponent in the transform kernel
+void FFT3D::transform(vector<Complex>& data, int sign)
+{
+  int stride[3] = { m_n[1]*m_n[2], m_n[2], 1 };
+  for (int d = 0; d < 3; d++)
+  {
+    int n = m_n[d];
+    if (n == 1) continue;
+    // Loop over all lines parallel to direction d 
+    int d1 = (d + 1) % 3, d2 = (d + 2) % 3;
+    for (int a = 0; a < m_n[d1]; a++)
+      for (int b = 0; b < m_n[d2]; b++)
+      {
+        int offset = a*stride[d1] + b*stride[d2];
+        for (int k = 0; k < n; k++)
+          m_line[k] = data[offset + k*stride[d]];
+        this->transform_line(d, sign);
+        for (int k = 0; k < n; k++)
+          data[offset + k*stride[d]] = m_line[k];
+      }
+  }
+}
+
+//! Iterative Cooley-Tukey transform of the line buffer
+//! \param d direction (determines length and roots of unity)
+//! \param sign sign of the exponent in the transform kernel
+void FFT3D::transform_line(int d, int sign)
+{
+  int n = m_n[d];
+  vector<Complex>& w = m_twiddle[d];
+  // Bit reversal permutation
+  for (int i = 1, j = 0; i < n; i++)
+  {
+    int bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+      std::swap(m_line[i], m_line[j]);
+  }
+  // Butterflies
+  for (int len = 2; len <= n; len <<= 1)
+  {
+    int step = n/len;
+    for (int i = 0; i < n; i += len)
+      for (int k = 0; k < len/2; k++)
+      {
+        Complex wk = (sign > 0) ? w[k*step] : conj(w[k*step]);
+        Complex u = m_line[i + k];
+        Complex v = m_line[i + k + len/2]*wk;
+        m_line[i + k] = u + v;
+        m_line[i + k + len/2] = u - v;
+      }
+  }
+}
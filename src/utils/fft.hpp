@@ -0,0 +1,83 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file fft.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of FFT3D class
+ */ 
+
+#ifndef __FFT_H__
+#define __FFT_H__
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+using boost::shared_ptr;
+using std::complex;
+using std::vector;
+
+typedef complex<double> Complex;
+
+/*! FFT3D is a minimal in-place radix-2 complex fast Fourier transform on a three dimensional
+ *  grid with n_x x n_y x n_z points. Grid dimensions have to be powers of 2. Data is stored 
+ *  in row-major order, i.e. point (i,j,k) is at position (i*n_y + j)*n_z + k.
+ *  Backward transform is not normalised, i.e. backward(forward(f)) = n_x*n_y*n_z*f.
+ */
+class FFT3D
+{
+public:
+  
+  //! Constructor
+  FFT3D(int, int, int);
+  
+  //! Forward transform (kernel exp(-2 pi i k x / n))
+  void forward(vector<Complex>& data) { this->transform(data, -1); }
+  
+  //! Backward transform (kernel exp(2 pi i k x / n))
+  void backward(vector<Complex>& data) { this->transform(data, 1); }
+  
+  //! Returns true if n is a power of 2
+  static bool is_power_of_two(int n) { return (n > 0) && ((n & (n - 1)) == 0); }
+  
+private:
+  
+  int m_n[3];                       //!< Number of grid points in each direction
+  vector<Complex> m_twiddle[3];     //!< Pre-computed roots of unity for each direction
+  vector<Complex> m_line;           //!< Buffer holding a single line of the grid
+  
+  //! Transform along all three directions 
+  void transform(vector<Complex>&, int);
+  
+  //! Transform a single line stored in m_line
+  void transform_line(int, int);
+  
+};
+
+typedef shared_ptr<FFT3D> FFT3DPtr;
+
+#endif
@@ -59,4 +59,6 @@ void register_constraints(ConstraintMap& constraints)
   constraints["tetrahedron"] = boost::factory<ConstraintTetrahedronPtr>();
   // Register constraint to move in a slab between to planes parallel to xy plane with the constraint class factory
   constraints["slab"] = boost::factory<ConstraintSlabPtr>();
+  // Register constraint on a triangulated surface read from a file with the constraint class factory
+  constraints["mesh"] = boost::factory<ConstraintMeshPtr>();
 }
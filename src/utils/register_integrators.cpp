@@ -45,12 +45,18 @@ void register_integrators(IntegratorMap& integrators)
   integrators["brownian_rod"] = boost::factory<IntegratorBrownianRodPtr>();
   // Register Brownian dynamics integrator for particle position with the integrators class factory
   integrators["brownian_pos"] = boost::factory<IntegratorBrownianPosPtr>();
+  // Register semi-implicit Brownian dynamics integrator for particle position with the integrators class factory
+  integrators["brownian_implicit"] = boost::factory<IntegratorBrownianImplicitPtr>();
   // Register Brownian dynamics integrator for alignment with the integrators class factory
   integrators["brownian_align"] = boost::factory<IntegratorBrownianAlignPtr>();
   // Register Langevin dynamics integrator for particle positions with the integrators class factory
   integrators["langevin"] = boost::factory<IntegratorLangevinPtr>();
   // Register FIRE minimisaton integrator with the integrators class factory
   integrators["fire"] = boost::factory<IntegratorFIREPtr>();
+  // Register L-BFGS minimisaton integrator with the integrators class factory
+  integrators["lbfgs"] = boost::factory<IntegratorLBFGSPtr>();
+  // Register conjugate gradient minimisaton integrator with the integrators class factory
+  integrators["cg"] = boost::factory<IntegratorCGPtr>();
   // Register Sepulveda minimisaton integrator with the integrators class factory
   integrators["sepulveda"] = boost::factory<IntegratorSepulvedaPtr>();
 }
@@ -35,4 +35,8 @@ void register_values(ValueMap& values)
   values["constant"] = boost::factory<ValueConstantPtr>();
   // Register linear value control the class factory
   values["linear"] = boost::factory<ValueLinearPtr>();
+  // Register smoothstep value control the class factory
+  values["smoothstep"] = boost::factory<ValueSmoothstepPtr>();
+  // Register tabulated value control the class factory
+  values["tabulated"] = boost::factory<ValueTabulatedPtr>();
 }
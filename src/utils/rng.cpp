@@ -31,7 +31,8 @@
 
 //! Initialize RNG (GSL)
 //! \param seed initial seed for the random number generator
-RNG::RNG(int seed) : m_seed(seed)
+//! \param counter_based if true, per particle streams are counter based 
+RNG::RNG(int seed, bool counter_based) : m_seed(seed), m_counter_based(counter_based)
 {
   gsl_rng_env_setup();
   GSL_RANDOM_TYPE = gsl_rng_default;
@@ -60,6 +61,55 @@ double RNG::gauss_rng(double sigma)
   return gsl_ran_gaussian(GSL_RANDOM_GENERATOR, sigma);
 }
 
+/*! Fills an array with Gaussian distributed random numbers with zero mean and unit 
+ *  standard deviation. Uniform numbers are drawn in a single batch and then transformed 
+ *  using the Box-Muller transform in a loop that can be vectorised by the compiler. 
+ *  This is much faster than calling gauss_rng for each number separately.
+ *  \param x array to fill (has to hold at least n numbers)
+ *  \param n number of random numbers
+ */
+void RNG::fill_gaussian(double* x, int n)
+{
+  if (n <= 0) return;
+  int m = (n + 1)/2;
+  m_uniform.resize(2*m);
+  for (int i = 0; i < 2*m; i++)
+    m_uniform[i] = gsl_rng_uniform_pos(GSL_RANDOM_GENERATOR);
+  box_muller(&m_uniform[0], x, n);
+}
+
+/*! Fills a vector with Gaussian distributed random numbers with zero mean and unit 
+ *  standard deviation for each particle in a set. Numbers for particle i are stored in 
+ *  x[n*i], ..., x[n*i+n-1]. In the counter based mode, they are taken from the 
+ *  particle's stream (particles are processed in parallel), otherwise all numbers 
+ *  are generated in a single batch.
+ *  \param x vector to fill (resized to n*flags.size())
+ *  \param n number of random numbers per particle
+ *  \param flags unique flags of particles
+ *  \param step time step
+ *  \param sub stream type
+ *  \param draw index of the draw within the step (only used in the counter based mode)
+ */
+void RNG::fill_gaussian(vector<double>& x, int n, const vector<int>& flags, int step, stream_type sub, int draw)
+{
+  int N = flags.size();
+  x.resize(n*N);
+  if (N == 0)
+    return;
+  if (!m_counter_based)
+  {
+    this->fill_gaussian(&x[0], n*N);
+    return;
+  }
+#pragma omp parallel for if (N > RNG_PARALLEL_MIN)
+  for (int i = 0; i < N; i++)
+  {
+    RNGStream rng = this->stream(flags[i], step, sub, draw);
+    for (int k = 0; k < n; k++)
+      x[n*i+k] = rng.gauss_rng(1.0);
+  }
+}
+
 //! Get an integer random number between 0 and N drawn from an uniform distribution
 //! \param N upper bound for the interval
 //! \return integer random number between 0 and N
@@ -68,5 +118,27 @@ int RNG::lrnd(int N)
   return static_cast<int>(N*drnd());
 }
 
+// Private methods
 
-
+/*! Box-Muller transform of uniform random numbers in (0,1]. Array u holds 2m numbers, 
+ *  with m = (n+1)/2. Numbers u[i] and u[m+i] produce the Gaussian pair x[i] and x[m+i].
+ *  Array layout avoids strided access, so loops can be vectorised.
+ *  \note Sine and cosine are evaluated in separate loops. Otherwise the compiler merges 
+ *  them into a call to sincos, which has no vector version.
+ *  \param u uniform random numbers 
+ *  \param x Gaussian random numbers (output)
+ *  \param n number of Gaussian numbers
+ */
+void RNG::box_muller(const double* u, double* x, int n)
+{
+  int h = n/2, m = (n + 1)/2;
+  for (int i = 0; i < h; i++)
+  {
+    x[i] = sqrt(-2.0*log(u[i]));
+    x[m+i] = x[i]*sin(2.0*M_PI*u[m+i]);
+  }
+  for (int i = 0; i < h; i++)
+    x[i] *= cos(2.0*M_PI*u[m+i]);
+  if (n % 2 == 1)
+    x[h] = sqrt(-2.0*log(u[h]))*cos(2.0*M_PI*u[m+h]);
+}
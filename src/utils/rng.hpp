@@ -30,20 +30,34 @@
 #ifndef __RNG_H__
 #define __RNG_H__
 
+#include <cmath>
+#include <vector>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
 
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
 
 using boost::shared_ptr;
+using boost::uint32_t;
+using boost::uint64_t;
+using std::vector;
+
+//! Do not spawn threads when generating random numbers for fewer particles than this
+const int RNG_PARALLEL_MIN = 1024;
+
+class RNGStream;
 
 /*! Class handles random numbers in the system */
 class RNG
 {
 public:
   
+  //! Independent streams of particle random numbers within the same step
+  enum stream_type { TRANSLATION, ROTATION, FLIP, DIVISION, DEATH, GROWTH, BRIDGE };
+  
   //! Constructor (initialize random number generator)
-  RNG(int);
+  RNG(int, bool counter_based = false);
   
   //! Destructor
   ~RNG();
@@ -56,15 +70,140 @@ public:
   
   //! Return a Gaussian distributed number with a given standard deviation
   double gauss_rng(double);
+  
+  //! Fill array with Gaussian distributed numbers with unit standard deviation
+  void fill_gaussian(double*, int);
+  
+  //! Fill vector with Gaussian distributed numbers for a set of particles
+  void fill_gaussian(vector<double>&, int, const vector<int>&, int, stream_type, int draw = 0);
+  
+  //! Return random numbers for a given particle in a given step
+  RNGStream stream(int, int, stream_type, int draw = 0);
+  
+  //! \return true if particle streams are counter based 
+  bool counter_based() { return m_counter_based; }
 
 private:
   
   int m_seed;   //!< Random number generator seed
+  bool m_counter_based;   //!< If true, particle streams are generated from the counter (otherwise they are drawn from the GSL generator)
   const gsl_rng_type* GSL_RANDOM_TYPE;  //!< Pointer to the gsl_rng_type structure which handles the RNG type
   gsl_rng* GSL_RANDOM_GENERATOR;        //!< Pointer which holds the actual random number generator
+  vector<double> m_uniform;             //!< Uniform random numbers used in batched generation of Gaussian numbers
+  
+  //! Transform uniform into Gaussian random numbers 
+  static void box_muller(const double*, double*, int);
 
 };
 
 typedef shared_ptr<RNG> RNGPtr;
 
+/*! Class RNGStream provides random numbers for a single particle in a single step.
+ *  In the counter based mode, the n-th number is obtained by encrypting the counter 
+ *  (n, sub-stream, step, draw) with the key (seed, particle flag) using the Philox4x32-10 
+ *  generator (J. K. Salmon, et al., Proc. SC'11 (2011)). Numbers are therefore independent 
+ *  of the order in which particles are processed and can be produced by any thread.
+ *  Otherwise, numbers are drawn sequentially from the GSL generator, which reproduces 
+ *  streams of earlier versions exactly.
+ */
+class RNGStream
+{
+public:
+  
+  //! Constructor
+  //! \param rng parent random number generator
+  //! \param seed random number generator seed
+  //! \param flag unique particle flag
+  //! \param step time step
+  //! \param sub sub-stream (distinguishes independent uses within the same step)
+  //! \param draw index of the draw (distinguishes repeated uses of the same sub-stream within the same step)
+  RNGStream(RNG* rng, int seed, int flag, int step, int sub, int draw) : m_rng(rng), m_used(4), m_has_gauss(false), m_gauss(0.0)
+  {
+    m_key[0] = static_cast<uint32_t>(seed);
+    m_key[1] = static_cast<uint32_t>(flag);
+    m_ctr[0] = 0;
+    m_ctr[1] = static_cast<uint32_t>(sub);
+    m_ctr[2] = static_cast<uint32_t>(step);
+    m_ctr[3] = static_cast<uint32_t>(draw);
+  }
+  
+  //! Return random number between 0 and 1
+  double drnd()
+  {
+    if (!m_rng->counter_based())
+      return m_rng->drnd();
+    if (m_used > 2)
+      this->next_block();
+    // 53 random bits from two 32 bit words
+    double u = ((m_out[m_used] >> 5)*67108864.0 + (m_out[m_used+1] >> 6))*(1.0/9007199254740992.0);
+    m_used += 2;
+    return u;
+  }
+  
+  //! Return a Gaussian distributed number with a given standard deviation
+  //! \param sigma standard deviation
+  double gauss_rng(double sigma)
+  {
+    if (!m_rng->counter_based())
+      return m_rng->gauss_rng(sigma);
+    // Box-Muller transform. Second number is kept for the next call.
+    if (m_has_gauss)
+    {
+      m_has_gauss = false;
+      return sigma*m_gauss;
+    }
+    double u1 = 1.0 - this->drnd();
+    double u2 = this->drnd();
+    double r = std::sqrt(-2.0*std::log(u1));
+    m_gauss = r*std::sin(2.0*M_PI*u2);
+    m_has_gauss = true;
+    return sigma*r*std::cos(2.0*M_PI*u2);
+  }
+  
+private:
+  
+  RNG* m_rng;            //!< Parent random number generator
+  uint32_t m_key[2];     //!< Philox key (seed and particle flag)
+  uint32_t m_ctr[4];     //!< Philox counter (block index, sub-stream, step, draw)
+  uint32_t m_out[4];     //!< Current block of random bits
+  int m_used;            //!< Number of words of the current block already used
+  bool m_has_gauss;      //!< If true, there is a stored Gaussian number
+  double m_gauss;        //!< Stored Gaussian number
+  
+  //! Generate next block of random bits (Philox4x32 with 10 rounds)
+  void next_block()
+  {
+    uint32_t c[4] = { m_ctr[0], m_ctr[1], m_ctr[2], m_ctr[3] };
+    uint32_t k[2] = { m_key[0], m_key[1] };
+    for (int r = 0; r < 10; r++)
+    {
+      uint64_t p0 = static_cast<uint64_t>(0xD2511F53u)*c[0];
+      uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u)*c[2];
+      uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+      uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+      c[0] = hi1 ^ c[1] ^ k[0];
+      c[1] = lo1;
+      c[2] = hi0 ^ c[3] ^ k[1];
+      c[3] = lo0;
+      k[0] += 0x9E3779B9u;
+      k[1] += 0xBB67AE85u;
+    }
+    m_out[0] = c[0];  m_out[1] = c[1];  m_out[2] = c[2];  m_out[3] = c[3];
+    m_ctr[0]++;
+    m_used = 0;
+  }
+  
+};
+
+/*! \param flag unique particle flag
+ *  \param step time step
+ *  \param sub stream type (distinguishes independent uses within the same step)
+ *  \param draw index of the draw (e.g., substep of an adaptive integrator)
+ *  \return random number stream for the particle
+ */
+inline RNGStream RNG::stream(int flag, int step, stream_type sub, int draw)
+{
+  return RNGStream(this, m_seed, flag, step, static_cast<int>(sub), draw);
+}
+
 #endif